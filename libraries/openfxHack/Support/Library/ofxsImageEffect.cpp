@@ -686,6 +686,13 @@ void ImageEffectDescriptor::setTemporalClipAccess(bool v)
     _effectProps.propSetInt(kOfxImageEffectPropTemporalClipAccess, int(v));
 }
 
+/** @brief Does each output pixel only depend on the source pixel at the same position */
+void ImageEffectDescriptor::setPointWise(bool v)
+{
+    // This property is an extension, so it's optional.
+    _effectProps.propSetInt(kTuttleOfxImageEffectPropPointWise, int(v), false);
+}
+
 /** @brief Does the plugin want to have render called twice per frame in all circumanstances for fielded images ? */
 void ImageEffectDescriptor::setRenderTwiceAlways(bool v)
 {
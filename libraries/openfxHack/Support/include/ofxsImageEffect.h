@@ -462,6 +462,9 @@ public:
     /** @brief Does the plugin perform temporal clip access, defaults to false */
     void setTemporalClipAccess( bool v );
 
+    /** @brief Does each output pixel only depend on the source pixel at the same position, defaults to false */
+    void setPointWise( bool v );
+
     /** @brief Does the plugin want to have render called twice per frame in all circumanstances for fielded images ? defaults to true */
     void setRenderTwiceAlways( bool v );
 
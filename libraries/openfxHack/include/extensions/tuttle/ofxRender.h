@@ -0,0 +1,24 @@
+#ifndef _ofxRender_h_
+#define _ofxRender_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Int value used to know if each output pixel only depends on the input pixel at the same position.
+ *
+ * - Type - int X 1
+ * - Property Set - plugin descriptor (read/write)
+ * - Default - 0 for a plugin
+ * - Valid Values - This must be one of 0 or 1
+ *
+ * A point-wise plugin reads each source pixel before writing the same output pixel and nothing else,
+ * so the host may render it in the buffer of its source clip (e.g. color corrections).
+ */
+#define kTuttleOfxImageEffectPropPointWise "TuttleOfxImageEffectPropPointWise"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
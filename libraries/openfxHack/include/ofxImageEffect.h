@@ -40,6 +40,7 @@
 #include "ofxMultiThread.h"
 #include "ofxInteract.h"
 #include "extensions/tuttle/ofxReadWrite.h"
+#include "extensions/tuttle/ofxRender.h"
 
 #ifdef __cplusplus
 extern "C" {
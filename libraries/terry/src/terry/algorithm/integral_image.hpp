@@ -0,0 +1,233 @@
+#ifndef _TERRY_ALGORITHM_INTEGRAL_IMAGE_HPP_
+#define _TERRY_ALGORITHM_INTEGRAL_IMAGE_HPP_
+
+#include <terry/algorithm/reduce_pixels.hpp>
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/image_view.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace terry
+{
+namespace algorithm
+{
+
+/// \defgroup ImageViewAlgorithmsIntegralImage integral_image
+/// \brief Summed-area tables (integral images) of image views
+///
+/// The sums of the channels (and optionally of their squares) are stored in double
+/// precision with an extra null first row and column, so the sum of any rectangle
+/// only needs 4 values, whatever its size.
+/// The table is computed in two passes: the prefix sums of the rows by blocks of
+/// rows, then the prefix sums of the columns by blocks of columns. Each value is
+/// computed by the same operations in any block, so the result doesn't depend on
+/// the executor (see reduce_pixels for the executors).
+
+/// \ingroup ImageViewAlgorithmsIntegralImage
+/// \brief Default number of rows (first pass) or columns (second pass) of a block
+static const std::ptrdiff_t integral_image_block_size = 64;
+
+namespace detail
+{
+
+/// prefix sums of the rows of a view, in a table with a null first column
+template <typename View, int NbChannels>
+struct integral_rows_task
+{
+    const View& _view;
+    double* _sums;
+    double* _squares; ///< NULL without the squares
+    const std::ptrdiff_t _stride;
+    const std::ptrdiff_t _blockSize;
+
+    integral_rows_task(const View& view, double* sums, double* squares, const std::ptrdiff_t stride,
+                       const std::ptrdiff_t blockSize)
+        : _view(view)
+        , _sums(sums)
+        , _squares(squares)
+        , _stride(stride)
+        , _blockSize(blockSize)
+    {
+    }
+
+    void operator()(const std::size_t block)
+    {
+        const std::ptrdiff_t yEnd = std::min<std::ptrdiff_t>((block + 1) * _blockSize, _view.height());
+        for(std::ptrdiff_t y = block * _blockSize; y < yEnd; ++y)
+        {
+            typename View::x_iterator it = _view.row_begin(y);
+            double* sums = _sums + (y + 1) * _stride;
+            double* squares = _squares ? _squares + (y + 1) * _stride : NULL;
+            for(int c = 0; c < NbChannels; ++c)
+            {
+                sums[c] = 0.0;
+                if(squares)
+                    squares[c] = 0.0;
+            }
+            for(std::ptrdiff_t x = 0; x < _view.width(); ++x)
+            {
+                for(int c = 0; c < NbChannels; ++c)
+                {
+                    const double v = it[x][c];
+                    sums[NbChannels + c] = sums[c] + v;
+                    if(squares)
+                        squares[NbChannels + c] = squares[c] + v * v;
+                }
+                sums += NbChannels;
+                if(squares)
+                    squares += NbChannels;
+            }
+        }
+    }
+};
+
+/// prefix sums of the columns of a table
+template <int NbChannels>
+struct integral_columns_task
+{
+    double* _sums;
+    double* _squares; ///< NULL without the squares
+    const std::ptrdiff_t _stride;
+    const std::ptrdiff_t _width;
+    const std::ptrdiff_t _height;
+    const std::ptrdiff_t _blockSize;
+
+    integral_columns_task(double* sums, double* squares, const std::ptrdiff_t stride, const std::ptrdiff_t width,
+                          const std::ptrdiff_t height, const std::ptrdiff_t blockSize)
+        : _sums(sums)
+        , _squares(squares)
+        , _stride(stride)
+        , _width(width)
+        , _height(height)
+        , _blockSize(blockSize)
+    {
+    }
+
+    void accumulate(double* table, const std::ptrdiff_t begin, const std::ptrdiff_t end) const
+    {
+        for(std::ptrdiff_t y = 1; y <= _height; ++y)
+        {
+            const double* previous = table + (y - 1) * _stride;
+            double* current = table + y * _stride;
+            for(std::ptrdiff_t i = begin; i < end; ++i)
+                current[i] += previous[i];
+        }
+    }
+
+    void operator()(const std::size_t block)
+    {
+        // values of the columns of the block, the null first column is skipped
+        const std::ptrdiff_t begin = (block * _blockSize + 1) * NbChannels;
+        const std::ptrdiff_t end = (std::min<std::ptrdiff_t>((block + 1) * _blockSize, _width) + 1) * NbChannels;
+        accumulate(_sums, begin, end);
+        if(_squares)
+            accumulate(_squares, begin, end);
+    }
+};
+}
+
+/// \ingroup ImageViewAlgorithmsIntegralImage
+/// \brief Integral image of the first NbChannels channels of a view
+template <int NbChannels>
+class integral_image_t
+{
+public:
+    integral_image_t()
+        : _width(0)
+        , _height(0)
+        , _stride(0)
+        , _withSquares(false)
+    {
+    }
+
+    std::ptrdiff_t width() const { return _width; }
+    std::ptrdiff_t height() const { return _height; }
+    bool has_squares() const { return _withSquares; }
+
+    /// @brief Compute the integral image of @p view, and of its squares if @p withSquares.
+    /// The buffers are only reallocated if the view is bigger than the previous one.
+    template <typename View, typename Executor>
+    void compute(const View& view, const Executor& executor, const bool withSquares = false,
+                 const std::ptrdiff_t blockSize = integral_image_block_size)
+    {
+        assert(blockSize > 0);
+        _width = view.width();
+        _height = view.height();
+        _withSquares = withSquares;
+        _stride = (_width + 1) * NbChannels;
+        const std::size_t size = _stride * (_height + 1);
+        if(_sums.size() < size)
+            _sums.resize(size);
+        if(withSquares && _squares.size() < size)
+            _squares.resize(size);
+
+        // null first row
+        std::fill(_sums.begin(), _sums.begin() + _stride, 0.0);
+        if(withSquares)
+            std::fill(_squares.begin(), _squares.begin() + _stride, 0.0);
+
+        double* squares = withSquares ? &_squares[0] : NULL;
+        detail::integral_rows_task<View, NbChannels> rows(view, &_sums[0], squares, _stride, blockSize);
+        executor(rows, (_height + blockSize - 1) / blockSize);
+        detail::integral_columns_task<NbChannels> columns(&_sums[0], squares, _stride, _width, _height, blockSize);
+        executor(columns, (_width + blockSize - 1) / blockSize);
+    }
+
+    /// @brief Sum of the channel @p c on the rectangle [x1, x2) x [y1, y2)
+    double sum(const std::ptrdiff_t x1, const std::ptrdiff_t y1, const std::ptrdiff_t x2, const std::ptrdiff_t y2,
+               const int c = 0) const
+    {
+        return rectangle(_sums, x1, y1, x2, y2, c);
+    }
+
+    /// @brief Sum of the squares of the channel @p c on the rectangle [x1, x2) x [y1, y2)
+    double square_sum(const std::ptrdiff_t x1, const std::ptrdiff_t y1, const std::ptrdiff_t x2,
+                      const std::ptrdiff_t y2, const int c = 0) const
+    {
+        assert(_withSquares);
+        return rectangle(_squares, x1, y1, x2, y2, c);
+    }
+
+    double mean(const std::ptrdiff_t x1, const std::ptrdiff_t y1, const std::ptrdiff_t x2, const std::ptrdiff_t y2,
+                const int c = 0) const
+    {
+        return sum(x1, y1, x2, y2, c) / ((x2 - x1) * (y2 - y1));
+    }
+
+    /// @brief Population variance of the channel @p c on the rectangle [x1, x2) x [y1, y2)
+    double variance(const std::ptrdiff_t x1, const std::ptrdiff_t y1, const std::ptrdiff_t x2, const std::ptrdiff_t y2,
+                    const int c = 0) const
+    {
+        const double n = double((x2 - x1) * (y2 - y1));
+        const double m = sum(x1, y1, x2, y2, c) / n;
+        const double v = square_sum(x1, y1, x2, y2, c) / n - m * m;
+        return v < 0.0 ? 0.0 : v; // rounding errors
+    }
+
+private:
+    double rectangle(const std::vector<double>& table, const std::ptrdiff_t x1, const std::ptrdiff_t y1,
+                     const std::ptrdiff_t x2, const std::ptrdiff_t y2, const int c) const
+    {
+        assert(0 <= x1 && x1 <= x2 && x2 <= _width);
+        assert(0 <= y1 && y1 <= y2 && y2 <= _height);
+        const double* top = &table[y1 * _stride + c];
+        const double* bottom = &table[y2 * _stride + c];
+        return bottom[x2 * NbChannels] - bottom[x1 * NbChannels] - top[x2 * NbChannels] + top[x1 * NbChannels];
+    }
+
+private:
+    std::ptrdiff_t _width;
+    std::ptrdiff_t _height;
+    std::ptrdiff_t _stride; ///< number of values of a row of the table
+    bool _withSquares;
+    std::vector<double> _sums;
+    std::vector<double> _squares;
+};
+}
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef _TERRY_ALGORITHM_REDUCE_PIXELS_HPP_
+#define _TERRY_ALGORITHM_REDUCE_PIXELS_HPP_
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/image_view.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace terry
+{
+namespace algorithm
+{
+
+/// \defgroup ImageViewAlgorithmsReducePixels reduce_pixels
+/// \brief Parallel reduction of image views (statistics, min/max, histograms...)
+///
+/// The view is cut in blocks of rows, which only depend on the size of the view.
+/// Each block is reduced into its own copy of the initial reducer, then the partial
+/// results are merged in the order of the blocks. So the result doesn't depend
+/// on the number of threads or on the order of execution of the blocks.
+///
+/// A reducer models:
+/// - reducer( pixel ): accumulate a pixel (or reducer( pixel1, pixel2 ) with 2 views)
+/// - reducer.merge( other ): accumulate the pixels of the next block
+/// The initial reducer must be neutral for the merge (empty statistics, null histograms)
+/// or idempotent (the first pixel of a min/max).
+///
+/// An executor models executor( task, nbBlocks ), which calls task( i ) once for
+/// each block i in [0, nbBlocks), in any order and from any thread.
+
+/// \ingroup ImageViewAlgorithmsReducePixels
+/// \brief Executor running all the blocks in the calling thread
+struct serial_executor
+{
+    template <typename Task>
+    void operator()(Task& task, const std::size_t nbBlocks) const
+    {
+        for(std::size_t i = 0; i < nbBlocks; ++i)
+            task(i);
+    }
+};
+
+/// \ingroup ImageViewAlgorithmsReducePixels
+/// \brief Default number of rows of a block
+static const std::ptrdiff_t reduce_pixels_block_rows = 32;
+
+namespace detail
+{
+
+template <typename View, typename Reducer>
+struct reduce_rows_task
+{
+    const View& _view;
+    std::vector<Reducer>& _partials;
+    const std::ptrdiff_t _blockRows;
+
+    reduce_rows_task(const View& view, std::vector<Reducer>& partials, const std::ptrdiff_t blockRows)
+        : _view(view)
+        , _partials(partials)
+        , _blockRows(blockRows)
+    {
+    }
+
+    void operator()(const std::size_t block)
+    {
+        Reducer& reducer = _partials[block];
+        const std::ptrdiff_t yEnd = std::min<std::ptrdiff_t>((block + 1) * _blockRows, _view.height());
+        for(std::ptrdiff_t y = block * _blockRows; y < yEnd; ++y)
+        {
+            typename View::x_iterator it = _view.row_begin(y);
+            for(std::ptrdiff_t x = 0; x < _view.width(); ++x)
+                reducer(it[x]);
+        }
+    }
+};
+
+template <typename View1, typename View2, typename Reducer>
+struct reduce_rows2_task
+{
+    const View1& _view1;
+    const View2& _view2;
+    std::vector<Reducer>& _partials;
+    const std::ptrdiff_t _blockRows;
+
+    reduce_rows2_task(const View1& view1, const View2& view2, std::vector<Reducer>& partials,
+                      const std::ptrdiff_t blockRows)
+        : _view1(view1)
+        , _view2(view2)
+        , _partials(partials)
+        , _blockRows(blockRows)
+    {
+    }
+
+    void operator()(const std::size_t block)
+    {
+        Reducer& reducer = _partials[block];
+        const std::ptrdiff_t yEnd = std::min<std::ptrdiff_t>((block + 1) * _blockRows, _view1.height());
+        for(std::ptrdiff_t y = block * _blockRows; y < yEnd; ++y)
+        {
+            typename View1::x_iterator it1 = _view1.row_begin(y);
+            typename View2::x_iterator it2 = _view2.row_begin(y);
+            for(std::ptrdiff_t x = 0; x < _view1.width(); ++x)
+                reducer(it1[x], it2[x]);
+        }
+    }
+};
+
+template <typename Reducer>
+Reducer merge_partials(const std::vector<Reducer>& partials)
+{
+    Reducer result = partials.front();
+    for(std::size_t i = 1; i < partials.size(); ++i)
+        result.merge(partials[i]);
+    return result;
+}
+}
+
+/// \ingroup ImageViewAlgorithmsReducePixels
+/// \brief Reduce all the pixels of a view
+template <typename View, typename Reducer, typename Executor>
+Reducer reduce_pixels(const View& view, const Reducer& init, const Executor& executor,
+                      const std::ptrdiff_t blockRows = reduce_pixels_block_rows)
+{
+    assert(blockRows > 0);
+    const std::size_t nbBlocks = (view.height() + blockRows - 1) / blockRows;
+    if(nbBlocks == 0 || view.width() == 0)
+        return init;
+    std::vector<Reducer> partials(nbBlocks, init);
+    detail::reduce_rows_task<View, Reducer> task(view, partials, blockRows);
+    executor(task, nbBlocks);
+    return detail::merge_partials(partials);
+}
+
+/// \ingroup ImageViewAlgorithmsReducePixels
+/// \brief Reduce the pixels of 2 views of the same size, like a source and its mask
+/// (disabled for an integral executor, which is the block size of the one view version)
+template <typename View1, typename View2, typename Reducer, typename Executor>
+typename boost::disable_if<boost::is_integral<Executor>, Reducer>::type
+reduce_pixels(const View1& view1, const View2& view2, const Reducer& init, const Executor& executor,
+              const std::ptrdiff_t blockRows = reduce_pixels_block_rows)
+{
+    assert(blockRows > 0);
+    assert(view1.dimensions() == view2.dimensions());
+    const std::size_t nbBlocks = (view1.height() + blockRows - 1) / blockRows;
+    if(nbBlocks == 0 || view1.width() == 0)
+        return init;
+    std::vector<Reducer> partials(nbBlocks, init);
+    detail::reduce_rows2_task<View1, View2, Reducer> task(view1, view2, partials, blockRows);
+    executor(task, nbBlocks);
+    return detail::merge_partials(partials);
+}
+}
+}
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef _TERRY_FILTER_BOXBLUR_HPP_
+#define _TERRY_FILTER_BOXBLUR_HPP_
+
+#include "convolve.hpp"
+
+#include <terry/numeric/assign.hpp>
+
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace terry
+{
+namespace filter
+{
+
+static const std::size_t kBoxBlurNbPasses = 3; ///< 3 boxes are within a few percents of the gaussian
+
+/**
+ * @brief Radius of the successive box filters approximating a gaussian of @p variance.
+ *
+ * The variance of a box of width w is (w^2 - 1) / 12 and the variances of successive filters add up,
+ * so the widths are the two odd integers around the ideal width, distributed to match the variance.
+ * Box filters of radius 0 are removed.
+ */
+inline std::vector<std::size_t> boxRadiusForGaussian(const double variance,
+                                                     const std::size_t nbPasses = kBoxBlurNbPasses)
+{
+    std::vector<std::size_t> radius;
+    if(variance <= 0 || nbPasses == 0)
+        return radius;
+    const double n = static_cast<double>(nbPasses);
+    const double idealWidth = std::sqrt(12.0 * variance / n + 1.0);
+    int lowerWidth = static_cast<int>(std::floor(idealWidth));
+    if(lowerWidth % 2 == 0)
+        --lowerWidth;
+    // number of passes using the lower width
+    const double m = (12.0 * variance - n * lowerWidth * lowerWidth - 4.0 * n * lowerWidth - 3.0 * n) /
+                     (-4.0 * lowerWidth - 4.0);
+    const std::size_t nbLower = static_cast<std::size_t>(std::max(0.0, std::min(n, std::floor(m + 0.5))));
+    for(std::size_t i = 0; i < nbPasses; ++i)
+    {
+        const std::size_t width = (i < nbLower) ? lowerWidth : lowerWidth + 2;
+        if(width > 1)
+            radius.push_back((width - 1) / 2);
+    }
+    return radius;
+}
+
+namespace detail
+{
+
+/**
+ * @brief Mean of the 2 * @p radius + 1 pixels around each pixel, with running sums.
+ * @param size number of pixels of @p src, @p dst receives size - 2 * radius pixels
+ */
+template <typename PixelAccum>
+void box_filter_pixels(const PixelAccum* src, const std::size_t size, const std::size_t radius, PixelAccum* dst)
+{
+    typedef typename channel_type<PixelAccum>::type Channel;
+    static const int nbChannels = num_channels<PixelAccum>::value;
+
+    const std::size_t width = 2 * radius + 1;
+    const double norm = 1.0 / width;
+    // the sums are in double, so the running sums don't drift along the rows
+    double sum[nbChannels];
+    std::fill(sum, sum + nbChannels, 0.0);
+    for(std::size_t i = 0; i < width; ++i)
+        for(int c = 0; c < nbChannels; ++c)
+            sum[c] += src[i][c];
+    for(int c = 0; c < nbChannels; ++c)
+        dst[0][c] = Channel(sum[c] * norm);
+
+    for(std::size_t i = 1; i + 2 * radius < size; ++i)
+    {
+        for(int c = 0; c < nbChannels; ++c)
+        {
+            sum[c] += static_cast<double>(src[i + 2 * radius][c]) - static_cast<double>(src[i - 1][c]);
+            dst[i][c] = Channel(sum[c] * norm);
+        }
+    }
+}
+
+/// Correlator applying successive box filters on the row buffers, whatever their radius.
+template <typename PixelAccum>
+class correlator_box
+{
+private:
+    std::vector<std::size_t> _radius;
+    std::size_t _margin;
+    std::vector<PixelAccum> _buffers[2];
+
+public:
+    correlator_box(const std::vector<std::size_t>& radius)
+        : _radius(radius)
+        , _margin(std::accumulate(radius.begin(), radius.end(), std::size_t(0)))
+    {
+    }
+
+    template <typename KernelIterator, typename DstIterator>
+    void operator()(const PixelAccum* src_begin, const PixelAccum* src_end, KernelIterator, DstIterator dst_begin)
+    {
+        const std::size_t size = src_end - src_begin;
+        std::size_t bufferSize = size + 2 * _margin;
+        const PixelAccum* in = src_begin;
+        for(std::size_t i = 0; i < _radius.size(); ++i)
+        {
+            std::vector<PixelAccum>& out = _buffers[i % 2];
+            out.resize(bufferSize - 2 * _radius[i]);
+            box_filter_pixels(in, bufferSize, _radius[i], &out.front());
+            in = &out.front();
+            bufferSize = out.size();
+        }
+        terry::numeric::assign_pixels(in, in + size, dst_begin);
+    }
+};
+
+/// Kernel with the support of the successive box filters, only used for the boundaries of the row buffers.
+inline kernel_1d<float> box_support_kernel(const std::vector<std::size_t>& radius)
+{
+    const std::size_t margin = std::accumulate(radius.begin(), radius.end(), std::size_t(0));
+    kernel_1d<float> support(2 * margin + 1, margin);
+    support[margin] = 1; // without any box, it's a copy
+    return support;
+}
+}
+
+/**
+ * @brief Blur the rows with successive box filters.
+ * The cost per pixel only depends on the number of filters, not on their radius.
+ * @param radius radius of the successive box filters, see boxRadiusForGaussian()
+ */
+template <typename PixelAccum, typename SrcView, typename DstView>
+void box_blur_rows(const SrcView& src, const std::vector<std::size_t>& radius, const DstView& dst,
+                   const typename SrcView::point_t& dst_tl,
+                   const convolve_boundary_option option = convolve_option_extend_zero)
+{
+    detail::correlate_rows_imp<PixelAccum>(src, detail::box_support_kernel(radius), dst, dst_tl, option,
+                                           detail::correlator_box<PixelAccum>(radius));
+}
+
+/**
+ * @brief Blur the columns with successive box filters.
+ */
+template <typename PixelAccum, typename SrcView, typename DstView>
+void box_blur_cols(const SrcView& src, const std::vector<std::size_t>& radius, const DstView& dst,
+                   const typename SrcView::point_t& dst_tl,
+                   const convolve_boundary_option option = convolve_option_extend_zero)
+{
+    box_blur_rows<PixelAccum>(transposed_view(src), radius, transposed_view(dst),
+                              typename SrcView::point_t(dst_tl.y, dst_tl.x), option);
+}
+
+/**
+ * @brief Blur the rows then the columns with successive box filters.
+ * Like correlate_rows_cols_imp, a temporary buffer is used to process tiles.
+ */
+template <typename PixelAccum, template <typename> class Alloc, typename SrcView, typename DstView>
+void box_blur_rows_cols(const SrcView& src, const std::vector<std::size_t>& radiusX,
+                        const std::vector<std::size_t>& radiusY, const DstView& dst,
+                        const typename SrcView::point_t& dst_tl,
+                        const convolve_boundary_option option = convolve_option_extend_zero)
+{
+    typedef typename DstView::point_t Point;
+    typedef typename DstView::coord_t Coord;
+    typedef typename view_type_from_pixel<PixelAccum, is_planar<DstView>::value>::type ViewAccum;
+    typedef image<PixelAccum, is_planar<DstView>::value, Alloc<unsigned char> > ImageAccum;
+
+    if(dst.dimensions() == src.dimensions())
+    {
+        const typename SrcView::point_t zero(0, 0);
+        box_blur_rows<PixelAccum>(src, radiusX, dst, zero, option);
+        box_blur_cols<PixelAccum>(dst, radiusY, dst, zero, option);
+        return;
+    }
+
+    const Coord marginY = std::accumulate(radiusY.begin(), radiusY.end(), std::size_t(0));
+    const Coord top_in = std::min(marginY, dst_tl.y);
+    const Coord bottom_in = std::min(marginY, src.height() - (dst_tl.y + dst.height()));
+    Point image_tmp_size(dst.dimensions());
+    image_tmp_size.y += top_in + bottom_in;
+    Point image_tmp_tl(dst_tl);
+    image_tmp_tl.y -= top_in;
+
+    ImageAccum image_tmp(image_tmp_size);
+    ViewAccum view_tmp = view(image_tmp);
+
+    box_blur_rows<PixelAccum>(src, radiusX, view_tmp, image_tmp_tl, option);
+    box_blur_cols<PixelAccum>(view_tmp, radiusY, dst, Point(0, top_in), option);
+}
+}
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "correlate.hpp"
 #include "detail/kernel.hpp"
+#include "detail/correlate_simd.hpp"
 
 #include <terry/numeric/scalar.hpp>
 #include <terry/numeric/init.hpp>
@@ -14,6 +15,8 @@
 #include <boost/gil/metafunctions.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/mpl/bool.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <cstddef>
 #include <cassert>
@@ -290,6 +293,79 @@ public:
     }
 };
 
+/// Interleaved pixels of float channels, the row buffers of these accumulators are correlated with vector instructions.
+template <typename PixelAccum>
+struct is_float_accumulator
+    : boost::mpl::bool_<boost::mpl::or_<boost::is_same<typename channel_type<PixelAccum>::type, float>,
+                                        boost::is_same<typename channel_type<PixelAccum>::type, bits32f> >::value &&
+                        sizeof(PixelAccum) == num_channels<PixelAccum>::value * sizeof(float)>
+{
+};
+
+/// Correlator of float accumulators, processing all the channels of a row buffer at once.
+template <typename PixelAccum>
+class correlator_float
+{
+private:
+    std::vector<float> _kernel;
+    std::vector<PixelAccum> _output;
+
+public:
+    template <typename Kernel>
+    correlator_float(const Kernel& ker)
+        : _kernel(ker.begin(), ker.end())
+    {
+    }
+
+    template <typename KernelIterator, typename DstIterator>
+    GIL_FORCEINLINE void operator()(const PixelAccum* src_begin, const PixelAccum* src_end, KernelIterator,
+                                    DstIterator dst_begin)
+    {
+        const std::size_t size = src_end - src_begin;
+        _output.resize(size);
+        correlate(src_begin, size, &_output.front());
+        terry::numeric::assign_pixels(&_output.front(), &_output.front() + size, dst_begin);
+    }
+
+    /// the destination has the accumulator layout, no temporary row
+    template <typename KernelIterator>
+    GIL_FORCEINLINE void operator()(const PixelAccum* src_begin, const PixelAccum* src_end, KernelIterator,
+                                    PixelAccum* dst_begin)
+    {
+        correlate(src_begin, src_end - src_begin, dst_begin);
+    }
+
+private:
+    GIL_FORCEINLINE void correlate(const PixelAccum* src, const std::size_t size, PixelAccum* dst) const
+    {
+        const std::size_t nbChannels = num_channels<PixelAccum>::value;
+        correlate_floats(reinterpret_cast<const float*>(src), size * nbChannels, nbChannels, &_kernel.front(),
+                         _kernel.size(), reinterpret_cast<float*>(dst));
+    }
+};
+
+/// @ingroup ImageAlgorithms
+/// correlate a 1D kernel along the rows of an image with the vectorized correlator
+template <typename PixelAccum, typename SrcView, typename Kernel, typename DstView, typename Correlator>
+GIL_FORCEINLINE void correlate_rows_select_imp(const SrcView& src, const Kernel& ker, const DstView& dst,
+                                               const typename SrcView::point_t& dst_tl,
+                                               const convolve_boundary_option option, Correlator,
+                                               const boost::mpl::true_ /*float accumulator*/)
+{
+    correlate_rows_imp<PixelAccum>(src, ker, dst, dst_tl, option, correlator_float<PixelAccum>(ker));
+}
+
+/// @ingroup ImageAlgorithms
+/// correlate a 1D kernel along the rows of an image with the generic @p correlator
+template <typename PixelAccum, typename SrcView, typename Kernel, typename DstView, typename Correlator>
+GIL_FORCEINLINE void correlate_rows_select_imp(const SrcView& src, const Kernel& ker, const DstView& dst,
+                                               const typename SrcView::point_t& dst_tl,
+                                               const convolve_boundary_option option, Correlator correlator,
+                                               const boost::mpl::false_ /*float accumulator*/)
+{
+    correlate_rows_imp<PixelAccum>(src, ker, dst, dst_tl, option, correlator);
+}
+
 /// @ingroup ImageAlgorithms
 /// correlate a 1D variable-size kernel along the rows of an image
 template <typename PixelAccum, typename SrcView, typename Kernel, typename DstView>
@@ -297,7 +373,8 @@ GIL_FORCEINLINE void correlate_1d_imp(const SrcView& src, const Kernel& ker, con
                                       const typename SrcView::point_t& dst_tl, const convolve_boundary_option option,
                                       const boost::mpl::true_ rows, const boost::mpl::false_ /*fixed*/)
 {
-    correlate_rows_imp<PixelAccum>(src, ker, dst, dst_tl, option, detail::correlator_n<PixelAccum>(ker.size()));
+    correlate_rows_select_imp<PixelAccum>(src, ker, dst, dst_tl, option, detail::correlator_n<PixelAccum>(ker.size()),
+                                          is_float_accumulator<PixelAccum>());
 }
 
 /// @ingroup ImageAlgorithms
@@ -307,7 +384,9 @@ GIL_FORCEINLINE void correlate_1d_imp(const SrcView& src, const Kernel& ker, con
                                       const typename SrcView::point_t& dst_tl, const convolve_boundary_option option,
                                       const boost::mpl::true_ rows, const boost::mpl::true_ /*fixed*/)
 {
-    correlate_rows_imp<PixelAccum>(src, ker, dst, dst_tl, option, detail::correlator_k<Kernel::static_size, PixelAccum>());
+    correlate_rows_select_imp<PixelAccum>(src, ker, dst, dst_tl, option,
+                                          detail::correlator_k<Kernel::static_size, PixelAccum>(),
+                                          is_float_accumulator<PixelAccum>());
 }
 
 /// @ingroup ImageAlgorithms
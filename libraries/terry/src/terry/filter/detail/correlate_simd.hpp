@@ -0,0 +1,152 @@
+#ifndef _TERRY_FILTER_DETAIL_CORRELATE_SIMD_HPP_
+#define _TERRY_FILTER_DETAIL_CORRELATE_SIMD_HPP_
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TERRY_FILTER_WITH_SSE2
+#include <emmintrin.h>
+#endif
+
+// the AVX2 version is compiled with a function attribute and selected at runtime
+#if defined(TERRY_FILTER_WITH_SSE2) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define TERRY_FILTER_WITH_AVX2
+#include <immintrin.h>
+#endif
+
+namespace terry
+{
+namespace filter
+{
+namespace detail
+{
+
+/**
+ * @brief Correlation of interleaved float channels with a 1D kernel.
+ *
+ * dst[i] = sum(ker[k] * src[i + k * step]) for i in [begin, size),
+ * with @p step the number of channels of a pixel, so each channel is only combined with itself.
+ */
+inline void correlate_floats_scalar(const float* src, const std::size_t begin, const std::size_t size,
+                                    const std::size_t step, const float* ker, const std::size_t ker_size, float* dst)
+{
+    for(std::size_t i = begin; i < size; ++i)
+    {
+        const float* s = src + i;
+        float acc = 0.f;
+        for(std::size_t k = 0; k < ker_size; ++k, s += step)
+            acc += ker[k] * *s;
+        dst[i] = acc;
+    }
+}
+
+#ifdef TERRY_FILTER_WITH_SSE2
+inline void correlate_floats_sse2(const float* src, const std::size_t size, const std::size_t step, const float* ker,
+                                  const std::size_t ker_size, float* dst)
+{
+    std::size_t i = 0;
+    // 16 outputs at a time, to load each kernel value once for 4 registers
+    for(; i + 16 <= size; i += 16)
+    {
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        __m128 acc2 = _mm_setzero_ps();
+        __m128 acc3 = _mm_setzero_ps();
+        const float* s = src + i;
+        for(std::size_t k = 0; k < ker_size; ++k, s += step)
+        {
+            const __m128 w = _mm_set1_ps(ker[k]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(w, _mm_loadu_ps(s)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(w, _mm_loadu_ps(s + 4)));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(w, _mm_loadu_ps(s + 8)));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(w, _mm_loadu_ps(s + 12)));
+        }
+        _mm_storeu_ps(dst + i, acc0);
+        _mm_storeu_ps(dst + i + 4, acc1);
+        _mm_storeu_ps(dst + i + 8, acc2);
+        _mm_storeu_ps(dst + i + 12, acc3);
+    }
+    for(; i + 4 <= size; i += 4)
+    {
+        __m128 acc = _mm_setzero_ps();
+        const float* s = src + i;
+        for(std::size_t k = 0; k < ker_size; ++k, s += step)
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(ker[k]), _mm_loadu_ps(s)));
+        _mm_storeu_ps(dst + i, acc);
+    }
+    correlate_floats_scalar(src, i, size, step, ker, ker_size, dst);
+}
+#endif
+
+#ifdef TERRY_FILTER_WITH_AVX2
+__attribute__((target("avx2"))) inline void correlate_floats_avx2(const float* src, const std::size_t size,
+                                                                  const std::size_t step, const float* ker,
+                                                                  const std::size_t ker_size, float* dst)
+{
+    std::size_t i = 0;
+    for(; i + 32 <= size; i += 32)
+    {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps();
+        __m256 acc3 = _mm256_setzero_ps();
+        const float* s = src + i;
+        for(std::size_t k = 0; k < ker_size; ++k, s += step)
+        {
+            const __m256 w = _mm256_set1_ps(ker[k]);
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(w, _mm256_loadu_ps(s)));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(w, _mm256_loadu_ps(s + 8)));
+            acc2 = _mm256_add_ps(acc2, _mm256_mul_ps(w, _mm256_loadu_ps(s + 16)));
+            acc3 = _mm256_add_ps(acc3, _mm256_mul_ps(w, _mm256_loadu_ps(s + 24)));
+        }
+        _mm256_storeu_ps(dst + i, acc0);
+        _mm256_storeu_ps(dst + i + 8, acc1);
+        _mm256_storeu_ps(dst + i + 16, acc2);
+        _mm256_storeu_ps(dst + i + 24, acc3);
+    }
+    for(; i + 8 <= size; i += 8)
+    {
+        __m256 acc = _mm256_setzero_ps();
+        const float* s = src + i;
+        for(std::size_t k = 0; k < ker_size; ++k, s += step)
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(ker[k]), _mm256_loadu_ps(s)));
+        _mm256_storeu_ps(dst + i, acc);
+    }
+    correlate_floats_scalar(src, i, size, step, ker, ker_size, dst);
+}
+
+inline bool cpu_supports_avx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+/**
+ * @brief Correlation of interleaved float channels with a 1D kernel,
+ *        using the widest vector instructions available on the running CPU.
+ * @param size number of floats to compute in @p dst
+ * @param step distance between two taps in @p src (the number of channels)
+ */
+inline void correlate_floats(const float* src, const std::size_t size, const std::size_t step, const float* ker,
+                             const std::size_t ker_size, float* dst)
+{
+#if defined(TERRY_FILTER_WITH_AVX2)
+    if(cpu_supports_avx2())
+    {
+        correlate_floats_avx2(src, size, step, ker, ker_size, dst);
+        return;
+    }
+#endif
+#if defined(TERRY_FILTER_WITH_SSE2)
+    correlate_floats_sse2(src, size, step, ker, ker_size, dst);
+#else
+    correlate_floats_scalar(src, 0, size, step, ker, ker_size, dst);
+#endif
+}
+}
+}
+}
+
+#endif
@@ -17,6 +17,17 @@ struct merge_per_pixel
 {
 }; ///< per pixel functor (instead of per channel)
 
+/**
+ * @brief Result of the merge of a pixel which doesn't need the evaluation of the functor.
+ */
+enum merge_shortcut
+{
+    merge_shortcut_none,   ///< evaluate the functor
+    merge_shortcut_copy_a, ///< the result is A
+    merge_shortcut_copy_b, ///< the result is B
+    merge_shortcut_zero    ///< the result is a null pixel
+};
+
 /**
  * @defgroup ViewsMerging
  * @brief merging functor base class
@@ -52,6 +63,17 @@ struct merge_functor<Pixel, merge_per_channel_with_alpha>
     value_t a; /// Alpha source A
     value_t b; /// Alpha source B
 
+    /// @brief Shortcuts of the functor on fully opaque pixels (alpha is max)
+    /// or fully transparent pixels (all the channels are null, as premultiplied pixels).
+    /// The result of a shortcut must be exactly the result of the functor,
+    /// functors redeclare the ones they allow.
+    /// @{
+    static const merge_shortcut if_a_opaque = merge_shortcut_none;
+    static const merge_shortcut if_a_transparent = merge_shortcut_none;
+    static const merge_shortcut if_b_opaque = merge_shortcut_none;
+    static const merge_shortcut if_b_transparent = merge_shortcut_none;
+    /// @}
+
     // no pure virtual here because virtual is not inlined with all compilators
     template <typename Channel>
     inline void operator()(const Channel& A, const Channel& B, Channel& d);
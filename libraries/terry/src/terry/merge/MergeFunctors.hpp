@@ -384,6 +384,7 @@ struct FunctorATop : public merge_functor<Pixel, merge_per_channel_with_alpha>
 {
     using merge_functor<Pixel, merge_per_channel_with_alpha>::a;
     using merge_functor<Pixel, merge_per_channel_with_alpha>::b;
+    static const merge_shortcut if_a_transparent = merge_shortcut_copy_b;
     //@todo: this functor only work on floats, on int types it
     //       needs to be specialized
     template <typename Channel>
@@ -400,6 +401,7 @@ struct FunctorConjointOver : public merge_functor<Pixel, merge_per_channel_with_
 {
     using merge_functor<Pixel, merge_per_channel_with_alpha>::a;
     using merge_functor<Pixel, merge_per_channel_with_alpha>::b;
+    static const merge_shortcut if_a_opaque = merge_shortcut_copy_a;
     //@todo: this functor only work on floats, on int types it
     //       needs to be specialized
     template <typename Channel>
@@ -439,6 +441,9 @@ struct FunctorIn : public merge_functor<Pixel, merge_per_channel_with_alpha>
 {
     using merge_functor<Pixel, merge_per_channel_with_alpha>::a;
     using merge_functor<Pixel, merge_per_channel_with_alpha>::b;
+    static const merge_shortcut if_a_transparent = merge_shortcut_zero;
+    static const merge_shortcut if_b_opaque = merge_shortcut_copy_a;
+    static const merge_shortcut if_b_transparent = merge_shortcut_zero;
     //@todo: this functor only work on floats, on int types it
     //       needs to be specialized
     template <typename Channel>
@@ -453,6 +458,9 @@ struct FunctorMask : public merge_functor<Pixel, merge_per_channel_with_alpha>
 {
     using merge_functor<Pixel, merge_per_channel_with_alpha>::a;
     using merge_functor<Pixel, merge_per_channel_with_alpha>::b;
+    static const merge_shortcut if_a_opaque = merge_shortcut_copy_b;
+    static const merge_shortcut if_a_transparent = merge_shortcut_zero;
+    static const merge_shortcut if_b_transparent = merge_shortcut_zero;
     //@todo: this functor only work on floats, on int types it
     //       needs to be specialized
     template <typename Channel>
@@ -467,6 +475,8 @@ struct FunctorMatte : public merge_functor<Pixel, merge_per_channel_with_alpha>
 {
     using merge_functor<Pixel, merge_per_channel_with_alpha>::a;
     using merge_functor<Pixel, merge_per_channel_with_alpha>::b;
+    static const merge_shortcut if_a_opaque = merge_shortcut_copy_a;
+    static const merge_shortcut if_a_transparent = merge_shortcut_copy_b;
     //@todo: this functor only work on floats, on int types it
     //       needs to be specialized
     template <typename Channel>
@@ -483,6 +493,9 @@ struct FunctorOut : public merge_functor<Pixel, merge_per_channel_with_alpha>
 {
     using merge_functor<Pixel, merge_per_channel_with_alpha>::a;
     using merge_functor<Pixel, merge_per_channel_with_alpha>::b;
+    static const merge_shortcut if_a_transparent = merge_shortcut_zero;
+    static const merge_shortcut if_b_opaque = merge_shortcut_zero;
+    static const merge_shortcut if_b_transparent = merge_shortcut_copy_a;
     //@todo: this functor only work on floats, on int types it
     //       needs to be specialized
     template <typename Channel>
@@ -499,6 +512,8 @@ struct FunctorOver : public merge_functor<Pixel, merge_per_channel_with_alpha>
 {
     using merge_functor<Pixel, merge_per_channel_with_alpha>::a;
     using merge_functor<Pixel, merge_per_channel_with_alpha>::b;
+    static const merge_shortcut if_a_opaque = merge_shortcut_copy_a;
+    static const merge_shortcut if_a_transparent = merge_shortcut_copy_b;
     //@todo: this functor only work on floats, on int types it
     //       needs to be specialized
     template <typename Channel>
@@ -513,6 +528,9 @@ struct FunctorStencil : public merge_functor<Pixel, merge_per_channel_with_alpha
 {
     using merge_functor<Pixel, merge_per_channel_with_alpha>::a;
     using merge_functor<Pixel, merge_per_channel_with_alpha>::b;
+    static const merge_shortcut if_a_opaque = merge_shortcut_zero;
+    static const merge_shortcut if_a_transparent = merge_shortcut_copy_b;
+    static const merge_shortcut if_b_transparent = merge_shortcut_zero;
     //@todo: this functor only work on floats, on int types it
     //       needs to be specialized
     template <typename Channel>
@@ -527,6 +545,8 @@ struct FunctorUnder : public merge_functor<Pixel, merge_per_channel_with_alpha>
 {
     using merge_functor<Pixel, merge_per_channel_with_alpha>::a;
     using merge_functor<Pixel, merge_per_channel_with_alpha>::b;
+    static const merge_shortcut if_b_opaque = merge_shortcut_copy_b;
+    static const merge_shortcut if_b_transparent = merge_shortcut_copy_a;
     //@todo: this functor only work on floats, on int types it
     //       needs to be specialized
     template <typename Channel>
@@ -541,6 +561,8 @@ struct FunctorXOR : public merge_functor<Pixel, merge_per_channel_with_alpha>
 {
     using merge_functor<Pixel, merge_per_channel_with_alpha>::a;
     using merge_functor<Pixel, merge_per_channel_with_alpha>::b;
+    static const merge_shortcut if_a_transparent = merge_shortcut_copy_b;
+    static const merge_shortcut if_b_transparent = merge_shortcut_copy_a;
     //@todo: this functor only work on floats, on int types it
     //       needs to be specialized
     template <typename Channel>
@@ -3,10 +3,14 @@
 
 #include "MergeAbstractFunctor.hpp"
 
+#include <terry/numeric/init.hpp>
+
 #include <boost/static_assert.hpp>
 #include <boost/gil/typedefs.hpp>
 #include <boost/gil/utilities.hpp>
 
+#include <iterator>
+
 namespace terry
 {
 
@@ -48,8 +52,154 @@ struct merger<merge_per_channel>
         static_for_each(A, B, d, fun);
     }
 };
+
+/**
+ * @brief Merge a row span, pixel by pixel.
+ */
+template <class OPERATES>
+struct pixel_span_merger
+{
+    template <class Iterator, class Functor>
+    GIL_FORCEINLINE void operator()(const Iterator& A, const Iterator& B, const Iterator& d, const std::ptrdiff_t width,
+                                    Functor& fun) const
+    {
+        merger<OPERATES> merge_op;
+        for(std::ptrdiff_t x = 0; x < width; ++x)
+            merge_op(A[x], B[x], d[x], fun);
+    }
+};
+
+template <class OPERATES>
+struct row_span_merger : public pixel_span_merger<OPERATES>
+{
+};
+
+/**
+ * @brief Merge a row span of interleaved pixels as a flat span of channels,
+ * so the compiler can vectorize the loop.
+ */
+template <>
+struct row_span_merger<merge_per_channel>
+{
+    template <class Pixel, class Functor>
+    GIL_FORCEINLINE void operator()(Pixel* A, Pixel* B, Pixel* d, const std::ptrdiff_t width, Functor& fun) const
+    {
+        typedef typename channel_type<Pixel>::type Channel;
+        const std::ptrdiff_t size = width * num_channels<Pixel>::value;
+        const Channel* a = &(*A)[0];
+        const Channel* b = &(*B)[0];
+        Channel* dst = &(*d)[0];
+        for(std::ptrdiff_t i = 0; i < size; ++i)
+            fun(a[i], b[i], dst[i]);
+    }
+
+    template <class Iterator, class Functor>
+    GIL_FORCEINLINE void operator()(const Iterator& A, const Iterator& B, const Iterator& d, const std::ptrdiff_t width,
+                                    Functor& fun) const
+    {
+        pixel_span_merger<merge_per_channel>()(A, B, d, width, fun);
+    }
+};
+
+template <class Pixel>
+GIL_FORCEINLINE bool is_transparent(const Pixel& p)
+{
+    for(int c = 0; c < num_channels<Pixel>::value; ++c)
+    {
+        if(p[c] != 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Shortcut of the merge of two pixels, from the shortcuts declared by the functor.
+ *
+ * Pixels without alpha are seen as opaque by the functors (see alpha_or_max),
+ * so a null pixel is only transparent if the pixel has an alpha channel.
+ */
+template <class Functor, class Pixel>
+GIL_FORCEINLINE merge_shortcut pixel_merge_shortcut(const Pixel& A, const Pixel& B)
+{
+    typedef typename channel_type<Pixel>::type Channel;
+    typedef typename contains_color<Pixel, alpha_t>::type has_alpha_t;
+    if(Functor::if_a_opaque != merge_shortcut_none && alpha_or_max(A) == channel_traits<Channel>::max_value())
+        return Functor::if_a_opaque;
+    if(has_alpha_t::value && Functor::if_a_transparent != merge_shortcut_none && is_transparent(A))
+        return Functor::if_a_transparent;
+    if(Functor::if_b_opaque != merge_shortcut_none && alpha_or_max(B) == channel_traits<Channel>::max_value())
+        return Functor::if_b_opaque;
+    if(has_alpha_t::value && Functor::if_b_transparent != merge_shortcut_none && is_transparent(B))
+        return Functor::if_b_transparent;
+    return merge_shortcut_none;
+}
+
+/**
+ * @brief Merge a row span of pixels with alpha, by runs of pixels of the same shortcut.
+ *
+ * Runs of fully transparent or fully opaque pixels are copied (or cleared)
+ * without evaluating the functor on each channel.
+ */
+template <>
+struct row_span_merger<merge_per_channel_with_alpha>
+{
+    template <class Iterator, class Functor>
+    GIL_FORCEINLINE void operator()(const Iterator& A, const Iterator& B, const Iterator& d, const std::ptrdiff_t width,
+                                    Functor& fun) const
+    {
+        typedef typename std::iterator_traits<Iterator>::value_type Pixel;
+        merger<merge_per_channel_with_alpha> merge_op;
+        Pixel zero;
+        numeric::pixel_zeros_t<Pixel>()(zero);
+
+        std::ptrdiff_t x = 0;
+        while(x < width)
+        {
+            const merge_shortcut shortcut = pixel_merge_shortcut<Functor>(A[x], B[x]);
+            std::ptrdiff_t end = x + 1;
+            while(end < width && pixel_merge_shortcut<Functor>(A[end], B[end]) == shortcut)
+                ++end;
+
+            switch(shortcut)
+            {
+                case merge_shortcut_none:
+                    for(; x < end; ++x)
+                        merge_op(A[x], B[x], d[x], fun);
+                    break;
+                case merge_shortcut_copy_a:
+                    for(; x < end; ++x)
+                        d[x] = A[x];
+                    break;
+                case merge_shortcut_copy_b:
+                    for(; x < end; ++x)
+                        d[x] = B[x];
+                    break;
+                case merge_shortcut_zero:
+                    for(; x < end; ++x)
+                        d[x] = zero;
+                    break;
+            }
+        }
+    }
+};
 } // end namespace detail
 
+/**
+ * @defgroup ViewsMerging
+ * @brief Merge a row span of @p width pixels by means of a given functor.
+ *
+ * The batch version of the functors: spans of interleaved pixels are merged as flat
+ * spans of channels, and the functors with alpha skip the runs of pixels declared
+ * by their shortcuts (see merge_functor<Pixel, merge_per_channel_with_alpha>).
+ * @p dst may be @p srcA or @p srcB.
+ **/
+template <class F, class Iterator>
+GIL_FORCEINLINE void merge_row_span(const Iterator& srcA, const Iterator& srcB, const Iterator& dst,
+                                    const std::ptrdiff_t width, F& fun)
+{
+    detail::row_span_merger<typename F::operating_mode_t>()(srcA, srcB, dst, width, fun);
+}
+
 /**
  * @defgroup ViewsMerging
  * @brief Merge two views by means of a given functor.
@@ -57,21 +207,14 @@ struct merger<merge_per_channel>
 template <class F, class View>
 void merge_views(const View& srcA, const View& srcB, View& dst, F fun)
 {
-    detail::merger<typename F::operating_mode_t> merge_op;
     // If merging functor needs alpha, check if destination contains alpha.
     typedef typename contains_color<typename View::value_type, alpha_t>::type has_alpha_t;
     //	BOOST_STATIC_ASSERT(( boost::is_same<typename F::operating_mode_t, merge_per_channel_with_alpha>::value ?
     // has_alpha_t::value : true ));
 
-    // Merge views.
+    // Merge views, row by row.
     for(std::ptrdiff_t y = 0; y < dst.height(); ++y)
-    {
-        typename View::x_iterator srcIt1 = srcA.row_begin(y);
-        typename View::x_iterator srcIt2 = srcB.row_begin(y);
-        typename View::x_iterator dstIt = dst.row_begin(y);
-        for(std::ptrdiff_t x = 0; x < dst.width(); ++x)
-            merge_op(srcIt1[x], srcIt2[x], dstIt[x], fun);
-    }
+        merge_row_span(srcA.row_begin(y), srcB.row_begin(y), dst.row_begin(y), dst.width(), fun);
 }
 }
 
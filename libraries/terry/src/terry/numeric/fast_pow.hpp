@@ -0,0 +1,181 @@
+#ifndef _TERRY_NUMERIC_FAST_POW_HPP_
+#define _TERRY_NUMERIC_FAST_POW_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TERRY_NUMERIC_WITH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace terry
+{
+namespace numeric
+{
+
+/**
+ * Polynomial approximations of log2 and exp2 on floats.
+ * The relative error of fast_pow is below 1e-5 for normal positive values and results,
+ * instead of a call to std::pow for each channel.
+ */
+namespace detail
+{
+// log2(m) = 2 / ln(2) * atanh(t), t = (m - 1) / (m + 1), with m in [sqrt(2)/2, sqrt(2)]
+static const float kLog2C1 = 2.8853900817779268f;
+static const float kLog2C3 = 0.9617966939259756f;
+static const float kLog2C5 = 0.5770780163555854f;
+static const float kLog2C7 = 0.4121985831111324f;
+static const float kLog2C9 = 0.3205988979753252f;
+// exp2(f) = exp(f * ln(2)) with f in [-0.5, 0.5]
+static const float kExp2C1 = 0.6931471805599453f;
+static const float kExp2C2 = 0.2402265069591007f;
+static const float kExp2C3 = 0.0555041086648216f;
+static const float kExp2C4 = 0.0096181291076285f;
+static const float kExp2C5 = 0.0013333558146428f;
+static const float kExp2C6 = 0.0001540353039338f;
+// exp2 of values out of these bounds is not a normal float
+static const float kExp2Min = -126.f;
+static const float kExp2Max = 127.f;
+}
+
+/// @brief log2 of a normal positive float
+inline float fast_log2(const float x)
+{
+    using namespace detail;
+    int bits;
+    std::memcpy(&bits, &x, sizeof(float));
+    int e = ((bits >> 23) & 0xff) - 127;
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float m;
+    std::memcpy(&m, &bits, sizeof(float));
+    if(m > 1.41421356f)
+    {
+        m *= 0.5f;
+        ++e;
+    }
+    const float t = (m - 1.f) / (m + 1.f);
+    const float t2 = t * t;
+    return e + t * (kLog2C1 + t2 * (kLog2C3 + t2 * (kLog2C5 + t2 * (kLog2C7 + t2 * kLog2C9))));
+}
+
+/// @brief exp2, clamped to the normal floats
+inline float fast_exp2(const float y)
+{
+    using namespace detail;
+    const float yc = std::max(kExp2Min, std::min(y, kExp2Max));
+    const int n = static_cast<int>(yc + (yc < 0 ? -0.5f : 0.5f));
+    const float f = yc - n;
+    const float p =
+        1.f + f * (kExp2C1 + f * (kExp2C2 + f * (kExp2C3 + f * (kExp2C4 + f * (kExp2C5 + f * kExp2C6)))));
+    const int bits = (n + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(float));
+    return p * scale;
+}
+
+/// @brief pow of a positive value, the other values are returned unchanged
+inline float fast_pow(const float x, const float e)
+{
+    if(!(x > 0.f) || e == 1.f)
+        return x;
+    return fast_exp2(e * fast_log2(x));
+}
+
+namespace detail
+{
+
+inline void pow_floats_scalar(const float* src, const std::size_t begin, const std::size_t size,
+                              const float* channelExponents, const std::size_t nbChannels, float* dst)
+{
+    for(std::size_t i = begin; i < size; ++i)
+        dst[i] = fast_pow(src[i], channelExponents[i % nbChannels]);
+}
+
+#ifdef TERRY_NUMERIC_WITH_SSE2
+inline __m128 fast_log2_sse2(const __m128 x)
+{
+    const __m128i bits = _mm_castps_si128(x);
+    __m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    __m128 m = _mm_castsi128_ps(
+        _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+    const __m128 big = _mm_cmpgt_ps(m, _mm_set1_ps(1.41421356f));
+    m = _mm_or_ps(_mm_and_ps(big, _mm_mul_ps(m, _mm_set1_ps(0.5f))), _mm_andnot_ps(big, m));
+    e = _mm_sub_epi32(e, _mm_castps_si128(big)); // the mask is -1
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 t = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+    const __m128 t2 = _mm_mul_ps(t, t);
+    __m128 p = _mm_add_ps(_mm_set1_ps(kLog2C7), _mm_mul_ps(t2, _mm_set1_ps(kLog2C9)));
+    p = _mm_add_ps(_mm_set1_ps(kLog2C5), _mm_mul_ps(t2, p));
+    p = _mm_add_ps(_mm_set1_ps(kLog2C3), _mm_mul_ps(t2, p));
+    p = _mm_add_ps(_mm_set1_ps(kLog2C1), _mm_mul_ps(t2, p));
+    return _mm_add_ps(_mm_cvtepi32_ps(e), _mm_mul_ps(t, p));
+}
+
+inline __m128 fast_exp2_sse2(const __m128 y)
+{
+    const __m128 yc = _mm_max_ps(_mm_set1_ps(kExp2Min), _mm_min_ps(y, _mm_set1_ps(kExp2Max)));
+    const __m128i n = _mm_cvtps_epi32(yc); // round to nearest
+    const __m128 f = _mm_sub_ps(yc, _mm_cvtepi32_ps(n));
+    __m128 p = _mm_add_ps(_mm_set1_ps(kExp2C5), _mm_mul_ps(f, _mm_set1_ps(kExp2C6)));
+    p = _mm_add_ps(_mm_set1_ps(kExp2C4), _mm_mul_ps(f, p));
+    p = _mm_add_ps(_mm_set1_ps(kExp2C3), _mm_mul_ps(f, p));
+    p = _mm_add_ps(_mm_set1_ps(kExp2C2), _mm_mul_ps(f, p));
+    p = _mm_add_ps(_mm_set1_ps(kExp2C1), _mm_mul_ps(f, p));
+    p = _mm_add_ps(_mm_set1_ps(1.f), _mm_mul_ps(f, p));
+    const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+    return _mm_mul_ps(p, scale);
+}
+
+inline __m128 fast_pow_sse2(const __m128 x, const __m128 e)
+{
+    const __m128 r = fast_exp2_sse2(_mm_mul_ps(e, fast_log2_sse2(x)));
+    // keep the values which are not positive and the channels with an exponent of 1
+    const __m128 keep = _mm_or_ps(_mm_cmpnlt_ps(_mm_setzero_ps(), x), _mm_cmpeq_ps(e, _mm_set1_ps(1.f)));
+    return _mm_or_ps(_mm_and_ps(keep, x), _mm_andnot_ps(keep, r));
+}
+
+inline void pow_floats_sse2(const float* src, const std::size_t size, const float* channelExponents,
+                            const std::size_t nbChannels, float* dst)
+{
+    // 12 floats contain a whole number of pixels of 1, 2, 3 or 4 channels
+    float pattern[12];
+    for(std::size_t i = 0; i < 12; ++i)
+        pattern[i] = channelExponents[i % nbChannels];
+    const __m128 e0 = _mm_loadu_ps(pattern);
+    const __m128 e1 = _mm_loadu_ps(pattern + 4);
+    const __m128 e2 = _mm_loadu_ps(pattern + 8);
+
+    std::size_t i = 0;
+    for(; i + 12 <= size; i += 12)
+    {
+        _mm_storeu_ps(dst + i, fast_pow_sse2(_mm_loadu_ps(src + i), e0));
+        _mm_storeu_ps(dst + i + 4, fast_pow_sse2(_mm_loadu_ps(src + i + 4), e1));
+        _mm_storeu_ps(dst + i + 8, fast_pow_sse2(_mm_loadu_ps(src + i + 8), e2));
+    }
+    pow_floats_scalar(src, i, size, channelExponents, nbChannels, dst);
+}
+#endif
+}
+
+/**
+ * @brief Raise interleaved float channels to a power per channel, with fast_pow.
+ *
+ * dst[i] = pow(src[i], channelExponents[i % nbChannels]) for the positive values,
+ * the other values are copied. @p src and @p dst may be the same buffer.
+ * @param nbChannels number of channels of a pixel, from 1 to 4
+ */
+inline void pow_floats(const float* src, const std::size_t size, const float* channelExponents,
+                       const std::size_t nbChannels, float* dst)
+{
+#ifdef TERRY_NUMERIC_WITH_SSE2
+    detail::pow_floats_sse2(src, size, channelExponents, nbChannels, dst);
+#else
+    detail::pow_floats_scalar(src, 0, size, channelExponents, nbChannels, dst);
+#endif
+}
+}
+}
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef _TERRY_NUMERIC_MOMENTS_HPP_
+#define _TERRY_NUMERIC_MOMENTS_HPP_
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/pixel.hpp>
+
+#include <cmath>
+#include <cstddef>
+
+namespace terry
+{
+namespace numeric
+{
+
+using namespace boost::gil;
+
+/**
+ * @brief Mean and central moments (up to the 4th order) of each channel of a set of pixels.
+ *
+ * The pixels are accumulated one by one, and the moments of two sets can be merged
+ * (formulas of Chan and Pebay), so it is a reducer for terry::algorithm::reduce_pixels.
+ * The sums of the powers of the deviations to the mean don't suffer from the
+ * cancellation of the raw sums of powers.
+ */
+template <typename Pixel>
+struct pixel_moments_t
+{
+    static const int nbChannels = num_channels<Pixel>::value;
+
+    std::size_t count;
+    double mean[nbChannels];
+    double m2[nbChannels]; ///< sum of (x - mean)^2
+    double m3[nbChannels]; ///< sum of (x - mean)^3
+    double m4[nbChannels]; ///< sum of (x - mean)^4
+
+    pixel_moments_t()
+        : count(0)
+    {
+        for(int c = 0; c < nbChannels; ++c)
+        {
+            mean[c] = 0;
+            m2[c] = 0;
+            m3[c] = 0;
+            m4[c] = 0;
+        }
+    }
+
+    template <typename P>
+    GIL_FORCEINLINE void operator()(const P& p)
+    {
+        const double n1 = count;
+        ++count;
+        const double n = count;
+        const double invN = 1.0 / n;
+        for(int c = 0; c < nbChannels; ++c)
+        {
+            const double delta = p[c] - mean[c];
+            const double deltaN = delta * invN;
+            const double deltaN2 = deltaN * deltaN;
+            const double term1 = delta * deltaN * n1;
+            mean[c] += deltaN;
+            m4[c] += term1 * deltaN2 * (n * n - 3 * n + 3) + 6 * deltaN2 * m2[c] - 4 * deltaN * m3[c];
+            m3[c] += term1 * deltaN * (n - 2) - 3 * deltaN * m2[c];
+            m2[c] += term1;
+        }
+    }
+
+    void merge(const pixel_moments_t& other)
+    {
+        if(other.count == 0)
+            return;
+        if(count == 0)
+        {
+            *this = other;
+            return;
+        }
+        const double na = count;
+        const double nb = other.count;
+        const double n = na + nb;
+        for(int c = 0; c < nbChannels; ++c)
+        {
+            const double delta = other.mean[c] - mean[c];
+            const double delta2 = delta * delta;
+            const double deltaN = delta / n;
+            const double deltaN2 = deltaN * deltaN;
+            m4[c] += other.m4[c] + delta2 * deltaN2 * na * nb * (na * na - na * nb + nb * nb) / n +
+                     6 * deltaN2 * (na * na * other.m2[c] + nb * nb * m2[c]) +
+                     4 * deltaN * (na * other.m3[c] - nb * m3[c]);
+            m3[c] += other.m3[c] + delta * deltaN2 * na * nb * (na - nb) + 3 * deltaN * (na * other.m2[c] - nb * m2[c]);
+            m2[c] += other.m2[c] + delta * deltaN * na * nb;
+            mean[c] += deltaN * nb;
+        }
+        count += other.count;
+    }
+
+    /// @brief population variance
+    double variance(const int c) const { return m2[c] / count; }
+
+    double standard_deviation(const int c) const { return std::sqrt(variance(c)); }
+
+    double skewness(const int c) const { return std::sqrt(double(count)) * m3[c] / std::pow(m2[c], 1.5); }
+
+    /// @brief excess kurtosis
+    double kurtosis(const int c) const { return count * m4[c] / (m2[c] * m2[c]) - 3.0; }
+};
+}
+}
+
+#endif
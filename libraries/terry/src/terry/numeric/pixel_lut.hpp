@@ -0,0 +1,74 @@
+#ifndef _TERRY_NUMERIC_PIXEL_LUT_HPP_
+#define _TERRY_NUMERIC_PIXEL_LUT_HPP_
+
+#include <terry/globals.hpp>
+
+#include <boost/gil/channel.hpp>
+#include <boost/gil/pixel.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <vector>
+
+namespace terry
+{
+namespace numeric
+{
+
+/**
+ * @brief Table of the results of a per-channel pixel operation, for all the values of an integer channel.
+ *
+ * Built once per render, it replaces the evaluation of an expensive operation (pow, log...)
+ * on each channel of each pixel by a lookup, for 8 and 16 bits images.
+ * The table of each channel is built by applying the operation on pixels with all the channels
+ * set to the same value, so the operation must process each channel independently
+ * (or the pixel must have a single channel).
+ */
+template <typename Pixel>
+class pixel_lut
+{
+public:
+    typedef typename channel_type<Pixel>::type Channel;
+    typedef typename channel_traits<Channel>::value_type ChannelValue;
+    BOOST_STATIC_ASSERT(boost::is_integral<ChannelValue>::value && sizeof(ChannelValue) <= 2);
+    static const int nbChannels = num_channels<Pixel>::value;
+
+private:
+    std::vector<Channel> _tables[nbChannels];
+
+public:
+    /**
+     * @param op functor computing the output pixel of an input pixel
+     */
+    template <typename PixelOp>
+    void build(const PixelOp& op)
+    {
+        const int minValue = channel_traits<Channel>::min_value();
+        const int maxValue = channel_traits<Channel>::max_value();
+        for(int c = 0; c < nbChannels; ++c)
+            _tables[c].resize(maxValue - minValue + 1);
+        for(int v = minValue; v <= maxValue; ++v)
+        {
+            Pixel p;
+            for(int c = 0; c < nbChannels; ++c)
+                p[c] = Channel(v);
+            const Pixel result = op(p);
+            for(int c = 0; c < nbChannels; ++c)
+                _tables[c][v - minValue] = result[c];
+        }
+    }
+
+    GIL_FORCEINLINE
+    Pixel operator()(const Pixel& p) const
+    {
+        const int minValue = channel_traits<Channel>::min_value();
+        Pixel result;
+        for(int c = 0; c < nbChannels; ++c)
+            result[c] = _tables[c][int(p[c]) - minValue];
+        return result;
+    }
+};
+}
+}
+
+#endif
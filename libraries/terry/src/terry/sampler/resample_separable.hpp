@@ -0,0 +1,181 @@
+#ifndef _TERRY_SAMPLER_RESAMPLE_SEPARABLE_HPP_
+#define _TERRY_SAMPLER_RESAMPLE_SEPARABLE_HPP_
+
+#include <terry/sampler/resample_progress.hpp>
+#include <terry/geometry/affine.hpp>
+#include <terry/math/Rect.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace terry
+{
+namespace sampler
+{
+
+/**
+ * @brief Weights of a sampler along one axis, precomputed for a range of output positions.
+ *
+ * The output position i is mapped on the source position scale * i + offset.
+ * Like the generic sample() function, the taps are the window of pixels around the floor of this position.
+ * The source index of each tap is resolved with the out of image process, -1 means the tap uses the outside value.
+ */
+template <typename Weight>
+struct resample_weight_table
+{
+    std::size_t _windowSize;
+    std::ptrdiff_t _begin;               ///< first output position
+    std::vector<std::ptrdiff_t> _indexes; ///< _windowSize source indexes for each output position
+    std::vector<Weight> _weights;        ///< _windowSize weights for each output position
+
+    template <typename Sampler>
+    resample_weight_table(Sampler& sampler, const double scale, const double offset, const std::ptrdiff_t begin,
+                          const std::ptrdiff_t end, const std::ptrdiff_t srcSize,
+                          const EParamFilterOutOfImage outOfImageProcess)
+        : _windowSize(sampler._windowSize)
+        , _begin(begin)
+        , _indexes((end - begin) * sampler._windowSize)
+        , _weights((end - begin) * sampler._windowSize)
+    {
+        const std::ptrdiff_t middlePosition = std::floor((_windowSize - 1.0) * 0.5);
+        for(std::ptrdiff_t i = begin; i < end; ++i)
+        {
+            const double p = scale * i + offset;
+            const std::ptrdiff_t pTL = static_cast<std::ptrdiff_t>(std::floor(p));
+            const RESAMPLING_CORE_TYPE frac = p - pTL;
+            const std::size_t first = (i - begin) * _windowSize;
+            for(std::size_t t = 0; t < _windowSize; ++t)
+            {
+                RESAMPLING_CORE_TYPE distance = -frac - middlePosition + t;
+                sampler(distance, _weights[first + t]);
+
+                std::ptrdiff_t index = pTL - middlePosition + t;
+                if(index < 0 || index >= srcSize)
+                {
+                    if(outOfImageProcess == eParamFilterOutCopy)
+                        index = (index < 0) ? 0 : srcSize - 1;
+                    else
+                        index = -1;
+                }
+                _indexes[first + t] = index;
+            }
+        }
+    }
+
+    const std::ptrdiff_t* indexes(const std::ptrdiff_t i) const { return &_indexes[(i - _begin) * _windowSize]; }
+    const Weight* weights(const std::ptrdiff_t i) const { return &_weights[(i - _begin) * _windowSize]; }
+};
+
+/**
+ * @brief Resample with an axis-aligned mapping in two 1D passes.
+ *
+ * The weights are computed once for each column and each row of the @p procWindow,
+ * then the source rows needed are filtered horizontally into a floating point buffer
+ * which is filtered vertically into the destination.
+ * The mappings with a rotation or a shear and the mirror out of image process use the generic 2D sampling.
+ */
+template <typename Sampler, // Models SamplerConcept
+          typename SrcView, // Models RandomAccess2DImageViewConcept
+          typename DstView, // Models MutableRandomAccess2DImageViewConcept
+          typename F, typename Progress>
+void resample_pixels_separable_progress(const SrcView& src_view, const DstView& dst_view,
+                                        const matrix3x2<F>& dst_to_src, const terry::Rect<std::ssize_t>& procWindow,
+                                        const EParamFilterOutOfImage& outOfImageProcess, Progress& p,
+                                        Sampler sampler = Sampler())
+{
+    typedef typename SrcView::value_type SrcP;
+    typedef typename floating_pixel_from_view<SrcView>::type SrcC;
+    typedef RESAMPLING_CORE_TYPE Weight;
+
+    if(dst_to_src.b != 0 || dst_to_src.c != 0 || outOfImageProcess == eParamFilterOutMirror)
+    {
+        resample_pixels_progress(src_view, dst_view, dst_to_src, procWindow, outOfImageProcess, p, sampler);
+        return;
+    }
+    const std::ptrdiff_t width = procWindow.x2 - procWindow.x1;
+    if(width <= 0 || procWindow.y2 <= procWindow.y1)
+        return;
+
+    const resample_weight_table<Weight> xTable(sampler, dst_to_src.a, dst_to_src.e, procWindow.x1, procWindow.x2,
+                                               src_view.width(), outOfImageProcess);
+    const resample_weight_table<Weight> yTable(sampler, dst_to_src.d, dst_to_src.f, procWindow.y1, procWindow.y2,
+                                               src_view.height(), outOfImageProcess);
+    const std::size_t windowSize = sampler._windowSize;
+
+    SrcC outside(0);
+    if(outOfImageProcess == eParamFilterOutBlack)
+        outside = get_black<SrcC>();
+    const std::vector<SrcC> outsideRow(width, outside);
+
+    // source rows used by the vertical pass
+    std::ptrdiff_t rowBegin = src_view.height();
+    std::ptrdiff_t rowEnd = 0;
+    for(std::vector<std::ptrdiff_t>::const_iterator it = yTable._indexes.begin(), itEnd = yTable._indexes.end();
+        it != itEnd; ++it)
+    {
+        if(*it < 0)
+            continue;
+        rowBegin = std::min(rowBegin, *it);
+        rowEnd = std::max(rowEnd, *it + 1);
+    }
+
+    // horizontal pass
+    std::vector<SrcC> rows(std::max<std::ptrdiff_t>(rowEnd - rowBegin, 0) * width);
+    for(std::ptrdiff_t y = rowBegin; y < rowEnd; ++y)
+    {
+        const typename SrcView::x_iterator sit = src_view.row_begin(y);
+        SrcC* row = &rows[(y - rowBegin) * width];
+        for(std::ptrdiff_t x = 0; x < width; ++x)
+        {
+            const std::ptrdiff_t* indexes = xTable.indexes(procWindow.x1 + x);
+            const Weight* weights = xTable.weights(procWindow.x1 + x);
+            SrcC mp(0);
+            for(std::size_t t = 0; t < windowSize; ++t)
+            {
+                if(indexes[t] < 0)
+                    details::add_dst_mul_src<SrcC, Weight, SrcC>()(outside, weights[t], mp);
+                else
+                    details::add_dst_mul_src<SrcP, Weight, SrcC>()(sit[indexes[t]], weights[t], mp);
+            }
+            row[x] = mp;
+        }
+    }
+
+    // vertical pass
+    std::vector<SrcC> mpRow(width);
+    for(std::ptrdiff_t y = procWindow.y1; y < procWindow.y2; ++y)
+    {
+        std::fill(mpRow.begin(), mpRow.end(), SrcC(0));
+        const std::ptrdiff_t* indexes = yTable.indexes(y);
+        const Weight* weights = yTable.weights(y);
+        for(std::size_t t = 0; t < windowSize; ++t)
+        {
+            const SrcC* row = (indexes[t] < 0) ? &outsideRow[0] : &rows[(indexes[t] - rowBegin) * width];
+            for(std::ptrdiff_t x = 0; x < width; ++x)
+                details::add_dst_mul_src<SrcC, Weight, SrcC>()(row[x], weights[t], mpRow[x]);
+        }
+
+        typename DstView::x_iterator dit = dst_view.row_begin(y) + procWindow.x1;
+        for(std::ptrdiff_t x = 0; x < width; ++x)
+            color_convert(mpRow[x], dit[x]);
+
+        if(p.progressForward(width))
+            return;
+    }
+}
+
+/**
+ * @brief Generic mappings are not separable, use the 2D sampling.
+ */
+template <typename Sampler, typename SrcView, typename DstView, typename MapFn, typename Progress>
+void resample_pixels_separable_progress(const SrcView& src_view, const DstView& dst_view, const MapFn& dst_to_src,
+                                        const terry::Rect<std::ssize_t>& procWindow,
+                                        const EParamFilterOutOfImage& outOfImageProcess, Progress& p,
+                                        Sampler sampler = Sampler())
+{
+    resample_pixels_progress(src_view, dst_view, dst_to_src, procWindow, outOfImageProcess, p, sampler);
+}
+}
+}
+
+#endif
@@ -0,0 +1,298 @@
+#include <terry/globals.hpp>
+#include <terry/algorithm/integral_image.hpp>
+#include <terry/algorithm/reduce_pixels.hpp>
+#include <terry/numeric/minmax.hpp>
+#include <terry/numeric/moments.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/typedefs.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define BOOST_TEST_MODULE terry_algorithm_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace
+{
+
+/// run the blocks from the last one, like threads finishing in any order
+struct reverse_executor
+{
+    template <typename Task>
+    void operator()(Task& task, const std::size_t nbBlocks) const
+    {
+        for(std::size_t i = nbBlocks; i > 0; --i)
+            task(i - 1);
+    }
+};
+
+void fill_random(const terry::rgba32f_view_t& view)
+{
+    std::srand(42);
+    for(std::ptrdiff_t y = 0; y < view.height(); ++y)
+        for(std::ptrdiff_t x = 0; x < view.width(); ++x)
+            for(int c = 0; c < 4; ++c)
+                view(x, y)[c] = 1000.f + std::rand() / float(RAND_MAX) * (c + 1);
+}
+
+/// only accumulate the pixels of the mask
+struct masked_moments : terry::numeric::pixel_moments_t<terry::gray32f_pixel_t>
+{
+    using terry::numeric::pixel_moments_t<terry::gray32f_pixel_t>::operator();
+
+    void operator()(const terry::gray32f_pixel_t& p, const terry::gray8_pixel_t& m)
+    {
+        if(m[0])
+            (*this)(p);
+    }
+};
+}
+
+BOOST_AUTO_TEST_SUITE(terry_algorithm_reduce_pixels)
+
+BOOST_AUTO_TEST_CASE(reduce_pixels_moments)
+{
+    using namespace terry::numeric;
+    using namespace terry::algorithm;
+
+    terry::rgba32f_image_t img(97, 61);
+    fill_random(terry::view(img));
+    const terry::rgba32f_view_t view = terry::view(img);
+
+    // two-pass reference
+    double mean[4] = {0, 0, 0, 0};
+    double m2[4] = {0, 0, 0, 0};
+    double m3[4] = {0, 0, 0, 0};
+    double m4[4] = {0, 0, 0, 0};
+    const double n = view.width() * view.height();
+    for(std::ptrdiff_t y = 0; y < view.height(); ++y)
+        for(std::ptrdiff_t x = 0; x < view.width(); ++x)
+            for(int c = 0; c < 4; ++c)
+                mean[c] += view(x, y)[c] / n;
+    for(std::ptrdiff_t y = 0; y < view.height(); ++y)
+    {
+        for(std::ptrdiff_t x = 0; x < view.width(); ++x)
+        {
+            for(int c = 0; c < 4; ++c)
+            {
+                const double d = view(x, y)[c] - mean[c];
+                m2[c] += d * d;
+                m3[c] += d * d * d;
+                m4[c] += d * d * d * d;
+            }
+        }
+    }
+
+    typedef pixel_moments_t<terry::rgba32f_pixel_t> Moments;
+    const Moments moments = reduce_pixels(view, Moments(), serial_executor(), 7);
+    BOOST_CHECK_EQUAL(moments.count, std::size_t(n));
+    for(int c = 0; c < 4; ++c)
+    {
+        BOOST_CHECK_CLOSE(moments.mean[c], mean[c], 1e-9);
+        BOOST_CHECK_CLOSE(moments.m2[c], m2[c], 1e-6);
+        BOOST_CHECK_SMALL(moments.m3[c] - m3[c], 1e-6 * std::abs(m2[c]));
+        BOOST_CHECK_CLOSE(moments.m4[c], m4[c], 1e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reduce_pixels_deterministic)
+{
+    using namespace terry::numeric;
+    using namespace terry::algorithm;
+
+    terry::rgba32f_image_t img(64, 100);
+    fill_random(terry::view(img));
+    const terry::rgba32f_view_t view = terry::view(img);
+
+    // the result doesn't depend on the execution order of the blocks
+    typedef pixel_moments_t<terry::rgba32f_pixel_t> Moments;
+    const Moments serial = reduce_pixels(view, Moments(), serial_executor());
+    const Moments reversed = reduce_pixels(view, Moments(), reverse_executor());
+    BOOST_CHECK(std::memcmp(serial.mean, reversed.mean, sizeof(serial.mean)) == 0);
+    BOOST_CHECK(std::memcmp(serial.m2, reversed.m2, sizeof(serial.m2)) == 0);
+    BOOST_CHECK(std::memcmp(serial.m4, reversed.m4, sizeof(serial.m4)) == 0);
+
+    typedef pixel_minmax_by_channel_t<terry::rgba32f_pixel_t> MinMax;
+    view(10, 90) = terry::rgba32f_pixel_t(-1.f, -2.f, -3.f, -4.f);
+    view(63, 3) = terry::rgba32f_pixel_t(5000.f, 5000.f, 5000.f, 5000.f);
+    const MinMax minmax = reduce_pixels(view, MinMax(view(0, 0)), reverse_executor());
+    BOOST_CHECK_EQUAL(minmax.min[3], -4.f);
+    BOOST_CHECK_EQUAL(minmax.max[0], 5000.f);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_pixels_mask)
+{
+    using namespace terry::numeric;
+    using namespace terry::algorithm;
+
+    terry::gray32f_image_t img(10, 10);
+    terry::gray8_image_t mask(10, 10);
+    for(std::ptrdiff_t y = 0; y < 10; ++y)
+    {
+        for(std::ptrdiff_t x = 0; x < 10; ++x)
+        {
+            terry::view(img)(x, y) = terry::gray32f_pixel_t(float(x));
+            terry::view(mask)(x, y) = terry::gray8_pixel_t(x < 5 ? 1 : 0);
+        }
+    }
+
+    const masked_moments moments =
+        reduce_pixels(terry::const_view(img), terry::const_view(mask), masked_moments(), serial_executor(), 3);
+    BOOST_CHECK_EQUAL(moments.count, std::size_t(50));
+    BOOST_CHECK_CLOSE(moments.mean[0], 2.0, 1e-9);
+    BOOST_CHECK_CLOSE(moments.variance(0), 2.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(terry_algorithm_integral_image)
+
+BOOST_AUTO_TEST_CASE(integral_image_rectangles)
+{
+    using namespace terry::algorithm;
+
+    terry::rgba32f_image_t img(53, 37);
+    fill_random(terry::view(img));
+    const terry::rgba32f_view_t view = terry::view(img);
+
+    // small blocks, so both passes have an incomplete last block
+    integral_image_t<4> ii;
+    ii.compute(view, serial_executor(), true, 5);
+    BOOST_CHECK_EQUAL(ii.width(), 53);
+    BOOST_CHECK_EQUAL(ii.height(), 37);
+
+    const std::ptrdiff_t rects[][4] = {{0, 0, 53, 37}, {3, 4, 10, 20}, {52, 36, 53, 37}, {7, 0, 8, 37}, {5, 5, 5, 9}};
+    for(std::size_t r = 0; r < sizeof(rects) / sizeof(rects[0]); ++r)
+    {
+        const std::ptrdiff_t* rect = rects[r];
+        for(int c = 0; c < 4; ++c)
+        {
+            double sum = 0.0;
+            double squares = 0.0;
+            for(std::ptrdiff_t y = rect[1]; y < rect[3]; ++y)
+            {
+                for(std::ptrdiff_t x = rect[0]; x < rect[2]; ++x)
+                {
+                    sum += view(x, y)[c];
+                    squares += double(view(x, y)[c]) * view(x, y)[c];
+                }
+            }
+            BOOST_CHECK_CLOSE(ii.sum(rect[0], rect[1], rect[2], rect[3], c) + 1.0, sum + 1.0, 1e-9);
+            BOOST_CHECK_CLOSE(ii.square_sum(rect[0], rect[1], rect[2], rect[3], c) + 1.0, squares + 1.0, 1e-9);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(integral_image_variance)
+{
+    using namespace terry::algorithm;
+
+    terry::gray32f_image_t img(10, 10);
+    for(std::ptrdiff_t y = 0; y < 10; ++y)
+        for(std::ptrdiff_t x = 0; x < 10; ++x)
+            terry::view(img)(x, y) = terry::gray32f_pixel_t(float(x));
+
+    integral_image_t<1> ii;
+    ii.compute(terry::const_view(img), serial_executor(), true);
+    BOOST_CHECK_CLOSE(ii.mean(0, 2, 5, 7), 2.0, 1e-9);
+    BOOST_CHECK_CLOSE(ii.variance(0, 2, 5, 7), 2.0, 1e-9);
+    BOOST_CHECK_SMALL(ii.variance(3, 0, 4, 10), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(integral_image_deterministic)
+{
+    using namespace terry::algorithm;
+
+    terry::rgba32f_image_t img(70, 45);
+    fill_random(terry::view(img));
+
+    // the table doesn't depend on the execution order of the blocks
+    integral_image_t<3> serial;
+    integral_image_t<3> reversed;
+    serial.compute(terry::view(img), serial_executor(), false, 8);
+    reversed.compute(terry::view(img), reverse_executor(), false, 8);
+    for(std::ptrdiff_t y = 0; y <= 45; y += 9)
+        for(std::ptrdiff_t x = 0; x <= 70; x += 7)
+            for(int c = 0; c < 3; ++c)
+                BOOST_CHECK_EQUAL(serial.sum(0, 0, x, y, c), reversed.sum(0, 0, x, y, c));
+}
+
+BOOST_AUTO_TEST_CASE(integral_image_patch_distances)
+{
+    using namespace terry::algorithm;
+
+    // the NL-means patch distances: sums of the squared distances between the pixels and the displaced pixels,
+    // on the patches clipped by the image (pixels displaced outside the image count as null distances)
+    const std::ptrdiff_t w = 23;
+    const std::ptrdiff_t h = 17;
+    const std::ptrdiff_t patchRadius = 3;
+    terry::rgba32f_image_t img(w, h);
+    fill_random(terry::view(img));
+    const terry::rgba32f_view_t view = terry::view(img);
+
+    terry::gray64f_image_t distances(w, h);
+    const terry::gray64f_view_t distView = terry::view(distances);
+    const std::ptrdiff_t displacements[][2] = {{1, 0}, {0, 1}, {-2, 3}, {4, -5}, {-7, -1}, {22, 16}};
+    for(std::size_t d = 0; d < sizeof(displacements) / sizeof(displacements[0]); ++d)
+    {
+        const std::ptrdiff_t dx = displacements[d][0];
+        const std::ptrdiff_t dy = displacements[d][1];
+        for(std::ptrdiff_t y = 0; y < h; ++y)
+        {
+            for(std::ptrdiff_t x = 0; x < w; ++x)
+            {
+                double dist = 0.0;
+                if(x + dx >= 0 && x + dx < w && y + dy >= 0 && y + dy < h)
+                {
+                    for(int c = 0; c < 3; ++c)
+                    {
+                        const double e = view(x + dx, y + dy)[c] - view(x, y)[c];
+                        dist += e * e;
+                    }
+                }
+                distView(x, y)[0] = dist;
+            }
+        }
+        integral_image_t<1> ii;
+        ii.compute(distView, serial_executor(), false, 4);
+
+        // all the pixels, the ones on the borders have clipped patches
+        std::size_t nbErrors = 0;
+        for(std::ptrdiff_t y = 0; y < h; ++y)
+        {
+            for(std::ptrdiff_t x = 0; x < w; ++x)
+            {
+                double naive = 0.0;
+                for(std::ptrdiff_t py = std::max<std::ptrdiff_t>(y - patchRadius, 0);
+                    py < std::min<std::ptrdiff_t>(y + patchRadius + 1, h); ++py)
+                {
+                    for(std::ptrdiff_t px = std::max<std::ptrdiff_t>(x - patchRadius, 0);
+                        px < std::min<std::ptrdiff_t>(x + patchRadius + 1, w); ++px)
+                    {
+                        if(px + dx < 0 || px + dx >= w || py + dy < 0 || py + dy >= h)
+                            continue;
+                        for(int c = 0; c < 3; ++c)
+                        {
+                            const double e = view(px + dx, py + dy)[c] - view(px, py)[c];
+                            naive += e * e;
+                        }
+                    }
+                }
+                const double sum = ii.sum(std::max<std::ptrdiff_t>(x - patchRadius, 0),
+                                          std::max<std::ptrdiff_t>(y - patchRadius, 0),
+                                          std::min<std::ptrdiff_t>(x + patchRadius + 1, w),
+                                          std::min<std::ptrdiff_t>(y + patchRadius + 1, h));
+                if(std::abs(sum - naive) > 1e-9 * (naive + 1.0))
+                    ++nbErrors;
+            }
+        }
+        BOOST_CHECK_MESSAGE(nbErrors == 0, "displacement (" << dx << ", " << dy << "): " << nbErrors << " errors");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,12 @@
+#ifndef _TERRY_TESTS_BENCHMARKS_HPP_
+#define _TERRY_TESTS_BENCHMARKS_HPP_
+
+/**
+ * @brief Benchmarks of terry algorithms.
+ * They only print timings, so they are not part of the unit tests.
+ */
+
+void benchmarkConvolve();
+void benchmarkBoxBlur();
+
+#endif
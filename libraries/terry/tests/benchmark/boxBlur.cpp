@@ -0,0 +1,42 @@
+#include "benchmarks.hpp"
+
+#include <terry/globals.hpp>
+#include <terry/filter/boxBlur.hpp>
+#include <terry/filter/gaussianKernel.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/typedefs.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <iostream>
+
+void benchmarkBoxBlur()
+{
+    using namespace terry::filter;
+
+    terry::rgba32f_image_t src(1024, 512);
+    terry::rgba32f_image_t dst(src.dimensions());
+    terry::fill_pixels(terry::view(src), terry::rgba32f_pixel_t(0.5f, 0.25f, 1.f, 1.f));
+    const terry::point2<std::ptrdiff_t> zero(0, 0);
+
+    std::cout << "blur of rgba32f 1024x512, gaussian kernel / box filters:" << std::endl;
+    const float sizes[] = {1, 10, 100, 1000, 10000};
+    for(std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        const kernel_1d<float> kernel = buildGaussian1DKernel<float>(sizes[i]);
+        const std::vector<std::size_t> radius = boxRadiusForGaussian(sizes[i]);
+
+        boost::posix_time::ptime t0(boost::posix_time::microsec_clock::local_time());
+        correlate_rows_cols_auto<terry::rgba32f_pixel_t, std::allocator>(terry::const_view(src), kernel, kernel,
+                                                                         terry::view(dst), zero,
+                                                                         convolve_option_extend_mirror);
+        boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
+        box_blur_rows_cols<terry::rgba32f_pixel_t, std::allocator>(terry::const_view(src), radius, radius,
+                                                                   terry::view(dst), zero,
+                                                                   convolve_option_extend_mirror);
+        boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
+
+        std::cout << "  size " << sizes[i] << " (" << kernel.size() << " taps): " << (t1 - t0).total_milliseconds()
+                  << " ms / " << (t2 - t1).total_milliseconds() << " ms" << std::endl;
+    }
+}
@@ -0,0 +1,91 @@
+#include "benchmarks.hpp"
+
+#include <terry/globals.hpp>
+#include <terry/filter/convolve.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/typedefs.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+
+namespace
+{
+
+terry::filter::kernel_1d<float> makeKernel(const std::size_t size)
+{
+    terry::filter::kernel_1d<float> kernel(size, size / 2);
+    float sum = 0;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        const float x = (float(i) - float(size / 2)) / (0.3f * size);
+        kernel[i] = std::exp(-x * x);
+        sum += kernel[i];
+    }
+    for(std::size_t i = 0; i < size; ++i)
+        kernel[i] /= sum;
+    return kernel;
+}
+
+template <typename View>
+void fillRandom(const View& view, const float maxValue)
+{
+    typedef typename terry::channel_type<View>::type Channel;
+    for(std::ptrdiff_t y = 0; y < view.height(); ++y)
+    {
+        typename View::x_iterator it = view.row_begin(y);
+        for(std::ptrdiff_t x = 0; x < view.width(); ++x, ++it)
+            for(int c = 0; c < terry::num_channels<View>::value; ++c)
+                (*it)[c] = Channel(maxValue * std::rand() / RAND_MAX);
+    }
+}
+
+/// correlation of rows with the generic correlator, for reference
+template <typename PixelAccum, typename SrcView, typename DstView>
+void correlateRowsGeneric(const SrcView& src, const terry::filter::kernel_1d<float>& kernel, const DstView& dst,
+                          const terry::filter::convolve_boundary_option option)
+{
+    using namespace terry::filter::detail;
+    correlate_rows_imp<PixelAccum>(src, kernel, dst, typename SrcView::point_t(0, 0), option,
+                                   correlator_n<PixelAccum>(kernel.size()));
+}
+
+template <typename Image>
+void benchmarkRowsCols(const std::size_t kernelSize)
+{
+    using namespace terry::filter;
+    typedef typename Image::view_t View;
+    typedef typename terry::floating_pixel_from_view<View>::type PixelAccum;
+
+    Image src(1024, 512);
+    fillRandom(terry::view(src), 1.f);
+    Image tmp(src.dimensions());
+    Image dst(src.dimensions());
+    const kernel_1d<float> kernel = makeKernel(kernelSize);
+
+    boost::posix_time::ptime t0(boost::posix_time::microsec_clock::local_time());
+    correlateRowsGeneric<PixelAccum>(terry::const_view(src), kernel, terry::view(tmp), convolve_option_extend_mirror);
+    correlateRowsGeneric<PixelAccum>(terry::transposed_view(terry::const_view(tmp)), kernel,
+                                     terry::transposed_view(terry::view(dst)), convolve_option_extend_mirror);
+    boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
+    correlate_rows_cols_auto<PixelAccum, std::allocator>(terry::const_view(src), kernel, kernel, terry::view(dst),
+                                                         typename View::point_t(0, 0), convolve_option_extend_mirror);
+    boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
+
+    std::cout << "  " << kernelSize << " taps: generic " << (t1 - t0).total_milliseconds() << " ms, vectorized "
+              << (t2 - t1).total_milliseconds() << " ms" << std::endl;
+}
+}
+
+void benchmarkConvolve()
+{
+    const std::size_t sizes[] = {3, 5, 9, 21, 51, 101, 201};
+    std::cout << "correlate_rows_cols_auto on rgba32f 1024x512:" << std::endl;
+    for(std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+        benchmarkRowsCols<terry::rgba32f_image_t>(sizes[i]);
+    std::cout << "correlate_rows_cols_auto on gray32f 1024x512:" << std::endl;
+    for(std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+        benchmarkRowsCols<terry::gray32f_image_t>(sizes[i]);
+}
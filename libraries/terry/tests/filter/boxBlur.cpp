@@ -0,0 +1,87 @@
+#include <terry/globals.hpp>
+#include <terry/filter/boxBlur.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/typedefs.hpp>
+
+#include <numeric>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(terry_filter_boxBlur)
+
+BOOST_AUTO_TEST_CASE(boxBlur_radius)
+{
+    using namespace terry::filter;
+
+    BOOST_CHECK(boxRadiusForGaussian(0).empty());
+
+    const double variances[] = {1, 4, 10, 100, 1000, 10000};
+    for(std::size_t i = 0; i < sizeof(variances) / sizeof(variances[0]); ++i)
+    {
+        const std::vector<std::size_t> radius = boxRadiusForGaussian(variances[i]);
+        double variance = 0;
+        for(std::size_t r = 0; r < radius.size(); ++r)
+        {
+            const double width = 2 * radius[r] + 1;
+            variance += (width * width - 1) / 12.0;
+        }
+        // odd widths: the variance can't be exact
+        BOOST_CHECK_CLOSE(variance, variances[i], 25.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(boxBlur_impulse)
+{
+    using namespace terry::filter;
+
+    // the impulse response is the box kernel, it has the variance of the gaussian
+    const double variance = 400;
+    const std::vector<std::size_t> radius = boxRadiusForGaussian(variance);
+    terry::gray32f_image_t src(301, 1);
+    terry::gray32f_image_t dst(301, 1);
+    terry::fill_pixels(terry::view(src), terry::gray32f_pixel_t(0));
+    terry::view(src)(150, 0) = terry::gray32f_pixel_t(1);
+
+    box_blur_rows<terry::gray32f_pixel_t>(terry::const_view(src), radius, terry::view(dst),
+                                          terry::point2<std::ptrdiff_t>(0, 0), convolve_option_extend_zero);
+
+    double sum = 0;
+    double moment = 0;
+    for(std::ptrdiff_t x = 0; x < 301; ++x)
+    {
+        const double v = terry::view(dst)(x, 0)[0];
+        BOOST_CHECK(v >= 0);
+        sum += v;
+        moment += v * (x - 150) * (x - 150);
+    }
+    BOOST_CHECK_CLOSE(sum, 1.0, 1e-3);
+    BOOST_CHECK_CLOSE(moment, variance, 10.0);
+}
+
+BOOST_AUTO_TEST_CASE(boxBlur_constant)
+{
+    using namespace terry::filter;
+
+    // a constant image stays constant, with tiles
+    const std::vector<std::size_t> radius = boxRadiusForGaussian(50);
+    terry::rgba32f_image_t src(64, 48);
+    terry::rgba32f_image_t dst(32, 16);
+    terry::fill_pixels(terry::view(src), terry::rgba32f_pixel_t(0.5f, 0.25f, 1.f, 1.f));
+
+    box_blur_rows_cols<terry::rgba32f_pixel_t, std::allocator>(terry::const_view(src), radius, radius,
+                                                               terry::view(dst), terry::point2<std::ptrdiff_t>(8, 16),
+                                                               convolve_option_extend_constant);
+
+    for(std::ptrdiff_t y = 0; y < dst.height(); ++y)
+    {
+        for(std::ptrdiff_t x = 0; x < dst.width(); ++x)
+        {
+            BOOST_CHECK_CLOSE(float(terry::view(dst)(x, y)[0]), 0.5f, 1e-3);
+            BOOST_CHECK_CLOSE(float(terry::view(dst)(x, y)[1]), 0.25f, 1e-3);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
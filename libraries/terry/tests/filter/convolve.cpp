@@ -0,0 +1,143 @@
+#include <terry/globals.hpp>
+#include <terry/filter/convolve.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/typedefs.hpp>
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace
+{
+
+const std::size_t kernelSizes[] = {3, 4, 5, 7, 9, 17, 31, 64, 101, 201};
+const std::size_t nbKernelSizes = sizeof(kernelSizes) / sizeof(kernelSizes[0]);
+
+terry::filter::kernel_1d<float> makeKernel(const std::size_t size)
+{
+    terry::filter::kernel_1d<float> kernel(size, size / 2);
+    float sum = 0;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        const float x = (float(i) - float(size / 2)) / (0.3f * size);
+        kernel[i] = std::exp(-x * x);
+        sum += kernel[i];
+    }
+    for(std::size_t i = 0; i < size; ++i)
+        kernel[i] /= sum;
+    return kernel;
+}
+
+template <typename View>
+void fillRandom(const View& view, const float maxValue)
+{
+    typedef typename terry::channel_type<View>::type Channel;
+    for(std::ptrdiff_t y = 0; y < view.height(); ++y)
+    {
+        typename View::x_iterator it = view.row_begin(y);
+        for(std::ptrdiff_t x = 0; x < view.width(); ++x, ++it)
+            for(int c = 0; c < terry::num_channels<View>::value; ++c)
+                (*it)[c] = Channel(maxValue * std::rand() / RAND_MAX);
+    }
+}
+
+template <typename View>
+float maxDifference(const View& a, const View& b)
+{
+    float diff = 0;
+    for(std::ptrdiff_t y = 0; y < a.height(); ++y)
+        for(std::ptrdiff_t x = 0; x < a.width(); ++x)
+            for(int c = 0; c < terry::num_channels<View>::value; ++c)
+                diff = std::max(diff, std::abs(float(a(x, y)[c]) - float(b(x, y)[c])));
+    return diff;
+}
+
+/// correlation of rows with the generic correlator, for reference
+template <typename PixelAccum, typename SrcView, typename DstView>
+void correlateRowsGeneric(const SrcView& src, const terry::filter::kernel_1d<float>& kernel, const DstView& dst,
+                          const terry::filter::convolve_boundary_option option)
+{
+    using namespace terry::filter::detail;
+    correlate_rows_imp<PixelAccum>(src, kernel, dst, typename SrcView::point_t(0, 0), option,
+                                   correlator_n<PixelAccum>(kernel.size()));
+}
+
+template <typename Image>
+void checkRowsCols(const float maxValue, const float tolerance)
+{
+    using namespace terry::filter;
+    typedef typename Image::view_t View;
+    typedef typename terry::floating_pixel_from_view<View>::type PixelAccum;
+
+    const convolve_boundary_option options[] = {convolve_option_output_zero, convolve_option_extend_zero,
+                                                convolve_option_extend_constant, convolve_option_extend_mirror};
+
+    Image src(97, 53);
+    fillRandom(terry::view(src), maxValue);
+    Image tmp(src.dimensions());
+    Image reference(src.dimensions());
+    Image result(src.dimensions());
+
+    for(std::size_t k = 0; k < nbKernelSizes; ++k)
+    {
+        const kernel_1d<float> kernel = makeKernel(kernelSizes[k]);
+        for(std::size_t o = 0; o < sizeof(options) / sizeof(options[0]); ++o)
+        {
+            correlateRowsGeneric<PixelAccum>(terry::const_view(src), kernel, terry::view(tmp), options[o]);
+            correlateRowsGeneric<PixelAccum>(terry::transposed_view(terry::const_view(tmp)), kernel,
+                                             terry::transposed_view(terry::view(reference)), options[o]);
+
+            correlate_rows_cols_auto<PixelAccum, std::allocator>(terry::const_view(src), kernel, kernel,
+                                                                 terry::view(result), typename View::point_t(0, 0),
+                                                                 options[o]);
+
+            BOOST_CHECK_MESSAGE(maxDifference(terry::view(reference), terry::view(result)) <= tolerance,
+                                "kernel size " << kernel.size() << ", boundary option " << options[o]);
+        }
+    }
+}
+}
+
+BOOST_AUTO_TEST_SUITE(terry_filter_convolve)
+
+BOOST_AUTO_TEST_CASE(correlate_floats_vectorized)
+{
+    using namespace terry::filter::detail;
+
+    std::vector<float> src(1024);
+    for(std::size_t i = 0; i < src.size(); ++i)
+        src[i] = float(std::rand()) / RAND_MAX;
+    const terry::filter::kernel_1d<float> kernel = makeKernel(31);
+
+    for(std::size_t step = 1; step <= 4; ++step)
+    {
+        const std::size_t size = src.size() - (kernel.size() - 1) * step;
+        std::vector<float> reference(size);
+        std::vector<float> result(size);
+        correlate_floats_scalar(&src.front(), 0, size, step, &kernel.front(), kernel.size(), &reference.front());
+        correlate_floats(&src.front(), size, step, &kernel.front(), kernel.size(), &result.front());
+        for(std::size_t i = 0; i < size; ++i)
+            BOOST_CHECK_CLOSE(reference[i], result[i], 1e-3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(correlate_rows_cols_float)
+{
+    checkRowsCols<terry::gray32f_image_t>(1.f, 1e-5f);
+    checkRowsCols<terry::rgb32f_image_t>(1.f, 1e-5f);
+    checkRowsCols<terry::rgba32f_image_t>(1.f, 1e-5f);
+}
+
+BOOST_AUTO_TEST_CASE(correlate_rows_cols_integer)
+{
+    // float accumulation, the rounding of the intermediate pass may differ of one
+    checkRowsCols<terry::gray8_image_t>(255.f, 1.f);
+    checkRowsCols<terry::rgba8_image_t>(255.f, 1.f);
+    checkRowsCols<terry::rgba16_image_t>(65535.f, 1.f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
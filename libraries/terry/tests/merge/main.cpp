@@ -0,0 +1,147 @@
+#include <terry/globals.hpp>
+#include <terry/merge/MergeFunctors.hpp>
+#include <terry/merge/ViewsMerging.hpp>
+
+#include <boost/gil/image.hpp>
+#include <boost/gil/typedefs.hpp>
+
+#include <cstdlib>
+
+#define BOOST_TEST_MODULE terry_merge_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace
+{
+
+typedef terry::rgba32f_pixel_t Pixel;
+
+/**
+ * @brief Random premultiplied pixels, with runs of transparent and opaque pixels.
+ * Without alpha, the transparent runs are null pixels (which are opaque black pixels).
+ */
+template <class View>
+void fill_layer(const View& view, const int seed)
+{
+    typedef typename View::value_type LayerPixel;
+    static const int nbChannels = terry::num_channels<LayerPixel>::value;
+    static const bool hasAlpha = terry::contains_color<LayerPixel, terry::alpha_t>::value;
+    // alpha is the last channel of the rgba layouts
+    static const int nbColors = hasAlpha ? nbChannels - 1 : nbChannels;
+
+    std::srand(seed);
+    for(std::ptrdiff_t y = 0; y < view.height(); ++y)
+    {
+        for(std::ptrdiff_t x = 0; x < view.width(); ++x)
+        {
+            const int run = ((x + seed * 7) / 13) % 3;
+            const float alpha = run == 0 ? 0.f : (run == 1 ? 1.f : 0.05f + 0.9f * std::rand() / float(RAND_MAX));
+            LayerPixel& p = view(x, y);
+            for(int c = 0; c < nbColors; ++c)
+                p[c] = alpha * std::rand() / float(RAND_MAX);
+            if(hasAlpha)
+                p[nbChannels - 1] = alpha;
+        }
+    }
+}
+
+/// reference: the functor evaluated on each pixel
+template <class View, class Functor>
+void merge_pixels(const View& A, const View& B, const View& dst, Functor fun)
+{
+    terry::detail::pixel_span_merger<typename Functor::operating_mode_t> merge_op;
+    for(std::ptrdiff_t y = 0; y < dst.height(); ++y)
+        merge_op(A.row_begin(y), B.row_begin(y), dst.row_begin(y), dst.width(), fun);
+}
+
+template <template <typename> class Functor, class Image>
+void check_functor(const char* name)
+{
+    typedef typename Image::view_t View;
+    typedef typename View::value_type LayerPixel;
+
+    Image A(101, 7);
+    Image B(101, 7);
+    Image ref(101, 7);
+    Image dst(101, 7);
+    fill_layer(terry::view(A), 1);
+    fill_layer(terry::view(B), 2);
+
+    merge_pixels(terry::view(A), terry::view(B), terry::view(ref), Functor<LayerPixel>());
+    View dstView = terry::view(dst);
+    terry::merge_views(terry::view(A), terry::view(B), dstView, Functor<LayerPixel>());
+
+    std::size_t nbErrors = 0;
+    for(std::ptrdiff_t y = 0; y < dst.height(); ++y)
+    {
+        for(std::ptrdiff_t x = 0; x < dst.width(); ++x)
+        {
+            for(int c = 0; c < terry::num_channels<LayerPixel>::value; ++c)
+            {
+                const float d = terry::view(dst)(x, y)[c];
+                const float r = terry::view(ref)(x, y)[c];
+                if(d != r && !(d != d && r != r)) // NaN of divisions by a null alpha
+                    ++nbErrors;
+            }
+        }
+    }
+    BOOST_CHECK_MESSAGE(nbErrors == 0, name << ": " << nbErrors << " different channels");
+}
+
+template <class Image>
+void check_functors()
+{
+    using namespace terry;
+
+    check_functor<FunctorATop, Image>("atop");
+    check_functor<FunctorConjointOver, Image>("conjoint over");
+    check_functor<FunctorIn, Image>("in");
+    check_functor<FunctorMask, Image>("mask");
+    check_functor<FunctorMatte, Image>("matte");
+    check_functor<FunctorOut, Image>("out");
+    check_functor<FunctorOver, Image>("over");
+    check_functor<FunctorStencil, Image>("stencil");
+    check_functor<FunctorUnder, Image>("under");
+    check_functor<FunctorXOR, Image>("xor");
+    check_functor<FunctorAverage, Image>("average");
+    check_functor<FunctorMultiply, Image>("multiply");
+    check_functor<FunctorScreen, Image>("screen");
+    check_functor<FunctorOverlay, Image>("overlay");
+    check_functor<FunctorLighten, Image>("lighten");
+}
+}
+
+BOOST_AUTO_TEST_SUITE(terry_merge_row_span)
+
+BOOST_AUTO_TEST_CASE(merge_row_span_same_results)
+{
+    // the batch merge gives exactly the results of the functors
+    check_functors<terry::rgba32f_image_t>();
+}
+
+BOOST_AUTO_TEST_CASE(merge_row_span_same_results_without_alpha)
+{
+    // null pixels are opaque without alpha
+    check_functors<terry::rgb32f_image_t>();
+    check_functors<terry::gray32f_image_t>();
+}
+
+BOOST_AUTO_TEST_CASE(merge_row_span_in_place)
+{
+    using namespace terry;
+
+    terry::rgba32f_image_t A(64, 4);
+    terry::rgba32f_image_t B(64, 4);
+    terry::rgba32f_image_t ref(64, 4);
+    fill_layer(terry::view(A), 3);
+    fill_layer(terry::view(B), 4);
+    merge_pixels(terry::view(A), terry::view(B), terry::view(ref), FunctorOver<Pixel>());
+
+    // dst is B
+    terry::rgba32f_view_t dstView = terry::view(B);
+    merge_views(terry::view(A), terry::view(B), dstView, FunctorOver<Pixel>());
+    for(std::ptrdiff_t x = 0; x < 64; ++x)
+        BOOST_CHECK(terry::view(B)(x, 2) == terry::view(ref)(x, 2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+#include <terry/globals.hpp>
+#include <terry/numeric/fast_pow.hpp>
+#include <terry/numeric/pixel_lut.hpp>
+
+#include <boost/gil/typedefs.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#define BOOST_TEST_MODULE terry_numeric_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace
+{
+
+/// reference pow on a channel, used to build the luts
+template <typename Pixel>
+struct pixel_gamma_t
+{
+    Pixel operator()(const Pixel& p) const
+    {
+        typedef typename terry::channel_type<Pixel>::type Channel;
+        const float maxValue = terry::channel_traits<Channel>::max_value();
+        Pixel result;
+        for(int c = 0; c < terry::num_channels<Pixel>::value; ++c)
+            result[c] = Channel(std::pow(p[c] / maxValue, 1.f / (1.f + c)) * maxValue + 0.5f);
+        return result;
+    }
+};
+}
+
+BOOST_AUTO_TEST_SUITE(terry_numeric_tests_suite01)
+
+BOOST_AUTO_TEST_CASE(fast_pow_error)
+{
+    using namespace terry::numeric;
+
+    const float exponents[] = {0.4545f, 2.2f, 1.f / 2.4f, 3.f};
+    for(std::size_t i = 0; i < 100000; ++i)
+    {
+        const float x = std::pow(10.f, -6.f + 9.f * std::rand() / RAND_MAX);
+        const float e = exponents[i % 4];
+        BOOST_CHECK_CLOSE(fast_pow(x, e), std::pow(x, e), 1e-3); // percents
+    }
+    // the other values are unchanged
+    BOOST_CHECK_EQUAL(fast_pow(0.f, 2.2f), 0.f);
+    BOOST_CHECK_EQUAL(fast_pow(-0.5f, 2.2f), -0.5f);
+    BOOST_CHECK_EQUAL(fast_pow(0.3f, 1.f), 0.3f);
+}
+
+BOOST_AUTO_TEST_CASE(pow_floats_channels)
+{
+    using namespace terry::numeric;
+
+    const float exponents[] = {0.4545f, 2.2f, 0.8f, 1.f};
+    std::vector<float> src(4 * 1001);
+    for(std::size_t i = 0; i < src.size(); ++i)
+        src[i] = (i % 13 == 0) ? -1.f : 4.f * std::rand() / RAND_MAX;
+
+    for(std::size_t nbChannels = 1; nbChannels <= 4; ++nbChannels)
+    {
+        const std::size_t size = nbChannels * 1001;
+        std::vector<float> dst(size);
+        pow_floats(&src.front(), size, exponents, nbChannels, &dst.front());
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            const float e = exponents[i % nbChannels];
+            if(src[i] > 0 && e != 1.f)
+                BOOST_CHECK_CLOSE(dst[i], std::pow(src[i], e), 1e-3);
+            else
+                BOOST_CHECK_EQUAL(dst[i], src[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pixel_lut_values)
+{
+    using namespace terry::numeric;
+
+    pixel_lut<terry::rgba8_pixel_t> lut8;
+    lut8.build(pixel_gamma_t<terry::rgba8_pixel_t>());
+    for(int v = 0; v < 256; ++v)
+    {
+        const terry::rgba8_pixel_t p(v, 255 - v, v / 2, 255);
+        BOOST_CHECK(lut8(p) == pixel_gamma_t<terry::rgba8_pixel_t>()(p));
+    }
+
+    pixel_lut<terry::gray16_pixel_t> lut16;
+    lut16.build(pixel_gamma_t<terry::gray16_pixel_t>());
+    for(int v = 0; v < 65536; v += 7)
+    {
+        const terry::gray16_pixel_t p(v);
+        BOOST_CHECK(lut16(p) == pixel_gamma_t<terry::gray16_pixel_t>()(p));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,84 @@
+#include <terry/globals.hpp>
+#include <terry/sampler/all.hpp>
+#include <terry/sampler/resample_separable.hpp>
+
+#include <boost/gil/image.hpp>
+
+#include <cmath>
+#include <iostream>
+
+#define BOOST_TEST_MODULE terry_sampler_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace
+{
+
+struct NoProgress
+{
+    void progressBegin(const int numSteps, const std::string& msg = "") {}
+    void progressEnd() {}
+    bool progressForward(const int nSteps) { return false; }
+};
+
+void fillPattern(const terry::rgba32f_view_t& view)
+{
+    for(std::ptrdiff_t y = 0; y < view.height(); ++y)
+    {
+        for(std::ptrdiff_t x = 0; x < view.width(); ++x)
+        {
+            view(x, y) = terry::rgba32f_pixel_t(std::sin(x * 0.7f) * 0.5f + 0.5f, (x + y) % 5 * 0.25f, y * 0.05f, 1.f);
+        }
+    }
+}
+
+/**
+ * @brief Compare the separable resampling with the generic 2D sampling.
+ */
+template <typename Sampler>
+void checkSeparable(const terry::sampler::EParamFilterOutOfImage outOfImageProcess)
+{
+    using namespace terry;
+
+    rgba32f_image_t src(41, 23);
+    fillPattern(view(src));
+    rgba32f_image_t dstGeneric(20, 11);
+    rgba32f_image_t dstSeparable(20, 11);
+    const Rect<std::ssize_t> procWindow(0, 0, 20, 11);
+    const matrix3x2<double> mat = matrix3x2<double>::get_scale(2.0, 2.0) * matrix3x2<double>::get_translate(0.5, 0.5);
+    NoProgress progress;
+
+    sampler::resample_pixels_progress<Sampler>(const_view(src), view(dstGeneric), mat, procWindow, outOfImageProcess,
+                                               progress);
+    sampler::resample_pixels_separable_progress<Sampler>(const_view(src), view(dstSeparable), mat, procWindow,
+                                                         outOfImageProcess, progress);
+
+    for(std::ptrdiff_t y = 0; y < 11; ++y)
+    {
+        for(std::ptrdiff_t x = 0; x < 20; ++x)
+        {
+            for(int c = 0; c < 4; ++c)
+            {
+                BOOST_CHECK_SMALL(view(dstGeneric)(x, y)[c] - view(dstSeparable)(x, y)[c], 1e-4f);
+            }
+        }
+    }
+}
+}
+
+BOOST_AUTO_TEST_SUITE(terry_sampler_tests_suite01)
+
+BOOST_AUTO_TEST_CASE(separable_bilinear)
+{
+    checkSeparable<terry::sampler::bilinear_sampler>(terry::sampler::eParamFilterOutBlack);
+    checkSeparable<terry::sampler::bilinear_sampler>(terry::sampler::eParamFilterOutCopy);
+}
+
+BOOST_AUTO_TEST_CASE(separable_lanczos3)
+{
+    checkSeparable<terry::sampler::lanczos3_sampler>(terry::sampler::eParamFilterOutBlack);
+    checkSeparable<terry::sampler::lanczos3_sampler>(terry::sampler::eParamFilterOutTransparency);
+    checkSeparable<terry::sampler::lanczos3_sampler>(terry::sampler::eParamFilterOutCopy);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,15 @@
+from pyTuttle import tuttle
+
+
+def createBlurredCheckerboard(g, blurSize=None):
+	"""
+	Create and connect the checkerboard -> blur -> invert nodes used by the compute tests.
+
+	@param blurSize: size of the blur, a value per time (like {0.0: [.01, .01], 9.0: [.1, .1]}) animates it.
+	@return the nodes, the last one is the output of the graph.
+	"""
+	checkerboard = g.createNode( "tuttle.checkerboard", format="PAL" )
+	blur = g.createNode( "tuttle.blur", size=(blurSize if blurSize is not None else [.05, .05]) )
+	invert = g.createNode( "tuttle.invert" )
+	g.connect( [checkerboard, blur, invert] )
+	return [checkerboard, blur, invert]
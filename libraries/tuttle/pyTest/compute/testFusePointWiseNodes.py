@@ -0,0 +1,32 @@
+from pyTuttle import tuttle
+from nose.tools import *
+import numpy
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def computeColorChain(fusePointWiseNodes):
+	g = tuttle.Graph()
+	checkerboard = g.createNode( "tuttle.checkerboard", format="PAL", explicitConversion="32f" )
+	gamma = g.createNode( "tuttle.gamma", master=.5 )
+	invert = g.createNode( "tuttle.invert" )
+	normalize = g.createNode( "tuttle.normalize", mode="custom", srcColorMax=[.5, .5, .5, 1] )
+	g.connect( [checkerboard, gamma, invert, normalize] )
+
+	options = tuttle.ComputeOptions(0)
+	options.setFusePointWiseNodes(fusePointWiseNodes)
+
+	outputCache = tuttle.MemoryCache()
+	assert g.compute( outputCache, normalize, options )
+	assert_equal( outputCache.size(), 1 )
+	return outputCache.get(0).getNumpyArray()
+
+
+def testFusePointWiseNodes():
+	# the chain of color nodes rendered in a single buffer gives the same image
+	reference = computeColorChain(False)
+	result = computeColorChain(True)
+	assert_equal( reference.shape, result.shape )
+	assert numpy.array_equal( reference, result )
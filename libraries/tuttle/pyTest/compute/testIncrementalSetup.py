@@ -0,0 +1,50 @@
+from pyTuttle import tuttle
+from nose.tools import *
+import numpy
+
+from .graphs import createBlurredCheckerboard
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def computeFrames(incrementalSetup, nbFrames, blurSize=None):
+	g = tuttle.Graph()
+	invert = createBlurredCheckerboard( g, blurSize )[-1]
+
+	options = tuttle.ComputeOptions(0, nbFrames - 1)
+	options.setIncrementalSetup(incrementalSetup)
+
+	outputCache = tuttle.MemoryCache()
+	assert g.compute( outputCache, invert, options )
+	return outputCache
+
+
+def assertSameFrames(nbFrames, blurSize=None):
+	fullCache = computeFrames(False, nbFrames, blurSize)
+	incrementalCache = computeFrames(True, nbFrames, blurSize)
+
+	assert_equal( fullCache.size(), nbFrames )
+	assert_equal( incrementalCache.size(), nbFrames )
+	for frame in range(0, nbFrames):
+		# the frames rendered with the incremental setup are the same images
+		fullImg = fullCache.get(frame).getNumpyArray()
+		incrementalImg = incrementalCache.get(frame).getNumpyArray()
+		assert_equal( fullImg.shape, incrementalImg.shape )
+		assert numpy.array_equal( fullImg, incrementalImg )
+	return fullCache
+
+
+def testIncrementalSetup():
+	assertSameFrames(20)
+
+
+def testIncrementalSetupAnimated():
+	"""
+	The blur size changes at each frame, so the blur and the nodes using its output
+	compute their RoD and RoI again on the reused graph.
+	"""
+	nbFrames = 10
+	fullCache = assertSameFrames(nbFrames, {0.0: [.01, .01], float(nbFrames - 1): [.1, .1]})
+	assert not numpy.array_equal( fullCache.get(0).getNumpyArray(), fullCache.get(nbFrames - 1).getNumpyArray() )
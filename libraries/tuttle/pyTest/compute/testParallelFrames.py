@@ -0,0 +1,47 @@
+from pyTuttle import tuttle
+from nose.tools import *
+import numpy
+import time
+
+from .graphs import createBlurredCheckerboard
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def computeFrames(nbParallelFrames, nbFrames):
+	g = tuttle.Graph()
+	# the blur is animated, so each frame is a different image
+	invert = createBlurredCheckerboard( g, blurSize={0.0: [.01, .01], float(nbFrames - 1): [.1, .1]} )[-1]
+
+	options = tuttle.ComputeOptions(0, nbFrames - 1)
+	options.setNbParallelFrames(nbParallelFrames)
+
+	outputCache = tuttle.MemoryCache()
+	time0 = time.time()
+	assert g.compute( outputCache, invert, options )
+	time1 = time.time()
+	return outputCache, time1 - time0
+
+
+def testParallelFrames():
+	nbFrames = 8
+	sequentialCache, sequentialDuration = computeFrames(1, nbFrames)
+	parallelCache, parallelDuration = computeFrames(4, nbFrames)
+
+	assert_equal( sequentialCache.size(), nbFrames )
+	assert_equal( parallelCache.size(), nbFrames )
+	for frame in range(0, nbFrames):
+		# each frame rendered in parallel is the image of the same frame rendered sequentially
+		sequentialImg = sequentialCache.get(frame).getNumpyArray()
+		parallelImg = parallelCache.get(frame).getNumpyArray()
+		assert_equal( sequentialImg.shape, parallelImg.shape )
+		assert numpy.array_equal( sequentialImg, parallelImg )
+	assert not numpy.array_equal( sequentialCache.get(0).getNumpyArray(),
+	                              sequentialCache.get(nbFrames - 1).getNumpyArray() )
+
+	print("_"*10)
+	print("sequential duration:", sequentialDuration)
+	print("parallel duration:", parallelDuration)
+	print("_"*10)
@@ -0,0 +1,144 @@
+from pyTuttle import tuttle
+from nose.tools import *
+import time
+import os
+import shutil
+import tempfile
+import numpy
+
+from .graphs import createBlurredCheckerboard
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def computeFrames(nbFrames, invertRed):
+	"""
+	Render without the render cache, as a reference.
+	"""
+	g = tuttle.Graph()
+	invert = createBlurredCheckerboard(g)[-1]
+	invert.getParam("r").setValue(invertRed)
+
+	outputCache = tuttle.MemoryCache()
+	assert g.compute( outputCache, invert, tuttle.ComputeOptions(0, nbFrames - 1) )
+	return outputCache
+
+
+def assertSameFrames(cacheA, cacheB, nbFrames):
+	assert_equal( cacheA.size(), nbFrames )
+	assert_equal( cacheB.size(), nbFrames )
+	for frame in range(0, nbFrames):
+		imgA = cacheA.get(frame).getNumpyArray()
+		imgB = cacheB.get(frame).getNumpyArray()
+		assert_equal( imgA.shape, imgB.shape )
+		assert numpy.array_equal( imgA, imgB )
+
+
+def testRenderCache():
+	nbFrames = 10
+	g = tuttle.Graph()
+	invert = createBlurredCheckerboard(g)[-1]
+
+	options = tuttle.ComputeOptions(0, nbFrames - 1)
+	options.setRenderCache()
+
+	firstCache = tuttle.MemoryCache()
+	time0 = time.time()
+	assert g.compute( firstCache, invert, options )
+	time1 = time.time()
+
+	# only the last node needs to be computed again
+	invert.getParam("r").setValue(False)
+	secondCache = tuttle.MemoryCache()
+	assert g.compute( secondCache, invert, options )
+	time2 = time.time()
+
+	# the renders using the cached outputs give the images of the renders without cache
+	assertSameFrames( firstCache, computeFrames(nbFrames, True), nbFrames )
+	assertSameFrames( secondCache, computeFrames(nbFrames, False), nbFrames )
+	# the modified node is not taken from the cache
+	for frame in range(0, nbFrames):
+		assert not numpy.array_equal( firstCache.get(frame).getNumpyArray(), secondCache.get(frame).getNumpyArray() )
+
+	print("_"*10)
+	print("first compute duration:", time1 - time0)
+	print("compute with cached inputs duration:", time2 - time1)
+	print("_"*10)
+
+
+def computeWithDiskCache(cachePath, nbFrames):
+	g = tuttle.Graph()
+	invert = createBlurredCheckerboard(g)[-1]
+
+	options = tuttle.ComputeOptions(0, nbFrames - 1)
+	options.setRenderDiskCachePath(cachePath)
+
+	outputCache = tuttle.MemoryCache()
+	time0 = time.time()
+	assert g.compute( outputCache, invert, options )
+	time1 = time.time()
+	return outputCache, time1 - time0
+
+
+def testRenderDiskCache():
+	nbFrames = 4
+	cachePath = tempfile.mkdtemp()
+	try:
+		firstCache, firstDuration = computeWithDiskCache(cachePath, nbFrames)
+		cachedFiles = [f for _, _, files in os.walk(cachePath) for f in files if f.endswith(".raw")]
+		assert len(cachedFiles) > 0
+
+		# a new graph with the same nodes reuses the outputs stored on disk
+		secondCache, secondDuration = computeWithDiskCache(cachePath, nbFrames)
+
+		assertSameFrames( firstCache, secondCache, nbFrames )
+
+		print("_"*10)
+		print("compute duration:", firstDuration)
+		print("compute from the disk cache duration:", secondDuration)
+		print("_"*10)
+	finally:
+		shutil.rmtree(cachePath)
+
+
+def writeImage(filename, generator):
+	g = tuttle.Graph()
+	write = g.createNode( "tuttle.pngwriter", filename=filename )
+	g.connect( [generator(g), write] )
+	g.compute( write )
+
+
+def readWithDiskCache(filename, cachePath):
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.pngreader", filename=filename )
+	invert = g.createNode( "tuttle.invert" )
+	g.connect( [read, invert] )
+
+	options = tuttle.ComputeOptions(0)
+	options.setRenderDiskCachePath(cachePath)
+
+	outputCache = tuttle.MemoryCache()
+	assert g.compute( outputCache, invert, options )
+	return outputCache.get(0).getNumpyArray()
+
+
+def testRenderDiskCacheModifiedFile():
+	cachePath = tempfile.mkdtemp()
+	imagePath = tempfile.mkdtemp()
+	try:
+		filename = os.path.join(imagePath, "input.png")
+		writeImage(filename, lambda g: g.createNode( "tuttle.checkerboard", size=[64, 64] ))
+		first = readWithDiskCache(filename, cachePath)
+		assert numpy.array_equal( first, readWithDiskCache(filename, cachePath) )
+
+		# another image written at the same path is not taken from the disk cache
+		writeImage(filename, lambda g: g.createNode( "tuttle.constant", size=[64, 64], color=[.5, .5, .5, 1] ))
+		fileStat = os.stat(filename)
+		os.utime(filename, (fileStat.st_atime, fileStat.st_mtime + 10))
+		second = readWithDiskCache(filename, cachePath)
+		assert not numpy.array_equal( first, second )
+	finally:
+		shutil.rmtree(cachePath)
+		shutil.rmtree(imagePath)
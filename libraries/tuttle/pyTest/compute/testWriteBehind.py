@@ -0,0 +1,117 @@
+from pyTuttle import tuttle
+from nose.tools import *
+import os
+import shutil
+import tempfile
+import numpy
+
+from .graphs import createBlurredCheckerboard
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def writeFrames(outputPath, nbWriteBehindFrames, nbFrames, continueOnError=False):
+	g = tuttle.Graph()
+	invert = createBlurredCheckerboard( g )[-1]
+	write = g.createNode( "tuttle.pngwriter", filename=os.path.join(outputPath, "output_####.png") )
+	g.connect( invert, write )
+
+	options = tuttle.ComputeOptions(0, nbFrames - 1)
+	options.setNbWriteBehindFrames(nbWriteBehindFrames)
+	options.setContinueOnError(continueOnError)
+	return g.compute( write, options )
+
+
+def readFrames(filename, frames):
+	images = []
+	for frame in frames:
+		g = tuttle.Graph()
+		read = g.createNode( "tuttle.pngreader", filename=filename )
+		outputCache = tuttle.MemoryCache()
+		assert g.compute( outputCache, read, tuttle.ComputeOptions(frame) )
+		images.append( outputCache.get(frame).getNumpyArray() )
+	return images
+
+
+def assertSameFrames(filenameA, filenameB, frames):
+	for imgA, imgB in zip(readFrames(filenameA, frames), readFrames(filenameB, frames)):
+		assert numpy.array_equal( imgA, imgB )
+
+
+def testWriteBehind():
+	nbFrames = 8
+	outputPath = tempfile.mkdtemp()
+	try:
+		directPath = os.path.join(outputPath, "direct")
+		behindPath = os.path.join(outputPath, "behind")
+		os.mkdir(directPath)
+		os.mkdir(behindPath)
+		assert writeFrames(directPath, 0, nbFrames)
+		assert writeFrames(behindPath, 3, nbFrames)
+
+		assertSameFrames( os.path.join(directPath, "output_####.png"),
+		                  os.path.join(behindPath, "output_####.png"),
+		                  range(0, nbFrames) )
+	finally:
+		shutil.rmtree(outputPath)
+
+
+def writeChainedFrames(inputFilename, outputPath, nbWriteBehindFrames, nbFrames):
+	g = tuttle.Graph()
+	read = g.createNode( "tuttle.pngreader", filename=inputFilename )
+	copyWrite = g.createNode( "tuttle.pngwriter", filename=os.path.join(outputPath, "copy_####.png"), copyToOutput=True )
+	blur = g.createNode( "tuttle.blur", size=[.05, .05] )
+	write = g.createNode( "tuttle.pngwriter", filename=os.path.join(outputPath, "output_####.png") )
+	g.connect( [read, copyWrite, blur, write] )
+
+	options = tuttle.ComputeOptions(0, nbFrames - 1)
+	options.setNbWriteBehindFrames(nbWriteBehindFrames)
+	assert g.compute( write, options )
+
+
+def testWriteBehindChainedWriter():
+	"""
+	A writer which copies its input to its output is processed before the nodes using its output,
+	only the last writer is written in background.
+	"""
+	nbFrames = 6
+	outputPath = tempfile.mkdtemp()
+	try:
+		inputPath = os.path.join(outputPath, "input")
+		directPath = os.path.join(outputPath, "direct")
+		behindPath = os.path.join(outputPath, "behind")
+		for path in [inputPath, directPath, behindPath]:
+			os.mkdir(path)
+		inputFilename = os.path.join(inputPath, "output_####.png")
+		assert writeFrames(inputPath, 0, nbFrames)
+
+		writeChainedFrames(inputFilename, directPath, 0, nbFrames)
+		writeChainedFrames(inputFilename, behindPath, 2, nbFrames)
+
+		frames = range(0, nbFrames)
+		assertSameFrames( inputFilename, os.path.join(behindPath, "copy_####.png"), frames )
+		assertSameFrames( os.path.join(directPath, "copy_####.png"), os.path.join(behindPath, "copy_####.png"), frames )
+		assertSameFrames( os.path.join(directPath, "output_####.png"), os.path.join(behindPath, "output_####.png"), frames )
+	finally:
+		shutil.rmtree(outputPath)
+
+
+def testWriteBehindError():
+	nbFrames = 6
+	failingFrame = 2
+	outputPath = tempfile.mkdtemp()
+	try:
+		# a directory prevents the write of a frame
+		os.mkdir(os.path.join(outputPath, "output_%04d.png" % failingFrame))
+
+		assert_raises( Exception, writeFrames, outputPath, 2, nbFrames )
+
+		# the other frames are written
+		assert writeFrames(outputPath, 2, nbFrames, continueOnError=True)
+		for frame in range(0, nbFrames):
+			if frame != failingFrame:
+				assert os.path.isfile(os.path.join(outputPath, "output_%04d.png" % frame))
+	finally:
+		shutil.rmtree(outputPath)
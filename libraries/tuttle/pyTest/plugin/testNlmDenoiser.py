@@ -0,0 +1,49 @@
+from pyTuttle import tuttle
+from nose.tools import *
+import numpy
+
+
+def setUp():
+	tuttle.core().preload(False)
+
+
+def noisyImage(height, width):
+	"""
+	A gradient with a deterministic noise, as a rgba 8 bits buffer.
+	"""
+	random = numpy.random.RandomState(0)
+	gradient = numpy.linspace(0, 192, width)[numpy.newaxis, :, numpy.newaxis]
+	noise = random.normal(0, 16, (height, width, 4))
+	img = numpy.clip(gradient + noise + 32, 0, 255).astype(numpy.uint8)
+	img[:, :, 3] = 255
+	return img
+
+
+def denoise(img, optimization):
+	g = tuttle.Graph()
+	ib = g.createInputBuffer()
+	ib.set3DArrayBuffer( img )
+	nlm = g.createNode( "tuttle.nlmdenoiser", optimization=optimization )
+	g.connect( ib.getNode(), nlm )
+
+	outputCache = tuttle.MemoryCache()
+	assert g.compute( outputCache, nlm, tuttle.ComputeOptions(0) )
+	return outputCache.get(0).getNumpyArray().astype(numpy.int32)
+
+
+def testNlmDenoiserOptimization():
+	"""
+	The optimized rendering (integral images, by bands of rows) and the sliding window (by tiles)
+	compute the same weights, up to the order of the float sums.
+	Both clip the patches to the pixels inside the frame, so the borders are compared too.
+	The image is taller than a band and than a tile.
+	"""
+	img = noisyImage(200, 96)
+	optimized = denoise(img, True)
+	slidingWindow = denoise(img, False)
+
+	assert_equal( optimized.shape, slidingWindow.shape )
+	# the noise is filtered
+	assert not numpy.array_equal( optimized, img.astype(numpy.int32) )
+	# rounding to 8 bits of values computed in a different order
+	assert_less_equal( numpy.abs(optimized - slidingWindow).max(), 1 )
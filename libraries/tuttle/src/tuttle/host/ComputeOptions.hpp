@@ -12,6 +12,7 @@
 
 #include <limits>
 #include <list>
+#include <string>
 
 namespace tuttle
 {
@@ -109,6 +110,13 @@ public:
         _forceIdentityNodesProcess = other._forceIdentityNodesProcess;
         _returnBuffers = other._returnBuffers;
         _isInteractive = other._isInteractive;
+        _nbParallelFrames = other._nbParallelFrames;
+        _nbWriteBehindFrames = other._nbWriteBehindFrames;
+        _incrementalSetup = other._incrementalSetup;
+        _renderCache = other._renderCache;
+        _renderDiskCachePath = other._renderDiskCachePath;
+        _fusePointWiseNodes = other._fusePointWiseNodes;
+        _memoryHighWaterMark = other._memoryHighWaterMark;
 
         // don't modify the abort status?
         //_abort.store( false, boost::memory_order_relaxed );
@@ -126,6 +134,12 @@ private:
         setColorEnable(false);
         setIsInteractive(false);
         setForceIdentityNodesProcess(false);
+        setNbParallelFrames(1);
+        setNbWriteBehindFrames(0);
+        setIncrementalSetup(false);
+        setRenderCache(false);
+        setFusePointWiseNodes(true);
+        setMemoryHighWaterMark(0);
     }
 
 public:
@@ -242,6 +256,93 @@ public:
     }
     bool getForceIdentityNodesProcess() const { return _forceIdentityNodesProcess; }
 
+    /**
+     * @brief Number of frames rendered at the same time.
+     * 1 renders frame by frame (default), 0 uses the number of hardware threads.
+     * The effective number may be lower to respect the MemoryPool budget,
+     * and it falls back to 1 if a node requires a sequential render.
+     */
+    This& setNbParallelFrames(const std::size_t v)
+    {
+        _nbParallelFrames = v;
+        return *this;
+    }
+    std::size_t getNbParallelFrames() const { return _nbParallelFrames; }
+
+    /**
+     * @brief Maximal number of frames written in background by the writer nodes,
+     * while the next frames are computed. Each pending frame keeps its input images in memory.
+     * 0 writes each frame during its render (default).
+     * The errors of the writes are managed like the errors of the render, in the frames order.
+     */
+    This& setNbWriteBehindFrames(const std::size_t v)
+    {
+        _nbWriteBehindFrames = v;
+        return *this;
+    }
+    std::size_t getNbWriteBehindFrames() const { return _nbWriteBehindFrames; }
+
+    /**
+     * @brief Reuse the graph at time of the previous frame when the time dependencies
+     * of the nodes are the same relatively to the frame.
+     * The graph is not rebuilt, only the nodes with other parameters at the new frame
+     * compute their RoD and RoI again. It is rebuilt when the identity nodes change.
+     */
+    This& setIncrementalSetup(const bool v = true)
+    {
+        _incrementalSetup = v;
+        return *this;
+    }
+    bool getIncrementalSetup() const { return _incrementalSetup; }
+
+    /**
+     * @brief Keep the node outputs in the internal MemoryCache between frames and computes,
+     * and reuse them when a node has the same hash (same parameters, same inputs).
+     * Unused outputs are released the least recently used first, only when the MemoryPool needs memory.
+     */
+    This& setRenderCache(const bool v = true)
+    {
+        _renderCache = v;
+        return *this;
+    }
+    bool getRenderCache() const { return _renderCache; }
+
+    /**
+     * @brief Directory of a persistent cache of the node outputs, shared between computes and processes.
+     * The outputs are stored keyed by the node hash, like the render cache in memory,
+     * and mapped back without decoding. An empty path disables the disk cache (default).
+     */
+    This& setRenderDiskCachePath(const std::string& path)
+    {
+        _renderDiskCachePath = path;
+        return *this;
+    }
+    const std::string& getRenderDiskCachePath() const { return _renderDiskCachePath; }
+
+    /**
+     * @brief Render the chains of point-wise nodes (like color corrections) in a single image buffer,
+     * when the intermediate images are not used elsewhere. Enabled by default,
+     * disable it to keep an image per node (e.g. for debug purposes).
+     */
+    This& setFusePointWiseNodes(const bool v = true)
+    {
+        _fusePointWiseNodes = v;
+        return *this;
+    }
+    bool getFusePointWiseNodes() const { return _fusePointWiseNodes; }
+
+    /**
+     * @brief During the compute, give the unused buffers of the MemoryPool back to the system,
+     * least recently used first, each time the allocated memory exceeds @p bytes (checked every second).
+     * 0 keeps the unused buffers until the MemoryPool needs memory (default).
+     */
+    This& setMemoryHighWaterMark(const std::size_t bytes)
+    {
+        _memoryHighWaterMark = bytes;
+        return *this;
+    }
+    std::size_t getMemoryHighWaterMark() const { return _memoryHighWaterMark; }
+
     /**
      * @brief The application would like to abort the process (from another thread).
      */
@@ -300,6 +401,13 @@ private:
     bool _forceIdentityNodesProcess;
     bool _returnBuffers;
     bool _isInteractive;
+    std::size_t _nbParallelFrames;
+    std::size_t _nbWriteBehindFrames;
+    bool _incrementalSetup;
+    bool _renderCache;
+    std::string _renderDiskCachePath;
+    bool _fusePointWiseNodes;
+    std::size_t _memoryHighWaterMark;
 
     boost::atomic_bool _abort;
 
@@ -3,6 +3,7 @@
 
 #include "version.hpp"
 #include "Preferences.hpp"
+#include "ThreadPool.hpp"
 
 #include <tuttle/host/memory/IMemoryCache.hpp>
 #include <tuttle/host/HostDescriptor.hpp>
@@ -40,6 +41,7 @@ private:
     boost::shared_ptr<tuttle::common::Formatter> _formatter;
 
     Preferences _preferences;
+    ThreadPool _threadPool;
 
 public:
     ofx::OfxhPluginCache& getPluginCache() { return _pluginCache; }
@@ -62,6 +64,11 @@ public:
     memory::IMemoryCache& getMemoryCache() { return _memoryCache; }
     const memory::IMemoryCache& getMemoryCache() const { return _memoryCache; }
 
+#ifndef SWIG
+    /// threads used by the plugins through the OFX multithread suite
+    ThreadPool& getThreadPool() { return _threadPool; }
+#endif
+
 public:
     ofx::imageEffect::OfxhImageEffectPlugin* getImageEffectPluginById(const std::string& id, int vermaj = -1,
                                                                       int vermin = -1)
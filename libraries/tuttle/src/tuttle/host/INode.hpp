@@ -8,6 +8,9 @@
 #include <tuttle/host/Callback.hpp>
 
 #include <boost/noncopyable.hpp>
+#ifndef SWIG
+#include <boost/thread/mutex.hpp>
+#endif
 
 #include <iostream>
 #include <string>
@@ -130,6 +133,12 @@ public:
 
     virtual std::size_t getLocalHashAtTime(const OfxTime time) const = 0;
 
+    /**
+     * @brief The local hash identifies the output of the node between processes.
+     * It is false if the output depends on files which are not identified by the hash.
+     */
+    virtual bool isLocalHashPersistentAtTime(const OfxTime time) const = 0;
+
 #ifndef SWIG
     virtual void connect(const INode&, attribute::Attribute&) = 0;
 
@@ -241,11 +250,13 @@ public:
 protected:
     Data* _data;               ///< link to external datas
     DataAtTimeMap _dataAtTime; ///< link to external datas at each time
+    mutable boost::mutex _dataAtTimeMutex; ///< frames rendered in parallel share the same node
 
 public:
     void setProcessData(Data* data);
     void setProcessDataAtTime(DataAtTime* dataAtTime);
     void clearProcessDataAtTime();
+    void clearProcessDataAtTime(const OfxTime time);
 
     Data& getData();
     const Data& getData() const;
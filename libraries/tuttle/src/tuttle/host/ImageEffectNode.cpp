@@ -8,6 +8,7 @@
 #include <tuttle/host/graph/ProcessEdgeAtTime.hpp>
 #include <tuttle/host/graph/ProcessVertexData.hpp>
 #include <tuttle/host/graph/ProcessVertexAtTimeData.hpp>
+#include <tuttle/host/diskCache/RenderDiskCache.hpp>
 
 #include <tuttle/host/ofx/OfxhUtilities.hpp>
 #include <tuttle/host/ofx/OfxhBinary.hpp>
@@ -26,6 +27,7 @@
 #include <ofxImageEffect.h>
 
 #include <boost/functional/hash.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 
@@ -33,12 +35,57 @@
 #include <iostream>
 #include <fstream>
 #include <list>
+#include <limits>
 
 namespace tuttle
 {
 namespace host
 {
 
+namespace
+{
+/// Shared by all instances of plugins declared as kOfxImageEffectRenderUnsafe.
+boost::mutex gRenderUnsafeMutex;
+
+/**
+ * @brief Get the value of the "filename" parameter of a reader node.
+ * @return false if @p node is not a reader
+ */
+bool getReadFilename(const ImageEffectNode& node, const OfxTime time, std::string& filename)
+{
+    if(node.getContext() != kOfxImageEffectContextReader)
+        return false;
+    const ofx::attribute::OfxhParamSet::ParamMap& params = node.getParamSet().getParamsByName();
+    const ofx::attribute::OfxhParamSet::ParamMap::const_iterator it = params.find("filename");
+    if(it == params.end())
+        return false;
+    filename = it->second->getStringValueAtTime(time);
+    return true;
+}
+
+/**
+ * @brief Add the identity of the file @p filename (absolute path, size and last write time) to @p seed.
+ * @return false if @p filename is not an existing file, like the pattern of a sequence.
+ */
+bool hashFileIdentity(std::size_t& seed, const std::string& filename)
+{
+    boost::system::error_code error;
+    const boost::filesystem::path filepath = boost::filesystem::absolute(filename);
+    if(!boost::filesystem::is_regular_file(filepath, error))
+        return false;
+    const boost::uintmax_t fileSize = boost::filesystem::file_size(filepath, error);
+    if(error)
+        return false;
+    const std::time_t lastWriteTime = boost::filesystem::last_write_time(filepath, error);
+    if(error)
+        return false;
+    boost::hash_combine(seed, filepath.string());
+    boost::hash_combine(seed, fileSize);
+    boost::hash_combine(seed, lastWriteTime);
+    return true;
+}
+}
+
 ImageEffectNode::ImageEffectNode(tuttle::host::ofx::imageEffect::OfxhImageEffectPlugin& plugin,
                                  tuttle::host::ofx::imageEffect::OfxhImageEffectNodeDescriptor& desc,
                                  const std::string& context)
@@ -136,9 +183,23 @@ std::size_t ImageEffectNode::getLocalHashAtTime(const OfxTime time) const
 
     boost::hash_combine(seed, getParamSet().getHashAtTime(time));
 
+    // the output of a reader changes with the content of its file
+    std::string filename;
+    if(getReadFilename(*this, time, filename))
+        hashFileIdentity(seed, filename);
+
     return seed;
 }
 
+bool ImageEffectNode::isLocalHashPersistentAtTime(const OfxTime time) const
+{
+    std::string filename;
+    if(!getReadFilename(*this, time, filename))
+        return true;
+    std::size_t seed = 0;
+    return hashFileIdentity(seed, filename);
+}
+
 /**
  * @return 1 to abort processing
  */
@@ -780,7 +841,18 @@ void ImageEffectNode::preProcess1(graph::ProcessVertexAtTimeData& vData)
     //	TUTTLE_LOG_VAR( TUTTLE_INFO, &getData(vData._time) );
     //	TUTTLE_LOG_VAR( TUTTLE_INFO, &vData );
     vData._apiImageEffect._renderRoD = rod;
-    vData._apiImageEffect._renderRoI = rod; ///< @todo tuttle: tile supports
+    // The final nodes are computed entirely, the other ones only on the union
+    // of the RoI requested by their outputs (filled during preProcess2_reverse).
+    if(vData._isFinalNode)
+    {
+        vData._apiImageEffect._renderRoI = rod;
+    }
+    else
+    {
+        const OfxRectD emptyRoI = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                                   -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max()};
+        vData._apiImageEffect._renderRoI = emptyRoI;
+    }
 
     TUTTLE_LOG_INFO("[Pre Process 1] rod: x1:" << rod.x1 << " y1:" << rod.y1 << " x2:" << rod.x2 << " y2:" << rod.y2);
 }
@@ -789,8 +861,50 @@ void ImageEffectNode::preProcess2_reverse(graph::ProcessVertexAtTimeData& vData)
 {
     //	TUTTLE_LOG_INFO( "preProcess2_finish: " << getName() << " at time: " << vData._time );
 
-    getRegionOfInterestAction(vData._time, vData._nodeData->_renderScale, vData._apiImageEffect._renderRoI,
-                              vData._apiImageEffect._inputsRoI);
+    // All the outputs of this node have already been preprocessed,
+    // so the RoI is the union of the regions they need.
+    OfxRectD& renderRoI = vData._apiImageEffect._renderRoI;
+    const OfxRectD& rod = vData._apiImageEffect._renderRoD;
+    if(!supportsTiles() || ofx::isEmpty(renderRoI))
+    {
+        // no tile support or no output has asked for a region
+        renderRoI = rod;
+    }
+    else
+    {
+        renderRoI = ofx::clamp(renderRoI, rod);
+    }
+    TUTTLE_LOG_INFO("[Pre Process 2] " << getName() << " at time: " << vData._time << ", roi: " << renderRoI);
+
+    getRegionOfInterestAction(vData._time, vData._nodeData->_renderScale, renderRoI, vData._apiImageEffect._inputsRoI);
+
+    // Accumulate the RoI needed on each input node.
+    BOOST_FOREACH(const graph::ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdgePair,
+                  vData._inEdges)
+    {
+        const graph::ProcessEdgeAtTime* inEdge = inEdgePair.second;
+        attribute::ClipImage& clip = getClip(inEdge->getInAttrName());
+        if(!clip.isConnected())
+            continue;
+
+        graph::ProcessVertexAtTimeData::ImageEffect::MapClipImageRod::const_iterator itRoI =
+            vData._apiImageEffect._inputsRoI.find(&clip);
+        graph::ProcessVertexAtTimeData& inputData = clip.getConnectedClip().getNode().getData(inEdge->getOutTime());
+        OfxRectD& inputRoI = inputData._apiImageEffect._renderRoI;
+        if(itRoI == vData._apiImageEffect._inputsRoI.end())
+        {
+            // the plugin doesn't give any information, so we need the whole image
+            inputRoI = inputData._apiImageEffect._renderRoD;
+        }
+        else if(ofx::isEmpty(inputRoI))
+        {
+            inputRoI = itRoI->second;
+        }
+        else
+        {
+            inputRoI = ofx::rectUnion(inputRoI, itRoI->second);
+        }
+    }
     //	TUTTLE_LOG_VAR( TUTTLE_INFO, vData._renderRoD );
     //	TUTTLE_LOG_VAR( TUTTLE_INFO, vData._renderRoI );
 }
@@ -813,10 +927,11 @@ void ImageEffectNode::preProcess_infos(const graph::ProcessVertexAtTimeData& vDa
                                        graph::ProcessVertexAtTimeInfo& nodeInfos) const
 {
     //	TUTTLE_LOG_INFO( "preProcess_infos: " << getName() );
-    const OfxRectD rod = vData._apiImageEffect._renderRoD;
+    // the output image is only allocated on the RoI
+    const OfxRectD roi = vData._apiImageEffect._renderRoI;
     const std::size_t bitDepth = this->getOutputClip().getBitDepth(); // value in bytes
     const std::size_t nbComponents = getOutputClip().getNbComponents();
-    nodeInfos._memory = std::ceil((rod.x2 - rod.x1) * (rod.y2 - rod.y1) * nbComponents * bitDepth);
+    nodeInfos._memory = std::ceil((roi.x2 - roi.x1) * (roi.y2 - roi.y1) * nbComponents * bitDepth);
 }
 
 void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
@@ -856,6 +971,17 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
                 TUTTLE_LOG_VAR( TUTTLE_INFO, i->getInAttrName() );
         }
         */
+        if(vData._cachedOutput.get() != NULL)
+        {
+            // The output has been computed by a previous render with the same hash,
+            // the inputs are not connected in the graph at time.
+            TUTTLE_LOG_INFO("[Node Process] Use the cached output " << vData._cachedOutput->getFullName());
+            vData._cachedOutput->addReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
+            memoryCache.put(getOutputClip().getClipIdentifier(), vData._time, vData._globalHash, vData._cachedOutput);
+            declareOutputUsages(vData);
+            return;
+        }
+
         TUTTLE_LOG_INFO("[Node Process] Acquire needed input clips images");
         BOOST_FOREACH(const graph::ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdgePair,
                       vData._inEdges)
@@ -889,7 +1015,19 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
                 memory::CACHE_ELEMENT imageCache(new attribute::Image(clip, vData._time, vData._apiImageEffect._renderRoI,
                                                                       attribute::Image::eImageOrientationFromBottomToTop,
                                                                       0));
-                imageCache->setPoolData(core().getMemoryPool().allocate(imageCache->getMemorySize()));
+                attribute::Image* inPlaceInput = getInPlaceInputImage(vData, *imageCache, allNeededDatas);
+                if(inPlaceInput)
+                {
+                    TUTTLE_LOG_TRACE("[Node Process] Render in the buffer of " << inPlaceInput->getFullName());
+                    imageCache->setPoolData(inPlaceInput->getPoolData());
+                }
+                else
+                {
+                    imageCache->setPoolData(core().getMemoryPool().allocate(imageCache->getMemorySize()));
+                }
+                // Keep a reference until the future usages are declared,
+                // so the image can't be seen as unused by another render thread.
+                imageCache->addReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
                 memoryCache.put(clip.getClipIdentifier(), vData._time, imageCache);
 
                 allNeededDatas.push_back(imageCache);
@@ -898,12 +1036,32 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
 
         TUTTLE_LOG_TRACE("[Node Process] Plugin Render Action");
 
-        renderAction(vData._time, vData._apiImageEffect._field, renderWindow, vData._nodeData->_renderScale);
+        {
+            const std::string& threadSafety = getRenderThreadSafety();
+            boost::mutex& renderMutex = (threadSafety == kOfxImageEffectRenderUnsafe) ? gRenderUnsafeMutex : _renderMutex;
+            boost::unique_lock<boost::mutex> renderLock(renderMutex, boost::defer_lock);
+            if(threadSafety != kOfxImageEffectRenderFullySafe)
+                renderLock.lock();
+            renderAction(vData._time, vData._apiImageEffect._field, renderWindow, vData._nodeData->_renderScale);
+        }
 
         TUTTLE_LOG_TRACE("[Node Process] Plugin Render Action - End");
 
         debugOutputImage(vData._time);
 
+        if(vData._globalHash != 0)
+        {
+            // the output is complete, it can be reused by the next renders with the same hash
+            const std::string& outputIdentifier = getOutputClip().getClipIdentifier();
+            memory::CACHE_ELEMENT outputImage = memoryCache.get(outputIdentifier, vData._time);
+            memoryCache.put(outputIdentifier, vData._time, vData._globalHash, outputImage);
+
+            // the hash of the nodes reading unknown files doesn't identify their output in the next processes
+            RenderDiskCache* renderDiskCache = vData._nodeData->_renderDiskCache;
+            if(renderDiskCache && vData._isGlobalHashPersistent)
+                renderDiskCache->storeInBackground(vData._globalHash, outputImage);
+        }
+
         // release input images
         BOOST_FOREACH(const graph::ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdgePair,
                       vData._inEdges)
@@ -929,38 +1087,7 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
             imageCache->releaseReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
         }
 
-        // declare future usages of the output
-        BOOST_FOREACH(ClipImageMap::value_type& item, _clipImages)
-        {
-            attribute::ClipImage& clip = dynamic_cast<attribute::ClipImage&>(*(item.second));
-            if(!clip.isOutput() && !clip.isConnected())
-                continue;
-
-            if(clip.isOutput())
-            {
-                memory::CACHE_ELEMENT imageCache = memoryCache.get(clip.getClipIdentifier(), vData._time);
-                if(imageCache.get() == NULL)
-                {
-                    BOOST_THROW_EXCEPTION(exception::Memory() << exception::dev() + "Clip " + quotes(clip.getFullName()) +
-                                                                     " not in memory cache (identifier:" +
-                                                                     quotes(clip.getClipIdentifier()) + ").");
-                }
-                const std::size_t realOutDegree =
-                    vData._outDegree - vData._isFinalNode; // final nodes have a connection to the fake output node.
-                TUTTLE_LOG_INFO("[Node Process] Declare future usages: " << clip.getClipIdentifier()
-                                                                         << ", add reference: " << realOutDegree);
-                if(realOutDegree > 0)
-                {
-                    TUTTLE_LOG_TRACE("[ImageEffectNode] addReference: " << imageCache->getFullName()
-                                                                        << ", degree=" << realOutDegree);
-                    // TODO: use RAII technique for add/releaseReference...
-                    //       to properly declare image unused when an error occured
-                    //       during the computation.
-                    // Add a reference on this node for each future usages
-                    imageCache->addReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost, realOutDegree);
-                }
-            }
-        }
+        declareOutputUsages(vData);
     }
     catch(boost::exception& e)
     {
@@ -970,9 +1097,84 @@ void ImageEffectNode::process(graph::ProcessVertexAtTimeData& vData)
     }
 }
 
+attribute::Image* ImageEffectNode::getInPlaceInputImage(const graph::ProcessVertexAtTimeData& vData,
+                                                       const attribute::Image& output,
+                                                       const std::list<memory::CACHE_ELEMENT>& inputs) const
+{
+    if(!vData._renderInPlace || inputs.size() != 1)
+        return NULL;
+    attribute::Image& input = *inputs.front();
+    const OfxRectI inputBounds = input.getBounds();
+    const OfxRectI outputBounds = output.getBounds();
+    // the same memory layout is needed, the plugin reads and writes the same pixels
+    if(inputBounds.x1 != outputBounds.x1 || inputBounds.y1 != outputBounds.y1 || inputBounds.x2 != outputBounds.x2 ||
+       inputBounds.y2 != outputBounds.y2 || input.getBitDepth() != output.getBitDepth() ||
+       input.getComponentsType() != output.getComponentsType() || input.getOrientation() != output.getOrientation() ||
+       input.getMemorySize() != output.getMemorySize() || input.getPoolData().get() == NULL)
+        return NULL;
+    return &input;
+}
+
+void ImageEffectNode::declareOutputUsages(const graph::ProcessVertexAtTimeData& vData)
+{
+    memory::IMemoryCache& memoryCache = vData._nodeData->getInternMemoryCache();
+    BOOST_FOREACH(ClipImageMap::value_type& item, _clipImages)
+    {
+        attribute::ClipImage& clip = dynamic_cast<attribute::ClipImage&>(*(item.second));
+        if(!clip.isOutput() && !clip.isConnected())
+            continue;
+
+        if(clip.isOutput())
+        {
+            memory::CACHE_ELEMENT imageCache = memoryCache.get(clip.getClipIdentifier(), vData._time);
+            if(imageCache.get() == NULL)
+            {
+                BOOST_THROW_EXCEPTION(exception::Memory() << exception::dev() + "Clip " + quotes(clip.getFullName()) +
+                                                                 " not in memory cache (identifier:" +
+                                                                 quotes(clip.getClipIdentifier()) + ").");
+            }
+            const std::size_t realOutDegree =
+                vData._outDegree - vData._isFinalNode; // final nodes have a connection to the fake output node.
+            TUTTLE_LOG_INFO("[Node Process] Declare future usages: " << clip.getClipIdentifier()
+                                                                     << ", add reference: " << realOutDegree);
+            if(realOutDegree > 0)
+            {
+                TUTTLE_LOG_TRACE("[ImageEffectNode] addReference: " << imageCache->getFullName()
+                                                                    << ", degree=" << realOutDegree);
+                // TODO: use RAII technique for add/releaseReference...
+                //       to properly declare image unused when an error occured
+                //       during the computation.
+                // Add a reference on this node for each future usages
+                imageCache->addReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost, realOutDegree);
+            }
+            // final nodes keep it until the postProcess, the output buffer is collected after the process
+            if(!vData._isFinalNode)
+                imageCache->releaseReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
+        }
+    }
+}
+
 void ImageEffectNode::postProcess(graph::ProcessVertexAtTimeData& vData)
 {
     //	TUTTLE_LOG_INFO( "postProcess: " << getName() );
+    if(!vData._isFinalNode)
+        return;
+
+    // release the reference taken on the output image during the process
+    memory::IMemoryCache& memoryCache = vData._nodeData->getInternMemoryCache();
+    memory::CACHE_ELEMENT imageCache = memoryCache.get(getOutputClip().getClipIdentifier(), vData._time);
+    if(imageCache.get() != NULL)
+        imageCache->releaseReference(ofx::imageEffect::OfxhImage::eReferenceOwnerHost);
+}
+
+bool ImageEffectNode::isSequentialRender() const
+{
+    return getProperties().getIntProperty(kOfxImageEffectInstancePropSequentialRender) != 0;
+}
+
+bool ImageEffectNode::isWriteBehind() const
+{
+    return getContext() == kOfxImageEffectContextWriter && !isSequentialRender();
 }
 
 void ImageEffectNode::endSequence(graph::ProcessVertexData& vData)
@@ -11,6 +11,7 @@
 #include <tuttle/host/ofx/OfxhImageEffectNode.hpp>
 
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/thread/mutex.hpp>
 
 namespace tuttle
 {
@@ -110,6 +111,7 @@ public:
     const ofx::attribute::OfxhClipImageSet& getClipImageSet() const { return *this; }
 
     std::size_t getLocalHashAtTime(const OfxTime time) const;
+    bool isLocalHashPersistentAtTime(const OfxTime time) const;
 
     OfxRectD getRegionOfDefinition(const OfxTime time) const { return getData(time)._apiImageEffect._renderRoD; }
 
@@ -138,6 +140,11 @@ public:
     void preProcess_infos(const graph::ProcessVertexAtTimeData& vData, const OfxTime time,
                           graph::ProcessVertexAtTimeInfo& nodeInfos) const;
     void process(graph::ProcessVertexAtTimeData& vData);
+    /// The plugin needs its frames to be rendered in order (kOfxImageEffectInstancePropSequentialRender).
+    bool isSequentialRender() const;
+    /// The writers, except the sequential renders, can be processed in background
+    /// (see ComputeOptions::setNbWriteBehindFrames).
+    bool isWriteBehind() const;
     void postProcess(graph::ProcessVertexAtTimeData& vData);
 
     void endSequence(graph::ProcessVertexData& vData);
@@ -283,8 +290,18 @@ private:
     void coutBitDepthConnections() const;
     void validInputClipsConnections() const;
 
+    /// The input image to reuse as output buffer if the node renders in place, NULL otherwise.
+    attribute::Image* getInPlaceInputImage(const graph::ProcessVertexAtTimeData& vData, const attribute::Image& output,
+                                           const std::list<memory::CACHE_ELEMENT>& inputs) const;
+
+    /// Add a reference on the output image for each node using it.
+    void declareOutputUsages(const graph::ProcessVertexAtTimeData& vData);
+
     /// our clip is pretending to be progressive PAL SD, so return kOfxImageFieldNone
     std::string _defaultOutputFielding;
+
+    /// serialize renders of this instance if the plugin is not fully thread safe
+    boost::mutex _renderMutex;
 };
 }
 }
@@ -32,6 +32,7 @@ public:
         return it->second;
     }
     std::size_t getHash(const std::string& name, const OfxTime& time) const { return getHash(NodeAtTimeKey(name, time)); }
+    bool hasHash(const NodeAtTimeKey& k) const { return _hashes.find(k) != _hashes.end(); }
 
     void addHash(const std::string& name, const OfxTime& time, const std::size_t hash)
     {
@@ -22,6 +22,7 @@ namespace host
 Preferences::Preferences()
     : _home(buildTuttleHome())
     , _temp(buildTuttleTemp())
+    , _memoryAllocator(memory::eMemoryAllocatorAligned)
 {
 }
 
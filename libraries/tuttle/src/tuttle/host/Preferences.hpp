@@ -1,6 +1,8 @@
 #ifndef _TUTTLE_HOST_PREFERENCES_HPP_
 #define _TUTTLE_HOST_PREFERENCES_HPP_
 
+#include <tuttle/host/memory/Allocator.hpp>
+
 #include <boost/filesystem/path.hpp>
 
 #include <string>
@@ -15,6 +17,7 @@ class Preferences
 private:
     boost::filesystem::path _home;
     boost::filesystem::path _temp;
+    memory::EMemoryAllocator _memoryAllocator;
 
 public:
     Preferences();
@@ -27,6 +30,12 @@ public:
 
     boost::filesystem::path buildTuttleTestPath() const;
 
+    /**
+     * @brief Backend used by the MemoryPool to allocate new image buffers.
+     */
+    void setMemoryAllocator(const memory::EMemoryAllocator allocator) { _memoryAllocator = allocator; }
+    memory::EMemoryAllocator getMemoryAllocator() const { return _memoryAllocator; }
+
 private:
     boost::filesystem::path buildTuttleHome() const;
     boost::filesystem::path buildTuttleTemp() const;
@@ -1,9 +1,11 @@
 %include <tuttle/host/global.i>
 
 %{
+#include <tuttle/host/memory/Allocator.hpp>
 #include <tuttle/host/Preferences.hpp>
 %}
 
+%include <tuttle/host/memory/Allocator.hpp>
 %include <tuttle/host/Preferences.hpp>
 
 %extend tuttle::host::Preferences
@@ -0,0 +1,120 @@
+#include "ThreadPool.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+
+#include <boost/bind.hpp>
+
+#include <algorithm>
+
+namespace tuttle
+{
+namespace host
+{
+
+ThreadPool::ThreadPool(const std::size_t nbThreads)
+    : _nbWorkers(nbThreads)
+    , _started(false)
+    , _stop(false)
+{
+    if(_nbWorkers == 0)
+        _nbWorkers = std::max(1u, boost::thread::hardware_concurrency());
+    // the calling thread is also used
+    --_nbWorkers;
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        _stop = true;
+    }
+    _loopAdded.notify_all();
+    _workers.join_all();
+}
+
+std::size_t ThreadPool::getNbThreads() const
+{
+    return _nbWorkers + 1;
+}
+
+void ThreadPool::start()
+{
+    TUTTLE_LOG_DEBUG("[Thread pool] start " << _nbWorkers << " workers");
+    for(std::size_t i = 0; i < _nbWorkers; ++i)
+    {
+        _workers.create_thread(boost::bind(&ThreadPool::worker, this));
+    }
+    _started = true;
+}
+
+void ThreadPool::parallelFor(const unsigned int size, const Function& function)
+{
+    if(size == 0)
+        return;
+    if(size == 1 || _nbWorkers == 0)
+    {
+        for(unsigned int i = 0; i < size; ++i)
+            function(i);
+        return;
+    }
+
+    Loop loop(size, function);
+    boost::unique_lock<boost::mutex> lock(_mutex);
+    if(!_started)
+        start();
+    _loops.push_back(&loop);
+    _loopAdded.notify_all();
+
+    // work on our own loop, other loops may be waiting for our indexes
+    while(runNext(lock, &loop))
+    {
+    }
+    while(loop._done != loop._size)
+        _loopDone.wait(lock);
+
+    if(loop._error)
+        boost::rethrow_exception(loop._error);
+}
+
+void ThreadPool::worker()
+{
+    boost::unique_lock<boost::mutex> lock(_mutex);
+    while(!_stop)
+    {
+        if(!runNext(lock))
+            _loopAdded.wait(lock);
+    }
+}
+
+bool ThreadPool::runNext(boost::unique_lock<boost::mutex>& lock, Loop* onlyLoop)
+{
+    if(_loops.empty())
+        return false;
+    Loop& loop = onlyLoop ? *onlyLoop : *_loops.front();
+    if(loop._next == loop._size)
+        return false;
+
+    const unsigned int index = loop._next++;
+    if(loop._next == loop._size)
+        _loops.remove(&loop);
+
+    lock.unlock();
+    boost::exception_ptr error;
+    try
+    {
+        loop._function(index);
+    }
+    catch(...)
+    {
+        error = boost::current_exception();
+    }
+    lock.lock();
+
+    if(error && !loop._error)
+        loop._error = error;
+    if(++loop._done == loop._size)
+        _loopDone.notify_all();
+    return true;
+}
+}
+}
@@ -0,0 +1,90 @@
+#ifndef _TUTTLE_HOST_THREADPOOL_HPP_
+#define _TUTTLE_HOST_THREADPOOL_HPP_
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/function.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <list>
+
+namespace tuttle
+{
+namespace host
+{
+
+/**
+ * @brief Persistent pool of worker threads.
+ *
+ * The threads are started at the first use and live until the destruction of the pool,
+ * so launching a parallel loop only costs a lock and a notification.
+ */
+class ThreadPool : boost::noncopyable
+{
+public:
+    typedef ThreadPool This;
+    typedef boost::function<void(const unsigned int)> Function;
+
+public:
+    /**
+     * @param nbThreads number of worker threads, 0 uses the number of hardware threads.
+     */
+    explicit ThreadPool(const std::size_t nbThreads = 0);
+    ~ThreadPool();
+
+    /**
+     * @brief Number of threads which can execute a loop: the workers and the calling thread.
+     */
+    std::size_t getNbThreads() const;
+
+    /**
+     * @brief Call @p function for each index in [0, @p size).
+     * The calling thread takes part to the work, so several loops can run at the same time
+     * and a loop can be launched from inside another one without deadlock.
+     * Returns when all indexes are done. The first exception thrown by @p function is rethrown.
+     */
+    void parallelFor(const unsigned int size, const Function& function);
+
+private:
+    struct Loop
+    {
+        Loop(const unsigned int size, const Function& function)
+            : _function(function)
+            , _size(size)
+            , _next(0)
+            , _done(0)
+        {
+        }
+        const Function& _function;
+        const unsigned int _size;
+        unsigned int _next; ///< next index to launch
+        unsigned int _done; ///< number of indexes done
+        boost::exception_ptr _error;
+    };
+
+    void start();
+    void worker();
+
+    /**
+     * @brief Take the next index of the first loop and execute it.
+     * @warning @p lock is released during the execution.
+     * @return false if there is no waiting loop.
+     */
+    bool runNext(boost::unique_lock<boost::mutex>& lock, Loop* onlyLoop = NULL);
+
+private:
+    std::size_t _nbWorkers;
+    bool _started;
+    bool _stop;
+    std::list<Loop*> _loops; ///< loops with indexes not launched yet
+    boost::thread_group _workers;
+    boost::mutex _mutex;
+    boost::condition_variable _loopAdded;
+    boost::condition_variable _loopDone;
+};
+}
+}
+
+#endif
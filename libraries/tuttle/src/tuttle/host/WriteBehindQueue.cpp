@@ -0,0 +1,107 @@
+#include "WriteBehindQueue.hpp"
+
+#include <tuttle/common/utils/global.hpp>
+#include <tuttle/host/exceptions.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+
+namespace tuttle
+{
+namespace host
+{
+
+WriteBehindQueue::WriteBehindQueue(const std::size_t nbThreads)
+    : _nextId(0)
+    , _stop(false)
+{
+    TUTTLE_LOG_DEBUG("[Write behind] start " << nbThreads << " threads");
+    for(std::size_t i = 0; i < nbThreads; ++i)
+    {
+        _workers.push_back(
+            boost::shared_ptr<boost::thread>(new boost::thread(boost::bind(&WriteBehindQueue::worker, this))));
+    }
+}
+
+WriteBehindQueue::~WriteBehindQueue()
+{
+    wait();
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        _stop = true;
+    }
+    _writeAdded.notify_all();
+    BOOST_FOREACH(const boost::shared_ptr<boost::thread>& worker, _workers)
+    {
+        worker->join();
+    }
+}
+
+std::size_t WriteBehindQueue::push(const Write& write)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    const std::size_t id = _nextId++;
+    _writes.push_back(std::make_pair(id, write));
+    _writeAdded.notify_one();
+    return id;
+}
+
+bool WriteBehindQueue::isDoneLocked(const std::size_t id) const
+{
+    if(_running.count(id))
+        return false;
+    // the writes are launched in the order of their identifiers
+    return _writes.empty() || _writes.front().first > id;
+}
+
+bool WriteBehindQueue::isDone(const std::size_t id) const
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    return isDoneLocked(id);
+}
+
+void WriteBehindQueue::wait(const std::size_t id)
+{
+    boost::unique_lock<boost::mutex> lock(_mutex);
+    while(!isDoneLocked(id))
+        _writeDone.wait(lock);
+}
+
+void WriteBehindQueue::wait()
+{
+    boost::unique_lock<boost::mutex> lock(_mutex);
+    while(!_writes.empty() || !_running.empty())
+        _writeDone.wait(lock);
+}
+
+void WriteBehindQueue::worker()
+{
+    boost::unique_lock<boost::mutex> lock(_mutex);
+    for(;;)
+    {
+        while(!_stop && _writes.empty())
+            _writeAdded.wait(lock);
+        if(_stop)
+            return;
+
+        const std::pair<std::size_t, Write> write = _writes.front();
+        _writes.pop_front();
+        _running.insert(write.first);
+
+        lock.unlock();
+        try
+        {
+            write.second();
+        }
+        catch(...)
+        {
+            TUTTLE_LOG_ERROR("[Write behind] Uncaught error: " << boost::current_exception_diagnostic_information());
+        }
+        lock.lock();
+
+        _running.erase(write.first);
+        _writeDone.notify_all();
+    }
+}
+}
+}
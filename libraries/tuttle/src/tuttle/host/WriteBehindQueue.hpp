@@ -0,0 +1,75 @@
+#ifndef _TUTTLE_HOST_WRITEBEHINDQUEUE_HPP_
+#define _TUTTLE_HOST_WRITEBEHINDQUEUE_HPP_
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace tuttle
+{
+namespace host
+{
+
+/**
+ * @brief Bounded pool of threads writing the frames in background.
+ *
+ * The writes are launched in the order of their submission, by a fixed number of threads,
+ * so the encoding and the storage of the files run while the next frames are computed.
+ */
+class WriteBehindQueue : boost::noncopyable
+{
+public:
+    typedef WriteBehindQueue This;
+    typedef boost::function<void()> Write;
+
+public:
+    /**
+     * @param nbThreads number of writes running at the same time
+     */
+    explicit WriteBehindQueue(const std::size_t nbThreads);
+
+    /// @brief Wait the end of all the writes
+    ~WriteBehindQueue();
+
+    /**
+     * @brief Launch @p write in background.
+     * @warning @p write must catch its own errors.
+     * @return identifier of the write
+     */
+    std::size_t push(const Write& write);
+
+    /// @brief The write @p id has ended.
+    bool isDone(const std::size_t id) const;
+
+    /// @brief Wait the end of the write @p id.
+    void wait(const std::size_t id);
+
+    /// @brief Wait the end of all the writes.
+    void wait();
+
+private:
+    void worker();
+    bool isDoneLocked(const std::size_t id) const;
+
+private:
+    std::size_t _nextId;
+    std::deque<std::pair<std::size_t, Write> > _writes; ///< writes not launched yet
+    std::set<std::size_t> _running;                     ///< writes in progress
+    bool _stop;
+    std::vector<boost::shared_ptr<boost::thread> > _workers;
+    mutable boost::mutex _mutex;
+    boost::condition_variable _writeAdded;
+    boost::condition_variable _writeDone;
+};
+}
+}
+
+#endif
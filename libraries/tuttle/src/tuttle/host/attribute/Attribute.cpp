@@ -32,6 +32,11 @@ const INode& Attribute::getNode() const
 {
     return _effect;
 }
+
+INode& Attribute::getNode()
+{
+    return _effect;
+}
 }
 }
 }
@@ -27,6 +27,7 @@ public:
 
     virtual const std::string& getName() const = 0;
     const INode& getNode() const;
+    INode& getNode();
 };
 }
 }
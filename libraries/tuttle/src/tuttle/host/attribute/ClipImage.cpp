@@ -191,10 +191,10 @@ tuttle::host::ofx::imageEffect::OfxhImage* ClipImage::getImage(const OfxTime tim
     // connection <" << isConnected() << "> isOutput <" << isOutput() << ">" << " bounds: " << bounds );
     boost::shared_ptr<Image> image = getNode().getData().getInternMemoryCache().get(getClipIdentifier(), realTime);
     //	std::cout << "got image : " << image.get() << std::endl;
-    /// @todo tuttle do something with bounds...
-    /// if bounds != cache buffer bounds:
-    ///  * bounds < cache buffer: use rowSize to adjust, and modify pointer
-    ///  * bounds > cache buffer: recompute / exception ?
+    // The cache buffer is allocated on the union of the RoI requested by all the nodes using it,
+    // so it contains the requested bounds. The image bounds and row bytes give the plugin
+    // the access to the part it needs.
+    /// @todo tuttle: bounds > cache buffer bounds (fetch outside of the RoI): recompute / exception ?
 
     return image.get();
 }
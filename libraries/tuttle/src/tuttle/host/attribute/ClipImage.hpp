@@ -65,6 +65,10 @@ public:
         // TUTTLE_LOG_VAR( TUTTLE_TRACE, getFullName() );
         // TUTTLE_LOG_VAR( TUTTLE_TRACE, other.getFullName() );
 
+        // the renders in background use the connection (see ProcessGraph::processParallelFrames)
+        if(_connectedClip == &other && isConnected())
+            return;
+
         _connectedClip = &other;
         setConnected();
 
@@ -53,11 +53,20 @@ Image::Image(ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const
     setIntProperty(kOfxImagePropBounds, _bounds.x2, 2);
     setIntProperty(kOfxImagePropBounds, _bounds.y2, 3);
 
-    /// @todo the same for bounds and rod, no tiles for the moment !
-    setIntProperty(kOfxImagePropRegionOfDefinition, _bounds.x1, 0);
-    setIntProperty(kOfxImagePropRegionOfDefinition, _bounds.y1, 1);
-    setIntProperty(kOfxImagePropRegionOfDefinition, _bounds.x2, 2);
-    setIntProperty(kOfxImagePropRegionOfDefinition, _bounds.y2, 3);
+    // the bounds only cover the RoI of the node, the rod is the full image
+    OfxRectI rod = _bounds;
+    if(clip.isOutput())
+    {
+        const OfxRectD clipRod = clip.fetchRegionOfDefinition(time);
+        rod.x1 = std::floor(clipRod.x1 / par);
+        rod.x2 = std::ceil(clipRod.x2 / par);
+        rod.y1 = std::floor(clipRod.y1);
+        rod.y2 = std::ceil(clipRod.y2);
+    }
+    setIntProperty(kOfxImagePropRegionOfDefinition, rod.x1, 0);
+    setIntProperty(kOfxImagePropRegionOfDefinition, rod.y1, 1);
+    setIntProperty(kOfxImagePropRegionOfDefinition, rod.x2, 2);
+    setIntProperty(kOfxImagePropRegionOfDefinition, rod.y2, 3);
 
     // row bytes
     _rowAbsDistanceBytes = rowDistanceBytes != 0 ? rowDistanceBytes : automaticRowSize;
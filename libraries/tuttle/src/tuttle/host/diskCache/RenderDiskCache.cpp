@@ -0,0 +1,290 @@
+#include "RenderDiskCache.hpp"
+
+#include <tuttle/host/attribute/Image.hpp>
+#include <tuttle/host/attribute/ClipImage.hpp>
+#include <tuttle/host/WriteBehindQueue.hpp>
+#include <tuttle/host/memory/Allocator.hpp>
+#include <tuttle/host/exceptions.hpp>
+#include <tuttle/common/system/system.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/bind.hpp>
+#include <boost/smart_ptr/detail/atomic_count.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <fstream>
+#include <cstring>
+
+#if defined(__UNIX__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define TUTTLE_DISKCACHE_WITH_MMAP
+#endif
+
+namespace tuttle
+{
+namespace host
+{
+
+namespace
+{
+
+const char kRenderFileMagic[8] = {'T', 'U', 'T', 'T', 'L', 'E', 'R', 'C'};
+const boost::uint32_t kRenderFileVersion = 1;
+
+/**
+ * @brief Header of the cached files, followed by the image buffer.
+ * Its size keeps the buffer aligned like the MemoryPool buffers.
+ */
+struct RenderFileHeader
+{
+    char _magic[8];
+    boost::uint32_t _version;
+    boost::int32_t _bounds[4];
+    boost::int32_t _bitDepth;
+    boost::int32_t _components;
+    boost::int32_t _rowBytes;
+    boost::int32_t _orientation;
+    boost::uint32_t _reserved;
+    boost::uint64_t _dataSize;
+    char _padding[8];
+};
+BOOST_STATIC_ASSERT(sizeof(RenderFileHeader) == memory::kMemoryAlignment);
+
+/**
+ * @brief Image data read from a cached file.
+ * On UNIX systems the file is mapped in memory, so the pages are only read when they are used.
+ */
+class MappedFileData : public memory::IPoolData
+{
+public:
+    MappedFileData(char* mapping, const std::size_t mappingSize)
+        : _mapping(mapping)
+        , _mappingSize(mappingSize)
+        , _size(mappingSize - sizeof(RenderFileHeader))
+        , _refCount(0)
+    {
+    }
+
+    ~MappedFileData()
+    {
+#ifdef TUTTLE_DISKCACHE_WITH_MMAP
+        munmap(_mapping, _mappingSize);
+#else
+        memory::freeBuffer(memory::eMemoryAllocatorAligned, _mapping, _mappingSize);
+#endif
+    }
+
+    void addRef() { ++_refCount; }
+    void release()
+    {
+        if(--_refCount == 0)
+            delete this;
+    }
+
+    const RenderFileHeader& header() const { return *reinterpret_cast<const RenderFileHeader*>(_mapping); }
+
+    char* data() { return _mapping + sizeof(RenderFileHeader); }
+    const char* data() const { return _mapping + sizeof(RenderFileHeader); }
+    const std::size_t size() const { return _size; }
+    const std::size_t reservedSize() const { return _mappingSize - sizeof(RenderFileHeader); }
+
+    void setSize(const std::size_t newSize)
+    {
+        assert(newSize <= reservedSize());
+        _size = newSize;
+    }
+
+private:
+    char* const _mapping;
+    const std::size_t _mappingSize;
+    std::size_t _size;
+    boost::detail::atomic_count _refCount;
+};
+
+/**
+ * @return the content of the file at @p path, NULL if it can't be read.
+ */
+MappedFileData* mapFile(const boost::filesystem::path& path)
+{
+#ifdef TUTTLE_DISKCACHE_WITH_MMAP
+    const int fd = open(path.string().c_str(), O_RDONLY);
+    if(fd < 0)
+        return NULL;
+    struct stat fileStat;
+    if(fstat(fd, &fileStat) != 0 || std::size_t(fileStat.st_size) < sizeof(RenderFileHeader))
+    {
+        close(fd);
+        return NULL;
+    }
+    const std::size_t fileSize = fileStat.st_size;
+    // private mapping: the image stays writable without modifying the file
+    void* mapping = mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapping == MAP_FAILED)
+        return NULL;
+    return new MappedFileData(static_cast<char*>(mapping), fileSize);
+#else
+    std::ifstream file(path.string().c_str(), std::ios::binary | std::ios::ate);
+    if(!file)
+        return NULL;
+    const std::size_t fileSize = file.tellg();
+    if(fileSize < sizeof(RenderFileHeader))
+        return NULL;
+    char* buffer = memory::allocateBuffer(memory::eMemoryAllocatorAligned, fileSize);
+    MappedFileData* data = new MappedFileData(buffer, fileSize);
+    file.seekg(0);
+    if(!file.read(buffer, fileSize))
+    {
+        delete data;
+        return NULL;
+    }
+    return data;
+#endif
+}
+}
+
+const std::string RenderDiskCache::s_renderExtension(".raw");
+
+RenderDiskCache::RenderDiskCache()
+{
+}
+
+RenderDiskCache::~RenderDiskCache()
+{
+    waitStores();
+}
+
+std::string RenderDiskCache::keyToRenderPath(const KeyType key) const
+{
+    return _diskCacheTranslator.keyToAbsolutePath(key).replace_extension(s_renderExtension).string();
+}
+
+bool RenderDiskCache::contains(const KeyType key) const
+{
+    return _diskCacheTranslator.contains(boost::filesystem::path(keyToRenderPath(key)));
+}
+
+void RenderDiskCache::store(const KeyType key, attribute::Image& image)
+{
+    const boost::filesystem::path renderPath = _diskCacheTranslator.create(key).replace_extension(s_renderExtension);
+    const boost::filesystem::path tmpPath =
+        renderPath.parent_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+
+    RenderFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header._magic, kRenderFileMagic, sizeof(header._magic));
+    header._version = kRenderFileVersion;
+    const OfxRectI bounds = image.getBounds();
+    header._bounds[0] = bounds.x1;
+    header._bounds[1] = bounds.y1;
+    header._bounds[2] = bounds.x2;
+    header._bounds[3] = bounds.y2;
+    header._bitDepth = image.getBitDepth();
+    header._components = image.getComponentsType();
+    header._rowBytes = image.getRowAbsDistanceBytes();
+    header._orientation = image.getOrientation();
+    header._dataSize = image.getMemorySize();
+
+    {
+        std::ofstream file(tmpPath.string().c_str(), std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(image.getCharPixelData(), image.getMemorySize());
+        if(!file)
+        {
+            file.close();
+            boost::system::error_code error;
+            boost::filesystem::remove(tmpPath, error);
+            BOOST_THROW_EXCEPTION(exception::File(tmpPath.string())
+                                  << exception::user() + "Can't write the render cache file.");
+        }
+    }
+    boost::filesystem::rename(tmpPath, renderPath);
+    TUTTLE_LOG_TRACE("[Render disk cache] store " << image.getFullName() << " in " << renderPath);
+}
+
+void RenderDiskCache::storeInBackground(const KeyType key, const TImage& image)
+{
+    {
+        boost::mutex::scoped_lock lock(_pendingKeysMutex);
+        // a node which doesn't vary with time has the same hash at each frame
+        if(_pendingKeys.count(key) || contains(key))
+            return;
+        _pendingKeys.insert(key);
+    }
+
+    boost::mutex::scoped_lock lock(_storeQueueMutex);
+    if(!_storeQueue)
+        _storeQueue.reset(new WriteBehindQueue(1));
+    // each pending store keeps an image in memory
+    while(!_storeIds.empty() && (_storeIds.size() >= s_maxPendingStores || _storeQueue->isDone(_storeIds.front())))
+    {
+        _storeQueue->wait(_storeIds.front());
+        _storeIds.pop_front();
+    }
+    _storeIds.push_back(_storeQueue->push(boost::bind(&RenderDiskCache::storeTask, this, key, image)));
+}
+
+void RenderDiskCache::waitStores()
+{
+    boost::mutex::scoped_lock lock(_storeQueueMutex);
+    if(_storeQueue)
+        _storeQueue->wait();
+    _storeIds.clear();
+}
+
+void RenderDiskCache::storeTask(const KeyType key, const TImage image)
+{
+    try
+    {
+        store(key, *image);
+    }
+    catch(...)
+    {
+        // the render is valid even if it can't be cached
+        TUTTLE_LOG_WARNING("[Render disk cache] Can't store " << image->getFullName() << ": "
+                                                              << boost::current_exception_diagnostic_information());
+    }
+    boost::mutex::scoped_lock lock(_pendingKeysMutex);
+    _pendingKeys.erase(key);
+}
+
+RenderDiskCache::TImage RenderDiskCache::retrieve(const KeyType key, attribute::ClipImage& clip, const OfxTime time) const
+{
+    const boost::filesystem::path renderPath = keyToRenderPath(key);
+    memory::IPoolDataPtr data(mapFile(renderPath));
+    if(!data)
+        return TImage();
+
+    const RenderFileHeader& header = static_cast<const MappedFileData&>(*data).header();
+    if(std::memcmp(header._magic, kRenderFileMagic, sizeof(header._magic)) != 0 ||
+       header._version != kRenderFileVersion || header._dataSize != data->size())
+    {
+        TUTTLE_LOG_WARNING("[Render disk cache] invalid file " << renderPath);
+        return TImage();
+    }
+    if(header._bitDepth != clip.getBitDepth() || header._components != clip.getComponents())
+        return TImage();
+
+    const double par = clip.getPixelAspectRatio();
+    const OfxRectD bounds = {header._bounds[0] * par, double(header._bounds[1]), header._bounds[2] * par,
+                             double(header._bounds[3])};
+    TImage image(new attribute::Image(clip, time, bounds, attribute::Image::EImageOrientation(header._orientation),
+                                      header._rowBytes));
+    const OfxRectI imageBounds = image->getBounds();
+    if(imageBounds.x1 != header._bounds[0] || imageBounds.y1 != header._bounds[1] ||
+       imageBounds.x2 != header._bounds[2] || imageBounds.y2 != header._bounds[3] ||
+       image->getMemorySize() != header._dataSize)
+    {
+        return TImage();
+    }
+    image->setPoolData(data);
+    TUTTLE_LOG_TRACE("[Render disk cache] retrieve " << image->getFullName() << " from " << renderPath);
+    return image;
+}
+}
+}
@@ -0,0 +1,107 @@
+#ifndef _TUTTLEOFX_HOST_RENDERDISKCACHE_HPP_
+#define _TUTTLEOFX_HOST_RENDERDISKCACHE_HPP_
+
+#include <tuttle/host/diskCache/DiskCacheTranslator.hpp>
+
+#include <ofxCore.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <set>
+#include <string>
+
+namespace tuttle
+{
+namespace host
+{
+namespace attribute
+{
+class Image;
+class ClipImage;
+}
+class WriteBehindQueue;
+
+/**
+ * @brief Store the outputs of the nodes on your HDD, keyed by the node hash at time.
+ *
+ * The image buffers are written uncompressed after a small header,
+ * so they are memory-mapped back into an image without any decoding.
+ *
+ * The hash of a reader node includes the identity of its file (see ImageEffectNode::getLocalHashAtTime).
+ * The nodes depending on files which can't be identified are not stored (see ProcessVertexAtTimeData).
+ */
+class RenderDiskCache : boost::noncopyable
+{
+public:
+    static const std::string s_renderExtension;
+    typedef DiskCacheTranslator::KeyType KeyType;
+    typedef ::boost::shared_ptr<attribute::Image> TImage;
+
+    /// maximal number of images waiting to be written, the next stores wait for the oldest one
+    static const std::size_t s_maxPendingStores = 4;
+
+public:
+    RenderDiskCache();
+
+    /// @brief Wait the end of the stores in background.
+    ~RenderDiskCache();
+
+    /**
+     * @brief Set the base directory for all cached files.
+     */
+    void setRootDir(const boost::filesystem::path& rootDir) { _diskCacheTranslator.setRootDir(rootDir); }
+    void setRootDir(const std::string& rootDir) { setRootDir(boost::filesystem::path(rootDir)); }
+
+    std::string keyToRenderPath(const KeyType key) const;
+
+    /**
+     * @brief Check if the @p key exists in the cache.
+     */
+    bool contains(const KeyType key) const;
+
+    /**
+     * @brief Write the buffer of @p image in the cache.
+     * The file is written under a temporary name and renamed at the end,
+     * so concurrent renders never see an incomplete file.
+     */
+    void store(const KeyType key, attribute::Image& image);
+
+    /**
+     * @brief Write the buffer of @p image in the cache from a background thread,
+     * so the render doesn't wait for the disk. Nothing is done if the @p key is already stored.
+     * @warning @p image is kept until the end of the write and must not be modified.
+     * The errors are only logged: the render is valid without its cached output.
+     */
+    void storeInBackground(const KeyType key, const TImage& image);
+
+    /// @brief Wait the end of the stores in background.
+    void waitStores();
+
+    /**
+     * @brief Map a cached buffer into a new image of @p clip at @p time.
+     * @return an empty pointer if the key is not in the cache or if the cached buffer
+     *         doesn't have the pixel format of the @p clip.
+     */
+    TImage retrieve(const KeyType key, attribute::ClipImage& clip, const OfxTime time) const;
+
+private:
+    void storeTask(const KeyType key, const TImage image);
+
+private:
+    DiskCacheTranslator _diskCacheTranslator;
+
+    boost::scoped_ptr<WriteBehindQueue> _storeQueue; ///< created by the first store in background
+    std::deque<std::size_t> _storeIds;               ///< stores in the queue, oldest first
+    boost::mutex _storeQueueMutex;
+    std::set<KeyType> _pendingKeys; ///< keys in the queue, not written yet
+    boost::mutex _pendingKeysMutex;
+};
+}
+}
+
+#endif
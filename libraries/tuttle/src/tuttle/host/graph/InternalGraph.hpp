@@ -446,7 +446,9 @@ public:
     template <typename Vertex, typename Edge>
     friend std::ostream& operator<<(std::ostream& os, const This& g);
 
-private:
+    /**
+     * @brief Update the vertex keys index, needed if the keys of the vertices have been modified.
+     */
     void rebuildVertexDescriptorMap();
 
 protected:
@@ -33,6 +33,15 @@ public:
     inline OfxTime getOutTime() const { return _outTime; }
     inline OfxTime getInTime() const { return _inTime; }
 
+    /**
+     * @brief Move the edge to another frame, the time dependencies stay the same.
+     */
+    inline void shiftTime(const OfxTime offset)
+    {
+        _inTime += offset;
+        _outTime += offset;
+    }
+
 private:
     OfxTime _inTime;
     OfxTime _outTime;
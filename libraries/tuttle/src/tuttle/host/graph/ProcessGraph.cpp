@@ -3,7 +3,21 @@
 #include <tuttle/common/utils/color.hpp>
 #include <tuttle/host/graph/GraphExporter.hpp>
 
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/ImageEffectNode.hpp>
+#include <tuttle/host/attribute/ClipImage.hpp>
+
 #include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <set>
 
 #if(TUTTLE_EXPORT_WITH_TIMER)
 #include <boost/timer/timer.hpp>
@@ -24,10 +38,18 @@ ProcessGraph::ProcessGraph(const ComputeOptions& options, Graph& userGraph, cons
     , _options(options)
     , _internMemoryCache(internMemoryCache)
     , _procOptions(&_internMemoryCache)
+    , _graphAtTimeTime(0)
+    , _isGraphAtTimeReusable(false)
+    , _isTemporalAccessUsed(false)
 {
     _procOptions._interactive = _options.getIsInteractive();
     // imageEffect specific...
     _procOptions._renderScale = _options.getRenderScale();
+    if(!_options.getRenderDiskCachePath().empty())
+    {
+        _renderDiskCache.setRootDir(_options.getRenderDiskCachePath());
+        _procOptions._renderDiskCache = &_renderDiskCache;
+    }
 
     updateGraph(userGraph, outputNodes);
 }
@@ -145,6 +167,44 @@ private:
 };
 */
 
+namespace
+{
+
+/**
+ * @brief The clips of the nodes are connected like in @p graphAtTime.
+ */
+bool hasClipConnections(ProcessGraph::InternalGraphAtTimeImpl& graphAtTime)
+{
+    BOOST_FOREACH(const ProcessGraph::InternalGraphAtTimeImpl::edge_descriptor ed, graphAtTime.getEdges())
+    {
+        ProcessVertexAtTime& vertexOutput = graphAtTime.targetInstance(ed);
+        ProcessVertexAtTime& vertexInput = graphAtTime.sourceInstance(ed);
+        if(vertexOutput.isFake() || vertexInput.isFake())
+            continue;
+        const attribute::ClipImage& clip = dynamic_cast<const attribute::ClipImage&>(
+            vertexInput.getProcessNode().getAttribute(graphAtTime.instance(ed).getInAttrName()));
+        if(!clip.isConnected() || &clip.getConnectedClip() != &vertexOutput.getProcessNode().getOutputClip())
+            return false;
+    }
+    return true;
+}
+
+bool isSameRect(const OfxRectD& a, const OfxRectD& b)
+{
+    return a.x1 == b.x1 && a.y1 == b.y1 && a.x2 == b.x2 && a.y2 == b.y2;
+}
+}
+
+void ProcessGraph::connectClipsAtTime(InternalGraphAtTimeImpl& _renderGraphAtTime)
+{
+    if(_writeBehindQueue && !hasClipConnections(_renderGraphAtTime))
+    {
+        TUTTLE_LOG_INFO("[Connect clips] the connections change, wait the writes in background");
+        _writeBehindQueue->wait();
+    }
+    connectClips<InternalGraphAtTimeImpl>(_renderGraphAtTime);
+}
+
 void ProcessGraph::bakeGraphInformationToNodes(InternalGraphAtTimeImpl& _renderGraphAtTime)
 {
     BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
@@ -178,7 +238,7 @@ void ProcessGraph::bakeGraphInformationToNodes(InternalGraphAtTimeImpl& _renderG
         }
     }
     TUTTLE_LOG_INFO("[bake graph information to nodes] connect clips");
-    connectClips<InternalGraphAtTimeImpl>(_renderGraphAtTime);
+    connectClipsAtTime(_renderGraphAtTime);
 }
 
 void ProcessGraph::beginSequence(const TimeRange& timeRange)
@@ -188,6 +248,9 @@ void ProcessGraph::beginSequence(const TimeRange& timeRange)
     _procOptions._renderTimeRange.max = timeRange._end;
     _procOptions._step = timeRange._step;
 
+    if(_options.getMemoryHighWaterMark())
+        core().getMemoryPool().startTrimmer(_options.getMemoryHighWaterMark(), 1000);
+
     TUTTLE_LOG_INFO("[begin sequence] start");
     //	BOOST_FOREACH( NodeMap::value_type& p, _nodes )
     for(NodeMap::iterator it = _nodes.begin(), itEnd = _nodes.end(); it != itEnd; ++it)
@@ -200,6 +263,10 @@ void ProcessGraph::beginSequence(const TimeRange& timeRange)
 void ProcessGraph::endSequence()
 {
     _options.endSequenceHandle();
+    if(_options.getMemoryHighWaterMark())
+        core().getMemoryPool().stopTrimmer();
+    // the outputs are on disk at the end of the compute
+    _renderDiskCache.waitStores();
     TUTTLE_LOG_INFO("[Process render] process end sequence");
     //--- END sequence render
     BOOST_FOREACH(NodeMap::value_type& p, _nodes)
@@ -210,6 +277,7 @@ void ProcessGraph::endSequence()
 
 void ProcessGraph::updateGraph(Graph& userGraph, const std::list<std::string>& outputNodes)
 {
+    _isGraphAtTimeReusable = false;
     _renderGraph.copyTransposed(userGraph.getGraph());
 
     Vertex outputVertex(_procOptions, _outputId);
@@ -243,6 +311,8 @@ void ProcessGraph::setup()
     using namespace boost;
     using namespace boost::graph;
     TUTTLE_LOG_INFO("[Process render] setup");
+    _isGraphAtTimeReusable = false;
+    _isTemporalAccessUsed = false;
 
     // Initialize variables
     //	OfxRectD renderWindow = { 0, 0, 0, 0 };
@@ -274,6 +344,9 @@ void ProcessGraph::setup()
         {
             v.setProcessData(_procOptions);
             v.getProcessNode().setProcessData(&v._data);
+            if(v.getProcessNode().getNodeType() == INode::eNodeTypeImageEffect &&
+               v.getProcessNode().asImageEffectNode().temporalAccess())
+                _isTemporalAccessUsed = true;
         }
     }
 
@@ -342,13 +415,145 @@ void ProcessGraph::setupAtTime(const OfxTime time)
     boost::timer::cpu_timer timer;
 #endif
 
+    if(!_options.getIncrementalSetup())
+    {
+        buildGraphAtTime(_renderGraphAtTime, time);
+        setupGraphAtTime(_renderGraphAtTime, time);
+        return;
+    }
+
+    bool isShiftable = _isGraphAtTimeReusable;
+    // stays false if the setup fails
+    _isGraphAtTimeReusable = false;
+
+    bool isDeployed = false;
+    if(isShiftable && _isTemporalAccessUsed)
+    {
+        // without temporal access, all the nodes are always needed at the current time only
+        deployTime(time);
+        isDeployed = true;
+        isShiftable = getTimeOffsets(time) == _graphAtTimeOffsets;
+    }
+    if(isShiftable)
+    {
+        TUTTLE_LOG_TRACE("[Setup at time " << time << "] reuse the graph of time " << _graphAtTimeTime);
+        shiftGraphAtTime(_renderGraphAtTime, time - _graphAtTimeTime);
+        _graphAtTimeTime = time;
+        if(updateGraphAtTime(_renderGraphAtTime, time))
+        {
+            _isGraphAtTimeReusable = optimizeGraphAtTime(_renderGraphAtTime, time);
+            return;
+        }
+        TUTTLE_LOG_TRACE("[Setup at time " << time << "] the identity nodes change, rebuild the graph");
+    }
+
+    if(!isDeployed)
+        deployTime(time);
+    fillGraphAtTime(_renderGraphAtTime, time);
+    _graphAtTimeOffsets = getTimeOffsets(time);
+    _graphAtTimeTime = time;
+    // the graph can't be moved to another time if identity nodes have been removed for this one
+    if(!setupGraphAtTime(_renderGraphAtTime, time))
+        return;
+
+    // the parameters of the next frames are compared to these ones by updateGraphAtTime
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    {
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        if(!v.isFake())
+            v._data._localHash = v.getProcessNode().getLocalHashAtTime(v._data._time);
+    }
+    _isGraphAtTimeReusable = true;
+}
+
+/**
+ * @brief Compute the times needed on each node to compute @p time.
+ */
+void ProcessGraph::deployTime(const OfxTime time)
+{
     TUTTLE_LOG_TRACE("[Setup at time " << time << "] start");
     graph::visitor::DeployTime<InternalGraphImpl> deployTimeVisitor(_renderGraph, time);
     _renderGraph.depthFirstVisit(deployTimeVisitor, _renderGraph.getVertexDescriptor(_outputId));
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
     graph::exportDebugAsDOT("graphProcess_c.dot", _renderGraph);
 #endif
+}
+
+/**
+ * @brief Time dependencies of all the nodes and connections, relative to @p time.
+ * Two frames with the same offsets have the same graph at time.
+ */
+std::vector<OfxTime> ProcessGraph::getTimeOffsets(const OfxTime time) const
+{
+    std::vector<OfxTime> offsets;
+    BOOST_FOREACH(const InternalGraphImpl::vertex_descriptor vd, _renderGraph.getVertices())
+    {
+        const Vertex& v = _renderGraph.instance(vd);
+        offsets.push_back(v._data._times.size());
+        BOOST_FOREACH(const OfxTime t, v._data._times)
+        {
+            offsets.push_back(t - time);
+        }
+    }
+    BOOST_FOREACH(const InternalGraphImpl::edge_descriptor ed, _renderGraph.getEdges())
+    {
+        const Edge& e = _renderGraph.instance(ed);
+        offsets.push_back(e._timesNeeded.size());
+        BOOST_FOREACH(const Edge::TimeMap::value_type& tm, e._timesNeeded)
+        {
+            offsets.push_back(tm.first - time);
+            offsets.push_back(tm.second.size());
+            BOOST_FOREACH(const OfxTime t, tm.second)
+            {
+                offsets.push_back(t - time);
+            }
+        }
+    }
+    return offsets;
+}
+
+/**
+ * @brief Move the graph at time to another frame with the same time dependencies,
+ * without rebuilding it. The connections baked into the nodes are kept,
+ * the preprocess datas are updated by updateGraphAtTime.
+ */
+void ProcessGraph::shiftGraphAtTime(InternalGraphAtTimeImpl& _renderGraphAtTime, const OfxTime offset)
+{
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraphAtTime.getEdges())
+    {
+        _renderGraphAtTime.instance(ed).shiftTime(offset);
+    }
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    {
+        ProcessVertexAtTimeData& vData = _renderGraphAtTime.instance(vd)._data;
+        vData._time += offset;
+
+        // the input edges are indexed by time
+        ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName inEdges;
+        BOOST_FOREACH(const ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::value_type& inEdge, vData._inEdges)
+        {
+            const ProcessEdgeAtTime* e = inEdge.second;
+            inEdges[ProcessVertexAtTimeData::Key(e->getInAttrName(), e->getInTime())] = e;
+        }
+        vData._inEdges.swap(inEdges);
+    }
+    _renderGraphAtTime.rebuildVertexDescriptorMap();
+}
 
+/**
+ * @brief Create a graph with a vertex for each node at each time needed to compute @p time.
+ */
+void ProcessGraph::buildGraphAtTime(InternalGraphAtTimeImpl& _renderGraphAtTime, const OfxTime time)
+{
+    deployTime(time);
+    fillGraphAtTime(_renderGraphAtTime, time);
+}
+
+/**
+ * @brief Create the graph at time from the times deployed on the render graph.
+ */
+void ProcessGraph::fillGraphAtTime(InternalGraphAtTimeImpl& _renderGraphAtTime, const OfxTime time)
+{
     TUTTLE_LOG_TRACE("[Setup at time " << time << "] build render graph");
     // create a new graph with time information
     _renderGraphAtTime.clear();
@@ -394,7 +599,8 @@ void ProcessGraph::setupAtTime(const OfxTime time)
         }
     }
 
-    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime(time);
+    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime =
+        _renderGraphAtTime.getVertexDescriptor(getOutputKeyAtTime(time));
 
     // declare final nodes
     BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed,
@@ -404,6 +610,17 @@ void ProcessGraph::setupAtTime(const OfxTime time)
         v.getProcessDataAtTime()._isFinalNode =
             true; /// @todo: this is maybe better to move this into the ProcessData? Doesn't depend on time?
     }
+}
+
+/**
+ * @brief Link the nodes to their data at time, remove identity nodes and run the preprocess steps.
+ * @return false if identity nodes have been removed from the graph.
+ */
+bool ProcessGraph::setupGraphAtTime(InternalGraphAtTimeImpl& _renderGraphAtTime, const OfxTime time)
+{
+    bool identityNodesRemoved = false;
+    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime =
+        _renderGraphAtTime.getVertexDescriptor(getOutputKeyAtTime(time));
 
     TUTTLE_LOG_INFO("[Setup at time " << time << "] set data at time");
     // give a link to the node on its attached process data
@@ -435,6 +652,7 @@ void ProcessGraph::setupAtTime(const OfxTime time)
         if(toRemove.size())
         {
             graph::visitor::removeIdentityNodes(_renderGraphAtTime, toRemove);
+            identityNodesRemoved = true;
 
             // Bake graph information again as the connections have changed.
             bakeGraphInformationToNodes(_renderGraphAtTime);
@@ -453,19 +671,19 @@ void ProcessGraph::setupAtTime(const OfxTime time)
 
     {
         TUTTLE_LOG_TRACE("[Setup at time " << time << "] preprocess 2");
-        graph::visitor::PreProcess2<InternalGraphAtTimeImpl> preProcess2Visitor(_renderGraphAtTime);
+        std::vector<InternalGraphAtTimeImpl::vertex_descriptor> finishOrder;
+        graph::visitor::PreProcess2<InternalGraphAtTimeImpl> preProcess2Visitor(_renderGraphAtTime, finishOrder);
         _renderGraphAtTime.depthFirstVisit(preProcess2Visitor, outputAtTime);
+        preProcess2Visitor.processReverse();
     }
 
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
     graph::exportDebugAsDOT("graphProcessAtTime_c.dot", _renderGraphAtTime);
 #endif
 
-/*
-TUTTLE_LOG_INFO( "---------------------------------------- optimize graph" );
-graph::visitor::OptimizeGraph<InternalGraphAtTimeImpl> optimizeGraphVisitor( _renderGraphAtTime );
-_renderGraphAtTime.depthFirstVisit( optimizeGraphVisitor, outputAtTime );
-*/
+    if(!optimizeGraphAtTime(_renderGraphAtTime, time))
+        identityNodesRemoved = true;
+
 #if(TUTTLE_EXPORT_PROCESSGRAPH_DOT)
     graph::exportDebugAsDOT("graphProcessAtTime_d.dot", _renderGraphAtTime);
 #endif
@@ -517,6 +735,207 @@ _renderGraph.targetInstance(*oe_it).getProcessDataAtTime()._globalInfos._memory
     graph::exportDebugAsDOT( "graphprocess_e.dot", tmpGraph );
 #endif
     */
+    return !identityNodesRemoved;
+}
+
+/**
+ * @brief Update the preprocess datas of a graph at time moved by shiftGraphAtTime.
+ * Only the nodes with other parameters at this time and the nodes depending on them
+ * compute their RoD and RoI again.
+ * @return false if the identity nodes change, the graph at time needs to be rebuilt.
+ */
+bool ProcessGraph::updateGraphAtTime(InternalGraphAtTimeImpl& _renderGraphAtTime, const OfxTime time)
+{
+    typedef InternalGraphAtTimeImpl::vertex_descriptor vertex_descriptor;
+    const vertex_descriptor outputAtTime = _renderGraphAtTime.getVertexDescriptor(getOutputKeyAtTime(time));
+
+    TUTTLE_LOG_TRACE("[Setup at time " << time << "] update data at time");
+    BOOST_FOREACH(const vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    {
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        if(!v.isFake())
+            v.getProcessNode().setProcessDataAtTime(&v._data);
+    }
+    if(!hasClipConnections(_renderGraphAtTime))
+        connectClipsAtTime(_renderGraphAtTime);
+
+    std::set<vertex_descriptor> modified;
+    BOOST_FOREACH(const vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    {
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        if(v.isFake())
+            continue;
+        const std::size_t localHash = v.getProcessNode().getLocalHashAtTime(v._data._time);
+        if(localHash == v._data._localHash)
+            continue;
+
+        std::string inputClip;
+        OfxTime atTime;
+        if(!_options.getForceIdentityNodesProcess() && v.getProcessNode().isIdentity(v._data, inputClip, atTime))
+            return false;
+        v._data._localHash = localHash;
+        modified.insert(vd);
+    }
+    TUTTLE_LOG_TRACE("[Setup at time " << time << "] " << modified.size() << " nodes with other parameters");
+    if(modified.empty())
+        return true;
+
+    // inputs before outputs
+    std::vector<vertex_descriptor> finishOrder;
+    graph::visitor::PreProcess2<InternalGraphAtTimeImpl> finishOrderVisitor(_renderGraphAtTime, finishOrder);
+    _renderGraphAtTime.depthFirstVisit(finishOrderVisitor, outputAtTime);
+
+    // RoD of the modified nodes and of the nodes using a modified RoD
+    std::set<vertex_descriptor> preprocessed;
+    std::set<vertex_descriptor> rodChanged;
+    BOOST_FOREACH(const vertex_descriptor vd, finishOrder)
+    {
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        if(v.isFake())
+            continue;
+        bool update = modified.count(vd) != 0;
+        BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraphAtTime.getOutEdges(vd))
+        {
+            update = update || rodChanged.count(_renderGraphAtTime.target(ed)) != 0;
+        }
+        if(!update)
+            continue;
+        const OfxRectD rod = v._data._apiImageEffect._renderRoD;
+        v.getProcessNode().preProcess1(v._data);
+        preprocessed.insert(vd);
+        if(!isSameRect(rod, v._data._apiImageEffect._renderRoD))
+            rodChanged.insert(vd);
+    }
+
+    // The RoI of a node is the union of the RoI requested by its outputs,
+    // so the inputs of the updated nodes are reset and all their outputs request their RoI again.
+    std::set<vertex_descriptor> roiReset;
+    std::set<vertex_descriptor> roiRequests;
+    BOOST_REVERSE_FOREACH(const vertex_descriptor vd, finishOrder)
+    {
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        if(v.isFake())
+            continue;
+        bool reset = preprocessed.count(vd) != 0;
+        BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraphAtTime.getInEdges(vd))
+        {
+            reset = reset || roiReset.count(_renderGraphAtTime.source(ed)) != 0;
+        }
+        if(!reset)
+            continue;
+        if(!preprocessed.count(vd))
+            v.getProcessNode().preProcess1(v._data);
+        roiReset.insert(vd);
+        roiRequests.insert(vd);
+        BOOST_FOREACH(const InternalGraphAtTimeImpl::edge_descriptor ed, _renderGraphAtTime.getInEdges(vd))
+        {
+            roiRequests.insert(_renderGraphAtTime.source(ed));
+        }
+    }
+    BOOST_REVERSE_FOREACH(const vertex_descriptor vd, finishOrder)
+    {
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        if(!v.isFake() && roiRequests.count(vd))
+            v.getProcessNode().preProcess2_reverse(v._data);
+    }
+    TUTTLE_LOG_TRACE("[Setup at time " << time << "] " << roiReset.size() << " nodes preprocessed again");
+    return true;
+}
+
+/**
+ * @brief Optimizations of the preprocessed graph at time: reuse the cached outputs and render in place.
+ * @return false if the branches computed by cached nodes have been disconnected.
+ */
+bool ProcessGraph::optimizeGraphAtTime(InternalGraphAtTimeImpl& _renderGraphAtTime, const OfxTime time)
+{
+    bool isGraphUnchanged = true;
+    if((_options.getRenderCache() || _procOptions._renderDiskCache) && useRenderCache(_renderGraphAtTime, time))
+    {
+        // The branches computed by cached nodes are disconnected.
+        isGraphUnchanged = false;
+    }
+
+    if(_options.getFusePointWiseNodes())
+    {
+        // After the render cache: the outputs shared with the cache are never modified in place.
+        graph::visitor::FusePointWiseNodes<InternalGraphAtTimeImpl> fusePointWiseNodesVisitor(_renderGraphAtTime);
+        _renderGraphAtTime.depthFirstVisit(fusePointWiseNodesVisitor,
+                                           _renderGraphAtTime.getVertexDescriptor(getOutputKeyAtTime(time)));
+        TUTTLE_LOG_TRACE("[Setup at time " << time << "] " << fusePointWiseNodesVisitor.getNbFusedNodes()
+                                           << " point-wise nodes rendered in place");
+    }
+    return isGraphUnchanged;
+}
+
+/**
+ * @brief Reuse the outputs of a previous render for the nodes with the same hash,
+ * from the internal MemoryCache or from the render disk cache.
+ * The inputs of these nodes are disconnected, so the branches computing them are not processed.
+ * @return true if the graph has been modified.
+ */
+bool ProcessGraph::useRenderCache(InternalGraphAtTimeImpl& _renderGraphAtTime, const OfxTime time)
+{
+    TUTTLE_LOG_TRACE("[Setup at time " << time << "] search cached outputs");
+    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime =
+        _renderGraphAtTime.getVertexDescriptor(getOutputKeyAtTime(time));
+
+    NodeHashContainer nodesHash;
+    graph::visitor::ComputeHashAtTime<InternalGraphAtTimeImpl> computeHashAtTimeVisitor(_renderGraphAtTime, nodesHash,
+                                                                                        time);
+    _renderGraphAtTime.depthFirstVisit(computeHashAtTimeVisitor, outputAtTime);
+
+    bool cachedOutputs = false;
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    {
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        if(v.isFake())
+            continue;
+        ProcessVertexAtTimeData& vData = v.getProcessDataAtTime();
+        vData._cachedOutput.reset();
+        vData._globalHash = 0;
+        if(v.getProcessNode().getNodeType() != INode::eNodeTypeImageEffect)
+            continue;
+        if(!nodesHash.hasHash(v.getKey()))
+            continue; // not used by this render (e.g. removed identity node)
+
+        // the output depends on the render scale
+        std::size_t seed = nodesHash.getHash(v.getKey());
+        boost::hash_combine(seed, _procOptions._renderScale.x);
+        boost::hash_combine(seed, _procOptions._renderScale.y);
+        vData._globalHash = seed;
+
+        memory::CACHE_ELEMENT cachedOutput = _internMemoryCache.getByHash(seed);
+        if(cachedOutput.get() == NULL && _procOptions._renderDiskCache && vData._isGlobalHashPersistent)
+        {
+            cachedOutput = _procOptions._renderDiskCache->retrieve(
+                seed, v.getProcessNode().getOutputClip(), vData._time);
+        }
+        if(cachedOutput.get() == NULL)
+            continue;
+        // the cached image needs the pixel format of the current output (like the disk cache)
+        const attribute::ClipImage& outputClip = v.getProcessNode().getOutputClip();
+        if(cachedOutput->getBitDepth() != outputClip.getBitDepth() ||
+           cachedOutput->getComponentsType() != outputClip.getComponents() ||
+           cachedOutput->getDoubleProperty(kOfxImagePropPixelAspectRatio) != outputClip.getPixelAspectRatio())
+            continue;
+        // the cached image needs to cover the region requested by the current render
+        const OfxRectI bounds = cachedOutput->getBounds();
+        const OfxRectD& roi = vData._apiImageEffect._renderRoI;
+        if(bounds.x1 > roi.x1 || bounds.y1 > roi.y1 || bounds.x2 < roi.x2 || bounds.y2 < roi.y2)
+            continue;
+
+        TUTTLE_LOG_TRACE("[Setup at time " << time << "] use cached output for " << v);
+        vData._cachedOutput = cachedOutput;
+        _renderGraphAtTime.clearVertexOutputs(vd);
+        cachedOutputs = true;
+    }
+
+    if(cachedOutputs)
+    {
+        // Bake graph information again as the connections have changed.
+        bakeGraphInformationToNodes(_renderGraphAtTime);
+    }
+    return cachedOutputs;
 }
 
 void ProcessGraph::computeHashAtTime(NodeHashContainer& outNodesHash, const OfxTime time)
@@ -541,11 +960,47 @@ void ProcessGraph::processAtTime(memory::IMemoryCache& outCache, const OfxTime t
 #endif
 
     TUTTLE_LOG_TRACE("[Process at time " << time << "] Output node : " << _renderGraph.getVertex(_outputId).getName());
-    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime = getOutputVertexAtTime(time);
+
+    beforeRenderGraphAtTime(_renderGraphAtTime, time);
+    processGraphAtTime(_renderGraphAtTime, outCache, time);
+
+    ///@todo clean datas...
+    TUTTLE_LOG_TRACE("[Process at time " << time << "] Clear data at time");
+    // give a link to the node on its attached process data
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+    {
+        VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        if(!v.isFake())
+        {
+            v.getProcessNode().clearProcessDataAtTime();
+        }
+    }
+
+    // clear cache at each frame, unless the outputs are kept for the next renders
+    // @todo: remove
+    if(!_options.getRenderCache())
+        _internMemoryCache.clearUnused();
+
+    TUTTLE_LOG_TRACE("[Process at time " << time << "] Memory cache size: " << _internMemoryCache.size());
+    TUTTLE_LOG_TRACE("[Process at time " << time << "] Out cache size: " << outCache.size());
+}
+
+void ProcessGraph::beforeRenderGraphAtTime(InternalGraphAtTimeImpl& _renderGraphAtTime, const OfxTime time)
+{
+    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime =
+        _renderGraphAtTime.getVertexDescriptor(getOutputKeyAtTime(time));
 
     // Launch a pass of callbacks on the nodes
     graph::visitor::BeforeRenderCallbackVisitor<InternalGraphAtTimeImpl> callbackRun(_renderGraphAtTime);
     _renderGraphAtTime.depthFirstVisit(callbackRun, outputAtTime);
+}
+
+void ProcessGraph::processGraphAtTime(InternalGraphAtTimeImpl& _renderGraphAtTime, memory::IMemoryCache& outCache,
+                                      const OfxTime time,
+                                      std::vector<InternalGraphAtTimeImpl::vertex_descriptor>* writes)
+{
+    InternalGraphAtTimeImpl::vertex_descriptor outputAtTime =
+        _renderGraphAtTime.getVertexDescriptor(getOutputKeyAtTime(time));
 
     // do the process
     graph::visitor::Process<InternalGraphAtTimeImpl> processVisitor(_renderGraphAtTime, _internMemoryCache);
@@ -554,31 +1009,480 @@ void ProcessGraph::processAtTime(memory::IMemoryCache& outCache, const OfxTime t
         // accumulate output nodes buffers into the @p outCache MemoryCache
         processVisitor.setOutputMemoryCache(outCache);
     }
+    if(writes)
+        processVisitor.setWriteBehind(*writes);
 
     _renderGraphAtTime.depthFirstVisit(processVisitor, outputAtTime);
 
     TUTTLE_LOG_TRACE("[Process at time " << time << "] Post process");
     graph::visitor::PostProcess<InternalGraphAtTimeImpl> postProcessVisitor(_renderGraphAtTime);
+    if(writes)
+        postProcessVisitor.setWriteBehind(*writes);
     _renderGraphAtTime.depthFirstVisit(postProcessVisitor, outputAtTime);
+}
 
-    ///@todo clean datas...
-    TUTTLE_LOG_TRACE("[Process at time " << time << "] Clear data at time");
-    // give a link to the node on its attached process data
-    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, _renderGraphAtTime.getVertices())
+void ProcessGraph::writeGraphAtTime(InternalGraphAtTimeImpl& _renderGraphAtTime, memory::IMemoryCache& outCache,
+                                    const std::vector<InternalGraphAtTimeImpl::vertex_descriptor>& writes)
+{
+    graph::visitor::Process<InternalGraphAtTimeImpl> processVisitor(_renderGraphAtTime, _internMemoryCache);
+    if(_options.getReturnBuffers())
+        processVisitor.setOutputMemoryCache(outCache);
+
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, writes)
+    {
+        processVisitor.processVertex(_renderGraphAtTime.instance(vd));
+    }
+    BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, writes)
     {
         VertexAtTime& v = _renderGraphAtTime.instance(vd);
+        v.getProcessNode().postProcess(v.getProcessDataAtTime());
+    }
+}
+
+namespace
+{
+
+/**
+ * @brief A frame of a group of frames rendered at the same time.
+ */
+struct ParallelFrame
+{
+    typedef ProcessGraph::InternalGraphAtTimeImpl InternalGraphAtTimeImpl;
+    typedef std::map<std::pair<std::string, std::string>, std::string> ClipConnections;
+
+    explicit ParallelFrame(const OfxTime time)
+        : _time(time)
+        , _graphAtTime(new InternalGraphAtTimeImpl())
+        , _isWriting(false)
+        , _writeId(0)
+    {
+    }
+
+    OfxTime _time;
+    boost::shared_ptr<InternalGraphAtTimeImpl> _graphAtTime;
+    boost::exception_ptr _error;
+
+    std::vector<InternalGraphAtTimeImpl::vertex_descriptor> _writes; ///< writer nodes processed in background
+    bool _isWriting;                                                 ///< the writes are in the WriteBehindQueue
+    std::size_t _writeId;
+};
+
+/**
+ * @brief The clip connections are stored inside the nodes, so all frames
+ * processed at the same time need the same connections.
+ */
+ParallelFrame::ClipConnections getClipConnections(ParallelFrame::InternalGraphAtTimeImpl& graphAtTime)
+{
+    ParallelFrame::ClipConnections connections;
+    BOOST_FOREACH(const ParallelFrame::InternalGraphAtTimeImpl::edge_descriptor ed, graphAtTime.getEdges())
+    {
+        const ProcessVertexAtTime& vertexOutput = graphAtTime.targetInstance(ed);
+        const ProcessVertexAtTime& vertexInput = graphAtTime.sourceInstance(ed);
+        if(vertexOutput.isFake() || vertexInput.isFake())
+            continue;
+        const std::pair<std::string, std::string> clip(vertexInput.getName(), graphAtTime.instance(ed).getInAttrName());
+        connections[clip] = vertexOutput.getName();
+    }
+    return connections;
+}
+
+void clearProcessDataAtTime(ParallelFrame::InternalGraphAtTimeImpl& graphAtTime)
+{
+    BOOST_FOREACH(const ParallelFrame::InternalGraphAtTimeImpl::vertex_descriptor vd, graphAtTime.getVertices())
+    {
+        ProcessVertexAtTime& v = graphAtTime.instance(vd);
         if(!v.isFake())
         {
-            v.getProcessNode().clearProcessDataAtTime();
+            v.getProcessNode().clearProcessDataAtTime(v.getProcessDataAtTime()._time);
         }
     }
+}
+}
 
-    // clear cache at each frame
-    // @todo: remove
-    _internMemoryCache.clearUnused();
+std::size_t ProcessGraph::getNbParallelFrames() const
+{
+    std::size_t nbFrames = _options.getNbParallelFrames();
+    if(nbFrames == 0)
+        nbFrames = boost::thread::hardware_concurrency();
+    if(nbFrames <= 1)
+        return 1;
 
-    TUTTLE_LOG_TRACE("[Process at time " << time << "] Memory cache size: " << _internMemoryCache.size());
-    TUTTLE_LOG_TRACE("[Process at time " << time << "] Out cache size: " << outCache.size());
+    BOOST_FOREACH(const NodeMap::value_type& p, _nodes)
+    {
+        const INode& node = *p.second;
+        if(node.getNodeType() == INode::eNodeTypeImageEffect && node.asImageEffectNode().isSequentialRender())
+        {
+            TUTTLE_LOG_INFO("[Process render] " << quotes(node.getName())
+                                                << " needs a sequential render, frames are processed one by one.");
+            return 1;
+        }
+    }
+    return nbFrames;
+}
+
+bool ProcessGraph::skipFrameOnError(const OfxTime time) const
+{
+    try
+    {
+        throw;
+    }
+    catch(tuttle::exception::FileInSequenceNotExist& e) // @todo tuttle: change that.
+    {
+        e << tuttle::exception::time(time);
+        if(_options.getContinueOnError() || _options.getContinueOnMissingFile())
+        {
+            TUTTLE_LOG_WARNING("[Process render] Missing input file at frame " << time << "." << std::endl);
+            TUTTLE_LOG_DEBUG(tuttle::exception::format_exception_message(e)
+                             << std::endl
+                             << tuttle::exception::format_exception_info(e));
+            return true;
+        }
+        TUTTLE_LOG_ERROR("[Process render] Missing input file at frame " << time << "." << std::endl);
+    }
+    catch(::boost::exception& e)
+    {
+        e << tuttle::exception::time(time);
+        if(_options.getContinueOnError())
+        {
+            TUTTLE_LOG_ERROR("[Process render] Skip frame " << time << "." << std::endl);
+            TUTTLE_LOG_DEBUG(tuttle::exception::format_exception_message(e)
+                             << std::endl
+                             << tuttle::exception::format_exception_info(e));
+            return true;
+        }
+        TUTTLE_LOG_ERROR("[Process render] Stopped at frame " << time << "." << std::endl);
+    }
+    catch(...)
+    {
+        if(_options.getContinueOnError())
+        {
+            TUTTLE_LOG_ERROR("[Process render] Skip frame " << time << "." << std::endl
+                                                            << tuttle::exception::format_current_exception());
+            return true;
+        }
+        TUTTLE_LOG_ERROR("[Process render] Error at frame " << time << "." << std::endl);
+    }
+    return false;
+}
+
+namespace
+{
+
+void processParallelFrame(ParallelFrame& frame, const boost::function<void()>& processFunction)
+{
+    try
+    {
+        processFunction();
+    }
+    catch(...)
+    {
+        frame._error = boost::current_exception();
+    }
+}
+
+/**
+ * @brief The rendered frames, whose writer nodes may be processed in background.
+ *
+ * The frames are finished in the frames order: their data at time are cleared and their errors are managed.
+ * The frames keep their graph at time and the references on their input images until their writes are done.
+ */
+class PendingFrames
+{
+public:
+    typedef ParallelFrame::InternalGraphAtTimeImpl InternalGraphAtTimeImpl;
+    typedef std::vector<InternalGraphAtTimeImpl::vertex_descriptor> Writes;
+    typedef boost::function<void(InternalGraphAtTimeImpl&, const Writes&)> WriteFunction;
+    typedef boost::function<bool(const OfxTime)> SkipFrameFunction;
+
+public:
+    /**
+     * @param writeBehindQueue NULL if the writes are not in background
+     * @param maxWrites maximal number of frames whose writes are pending
+     */
+    PendingFrames(const ComputeOptions& options, WriteBehindQueue* writeBehindQueue, const std::size_t maxWrites,
+                  const WriteFunction& write, const SkipFrameFunction& skipFrameOnError)
+        : _options(options)
+        , _writeBehindQueue(writeBehindQueue)
+        , _maxWrites(maxWrites)
+        , _nbWrites(0)
+        , _write(write)
+        , _skipFrameOnError(skipFrameOnError)
+    {
+    }
+
+    /// The writes reference the frames.
+    ~PendingFrames()
+    {
+        if(_writeBehindQueue)
+            _writeBehindQueue->wait();
+    }
+
+    /// @brief Add a frame rendered, and launch its writes.
+    void push(const ParallelFrame& frame)
+    {
+        _frames.push_back(frame);
+        ParallelFrame& pending = _frames.back();
+        if(!_writeBehindQueue || pending._error || pending._writes.empty() || _error)
+            return;
+        const boost::function<void()> writeFunction =
+            boost::bind(_write, boost::ref(*pending._graphAtTime), boost::cref(pending._writes));
+        pending._writeId =
+            _writeBehindQueue->push(boost::bind(&processParallelFrame, boost::ref(pending), writeFunction));
+        pending._isWriting = true;
+        ++_nbWrites;
+    }
+
+    /**
+     * @brief Finish the frames in order, while their writes are done or to respect the maximal number of writes.
+     * @param all wait all the writes
+     */
+    void finish(const bool all)
+    {
+        while(!_frames.empty())
+        {
+            ParallelFrame& frame = _frames.front();
+            if(frame._isWriting)
+            {
+                if(!all && _nbWrites <= _maxWrites && !_writeBehindQueue->isDone(frame._writeId))
+                    return;
+                _writeBehindQueue->wait(frame._writeId);
+                --_nbWrites;
+            }
+
+            clearProcessDataAtTime(*frame._graphAtTime);
+            if(frame._error && !_error)
+            {
+                try
+                {
+                    boost::rethrow_exception(frame._error);
+                }
+                catch(...)
+                {
+                    if(!_skipFrameOnError(frame._time))
+                        _error = boost::current_exception();
+                }
+            }
+            _options.endFrameHandle();
+            _frames.pop_front();
+        }
+    }
+
+    /**
+     * @brief Finish all the frames if one of them uses a node at time of @p graphAtTime:
+     * the data of a node at a time are replaced by the setup.
+     */
+    void finishSharedNodes(InternalGraphAtTimeImpl& graphAtTime)
+    {
+        std::set<ProcessVertexAtTime::Key> keys;
+        BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, graphAtTime.getVertices())
+        {
+            keys.insert(graphAtTime.instance(vd).getKey());
+        }
+        BOOST_FOREACH(ParallelFrame& frame, _frames)
+        {
+            BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, frame._graphAtTime->getVertices())
+            {
+                if(keys.count(frame._graphAtTime->instance(vd).getKey()))
+                {
+                    finish(true);
+                    return;
+                }
+            }
+        }
+    }
+
+    /// @brief The error which stops the process, if any.
+    const boost::exception_ptr& getError() const { return _error; }
+
+private:
+    const ComputeOptions& _options;
+    WriteBehindQueue* _writeBehindQueue;
+    const std::size_t _maxWrites;
+    std::size_t _nbWrites; ///< number of frames in the WriteBehindQueue
+    WriteFunction _write;
+    SkipFrameFunction _skipFrameOnError;
+    std::list<ParallelFrame> _frames;
+    boost::exception_ptr _error;
+};
+}
+
+bool ProcessGraph::processParallelFrames(memory::IMemoryCache& outCache, const std::vector<OfxTime>& frames,
+                                         const std::size_t nbParallelFrames)
+{
+    TUTTLE_LOG_INFO("[Process render] render up to " << nbParallelFrames << " frames in parallel");
+    const std::size_t nbWriteBehindFrames = _options.getNbWriteBehindFrames();
+    _writeBehindQueue.reset(nbWriteBehindFrames ? new WriteBehindQueue(nbWriteBehindFrames) : NULL);
+    if(nbWriteBehindFrames)
+        TUTTLE_LOG_INFO("[Process render] write up to " << nbWriteBehindFrames << " frames in background");
+    PendingFrames pendingFrames(_options, _writeBehindQueue.get(), nbWriteBehindFrames,
+                                boost::bind(&ProcessGraph::writeGraphAtTime, this, _1, boost::ref(outCache), _2),
+                                boost::bind(&ProcessGraph::skipFrameOnError, this, _1));
+
+    std::size_t nextFrame = 0;
+    while(nextFrame < frames.size())
+    {
+        // Setup a group of frames, sequentially.
+        // Frames of a group use different nodes at time and the same clip connections.
+        std::vector<ParallelFrame> group;
+        std::set<VertexAtTime::Key> groupKeys;
+        ParallelFrame::ClipConnections groupConnections;
+        std::size_t maxGroupSize = nbParallelFrames;
+        boost::exception_ptr setupError;
+
+        while(nextFrame < frames.size() && group.size() < maxGroupSize)
+        {
+            ParallelFrame frame(frames[nextFrame]);
+            InternalGraphAtTimeImpl& graphAtTime = *frame._graphAtTime;
+
+            if(!group.empty())
+            {
+                buildGraphAtTime(graphAtTime, frame._time);
+                bool sharedKey = false;
+                BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, graphAtTime.getVertices())
+                {
+                    if(groupKeys.count(graphAtTime.instance(vd).getKey()))
+                    {
+                        sharedKey = true;
+                        break;
+                    }
+                }
+                if(sharedKey)
+                    break; // this frame will be the first one of the next group
+            }
+
+            _options.beginFrameHandle();
+            _options.setupAtTimeHandle();
+            try
+            {
+                if(group.empty())
+                    buildGraphAtTime(graphAtTime, frame._time);
+                pendingFrames.finishSharedNodes(graphAtTime);
+                if(!pendingFrames.getError())
+                    setupGraphAtTime(graphAtTime, frame._time);
+            }
+            catch(...)
+            {
+                clearProcessDataAtTime(graphAtTime);
+                if(!skipFrameOnError(frame._time))
+                    setupError = boost::current_exception();
+                _options.endFrameHandle();
+                ++nextFrame;
+                if(!group.empty())
+                    connectClipsAtTime(*group.front()._graphAtTime);
+                if(setupError)
+                    break;
+                continue;
+            }
+            if(pendingFrames.getError())
+            {
+                // a previous frame stops the process
+                _options.endFrameHandle();
+                break;
+            }
+
+            const ParallelFrame::ClipConnections connections = getClipConnections(graphAtTime);
+            if(group.empty())
+            {
+                groupConnections = connections;
+
+                // Respect the MemoryPool budget
+                std::size_t frameMemory = 0;
+                BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, graphAtTime.getVertices())
+                {
+                    VertexAtTime& v = graphAtTime.instance(vd);
+                    if(v.isFake())
+                        continue;
+                    ProcessVertexAtTimeInfo infos;
+                    v.getProcessNode().preProcess_infos(v.getProcessDataAtTime(), frame._time, infos);
+                    frameMemory += infos._memory;
+                }
+                if(frameMemory)
+                {
+                    const std::size_t availableMemory = core().getMemoryPool().getAvailableMemorySize();
+                    maxGroupSize = std::max(std::size_t(1), std::min(nbParallelFrames, availableMemory / frameMemory));
+                }
+            }
+            else if(connections != groupConnections)
+            {
+                // The identity nodes differ from the group: restore the group connections,
+                // this frame will be setup again in the next group.
+                clearProcessDataAtTime(graphAtTime);
+                connectClipsAtTime(*group.front()._graphAtTime);
+                break;
+            }
+
+            BOOST_FOREACH(const InternalGraphAtTimeImpl::vertex_descriptor vd, graphAtTime.getVertices())
+            {
+                groupKeys.insert(graphAtTime.instance(vd).getKey());
+            }
+            group.push_back(frame);
+            ++nextFrame;
+        }
+
+        // Process the group, one thread per frame
+        BOOST_FOREACH(ParallelFrame& frame, group)
+        {
+            _options.processAtTimeHandle();
+            try
+            {
+                beforeRenderGraphAtTime(*frame._graphAtTime, frame._time);
+            }
+            catch(...)
+            {
+                frame._error = boost::current_exception();
+            }
+        }
+        {
+            boost::thread_group threads;
+            BOOST_FOREACH(ParallelFrame& frame, group)
+            {
+                if(frame._error)
+                    continue;
+                const boost::function<void()> processFunction =
+                    boost::bind(&ProcessGraph::processGraphAtTime, this, boost::ref(*frame._graphAtTime),
+                                boost::ref(outCache), frame._time, _writeBehindQueue ? &frame._writes : NULL);
+                threads.create_thread(boost::bind(&processParallelFrame, boost::ref(frame), processFunction));
+            }
+            threads.join_all();
+        }
+
+        // Errors are managed in the frames order, the frames written in background are finished later
+        BOOST_FOREACH(const ParallelFrame& frame, group)
+        {
+            pendingFrames.push(frame);
+        }
+        pendingFrames.finish(false);
+        if(!_options.getRenderCache())
+            _internMemoryCache.clearUnused();
+
+        const boost::exception_ptr processError = pendingFrames.getError();
+        if(processError || setupError)
+        {
+            pendingFrames.finish(true);
+            endSequence();
+            _internMemoryCache.clearUnused();
+            boost::rethrow_exception(processError ? processError : setupError);
+        }
+
+        if(_options.getAbort())
+        {
+            TUTTLE_LOG_ERROR("[Process render] PROCESS ABORTED at time " << frames[nextFrame - 1] << ".");
+            pendingFrames.finish(true);
+            endSequence();
+            _internMemoryCache.clearUnused();
+            return false;
+        }
+    }
+
+    pendingFrames.finish(true);
+    if(pendingFrames.getError())
+    {
+        endSequence();
+        _internMemoryCache.clearUnused();
+        boost::rethrow_exception(pendingFrames.getError());
+    }
+    endSequence();
+    return true;
 }
 
 bool ProcessGraph::process(memory::IMemoryCache& outCache)
@@ -616,6 +1520,23 @@ bool ProcessGraph::process(memory::IMemoryCache& outCache)
     TUTTLE_LOG_TRACE("[Process render] begin timeRange: [" << globalTimeRange._begin << ", " << globalTimeRange._end << "]");
     beginSequence(globalTimeRange);
 
+    const std::size_t nbParallelFrames = getNbParallelFrames();
+    // the writes in background need a graph at time per frame
+    if(nbParallelFrames > 1 || _options.getNbWriteBehindFrames())
+    {
+        std::vector<OfxTime> frames;
+        BOOST_FOREACH(const TimeRange& timeRange, timeRanges)
+        {
+            for(int time = timeRange._begin; time <= timeRange._end; time += timeRange._step)
+                frames.push_back(time);
+        }
+        const bool completed = processParallelFrames(outCache, frames, nbParallelFrames);
+#if(TUTTLE_EXPORT_WITH_TIMER)
+        TUTTLE_LOG_INFO("[all process timer] " << boost::timer::format(all_process_timer.elapsed()));
+#endif
+        return completed;
+    }
+
     // RENDER (at each frame)
     BOOST_FOREACH(const TimeRange& timeRange, timeRanges)
     {
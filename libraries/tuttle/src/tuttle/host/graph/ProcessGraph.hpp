@@ -10,8 +10,13 @@
 
 #include <tuttle/host/Graph.hpp>
 #include <tuttle/host/NodeHashContainer.hpp>
+#include <tuttle/host/diskCache/RenderDiskCache.hpp>
+#include <tuttle/host/WriteBehindQueue.hpp>
+
+#include <boost/scoped_ptr.hpp>
 
 #include <string>
+#include <vector>
 
 /**
  * @brief If there is a define PROCESSGRAPH_USE_LINK, we don't create a copy of all nodes and
@@ -62,6 +67,53 @@ private:
 
     void relink();
     void bakeGraphInformationToNodes(InternalGraphAtTimeImpl& renderGraphAtTime);
+    /**
+     * @brief Connect the clips of the nodes like in @p renderGraphAtTime.
+     * The writes in background use the connections of the nodes, so they are finished before a change.
+     */
+    void connectClipsAtTime(InternalGraphAtTimeImpl& renderGraphAtTime);
+
+    void deployTime(const OfxTime time);
+    std::vector<OfxTime> getTimeOffsets(const OfxTime time) const;
+    void shiftGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime offset);
+    void buildGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time);
+    void fillGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time);
+    bool setupGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time);
+    bool updateGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time);
+    bool optimizeGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time);
+    bool useRenderCache(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time);
+    void beforeRenderGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, const OfxTime time);
+    /**
+     * @param writes if not NULL, the writer nodes are not processed but added to @p writes (see writeGraphAtTime)
+     */
+    void processGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, memory::IMemoryCache& outCache,
+                            const OfxTime time,
+                            std::vector<InternalGraphAtTimeImpl::vertex_descriptor>* writes = NULL);
+    /**
+     * @brief Process the writer nodes @p writes skipped by processGraphAtTime.
+     */
+    void writeGraphAtTime(InternalGraphAtTimeImpl& renderGraphAtTime, memory::IMemoryCache& outCache,
+                          const std::vector<InternalGraphAtTimeImpl::vertex_descriptor>& writes);
+
+    /**
+     * @brief Number of frames to render at the same time, from the ComputeOptions and the nodes capabilities.
+     */
+    std::size_t getNbParallelFrames() const;
+
+    /**
+     * @brief Log the current exception which occured at @p time.
+     * @return true if the options allow to skip this frame and continue the process.
+     */
+    bool skipFrameOnError(const OfxTime time) const;
+
+    /**
+     * @brief Render the frames by groups of frames processed at the same time.
+     * The setup of each group is done sequentially, only the process of the frames is parallel.
+     * The writer nodes can be processed in background, during the render of the next groups
+     * (see ComputeOptions::setNbWriteBehindFrames).
+     */
+    bool processParallelFrames(memory::IMemoryCache& outCache, const std::vector<OfxTime>& frames,
+                               const std::size_t nbParallelFrames);
 
 public:
     void updateGraph(Graph& userGraph, const std::list<std::string>& outputNodes);
@@ -88,6 +140,17 @@ private:
     const ComputeOptions& _options;
     memory::IMemoryCache& _internMemoryCache;
     ProcessVertexData _procOptions;
+    RenderDiskCache _renderDiskCache;
+
+    /// @group Incremental setup of _renderGraphAtTime
+    /// @{
+    std::vector<OfxTime> _graphAtTimeOffsets; ///< time dependencies of the current graph at time
+    OfxTime _graphAtTimeTime;
+    bool _isGraphAtTimeReusable;
+    bool _isTemporalAccessUsed; ///< a node may need other frames than the current one, see deployTime
+    /// @}
+
+    boost::scoped_ptr<WriteBehindQueue> _writeBehindQueue; ///< writes in background of processParallelFrames
 };
 }
 }
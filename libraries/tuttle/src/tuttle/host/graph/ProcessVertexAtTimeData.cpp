@@ -28,6 +28,7 @@ std::ostream& operator<<(std::ostream& os, const ProcessVertexAtTimeData& vData)
 
     os << "out degree:" << vData._outDegree << std::endl;
     os << "in degree:" << vData._inDegree << std::endl;
+    os << "render in place:" << vData._renderInPlace << std::endl;
 
     os << "__________" << std::endl;
     os << "localInfos:" << std::endl << vData._localInfos;
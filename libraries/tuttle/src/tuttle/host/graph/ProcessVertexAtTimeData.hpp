@@ -53,6 +53,10 @@ public:
         , _isFinalNode(false)
         , _outDegree(0)
         , _inDegree(0)
+        , _localHash(0)
+        , _globalHash(0)
+        , _isGlobalHashPersistent(false)
+        , _renderInPlace(false)
     {
         _localInfos._nodes = 1; // local infos can contain only 1 node by definition...
     }
@@ -63,6 +67,10 @@ public:
         , _isFinalNode(false)
         , _outDegree(0)
         , _inDegree(0)
+        , _localHash(0)
+        , _globalHash(0)
+        , _isGlobalHashPersistent(false)
+        , _renderInPlace(false)
     {
         _localInfos._nodes = 1; // local infos can contain only 1 node by definition...
     }
@@ -86,6 +94,12 @@ public:
         _inputsInfos = v._inputsInfos;
         _globalInfos = v._globalInfos;
 
+        _localHash = v._localHash;
+        _globalHash = v._globalHash;
+        _isGlobalHashPersistent = v._isGlobalHashPersistent;
+        _cachedOutput = v._cachedOutput;
+        _renderInPlace = v._renderInPlace;
+
         _apiImageEffect = v._apiImageEffect;
 
         return *this;
@@ -122,6 +136,12 @@ public:
     ProcessVertexAtTimeInfo _inputsInfos;
     ProcessVertexAtTimeInfo _globalInfos;
 
+    std::size_t _localHash;             ///< hash of the node parameters at _time, 0 if not computed
+    std::size_t _globalHash;            ///< hash of the node and all its inputs, 0 if not computed
+    bool _isGlobalHashPersistent; ///< the files read by the node and its inputs are identified by the hash
+    memory::CACHE_ELEMENT _cachedOutput; ///< output computed by a previous render with the same hash
+    bool _renderInPlace; ///< the output reuses the buffer of the single input, see FusePointWiseNodes
+
     /// @group API Specific datas
     /// @{
     /**
@@ -12,6 +12,8 @@ namespace tuttle
 {
 namespace host
 {
+class RenderDiskCache;
+
 namespace graph
 {
 
@@ -22,6 +24,7 @@ class ProcessVertexData
 public:
     ProcessVertexData(memory::IMemoryCache* internMemoryCache, const INode::ENodeType apiType = INode::eNodeTypeUnknown)
         : _internMemoryCache(internMemoryCache)
+        , _renderDiskCache(NULL)
         , _apiType(apiType)
         , _step(1)
         , _interactive(0)
@@ -52,6 +55,7 @@ public:
 
 public:
     memory::IMemoryCache* _internMemoryCache;
+    RenderDiskCache* _renderDiskCache; ///< persistent cache of the node outputs, NULL if disabled
 
     // const GraphProcessData& _data; /// @todo tuttle: graph common datas, like renderScale
     OfxPointD _renderScale;
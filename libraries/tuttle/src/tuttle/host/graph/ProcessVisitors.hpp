@@ -13,6 +13,7 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/unordered_map.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -190,7 +191,10 @@ public:
         if(vertex.isFake())
             return;
 
-        const std::size_t localHash = vertex.getProcessNode().getLocalHashAtTime(_time);
+        // the vertex may be needed at another time than the rendered one (time offsets)
+        const OfxTime vertexTime = vertex.getProcessDataAtTime()._time;
+        const std::size_t localHash = vertex.getProcessNode().getLocalHashAtTime(vertexTime);
+        bool isGlobalHashPersistent = vertex.getProcessNode().isLocalHashPersistentAtTime(vertexTime);
 
         typedef std::map<VertexKey, std::size_t> InputsHash;
         InputsHash inputsGlobalHash;
@@ -199,6 +203,8 @@ public:
             const Edge& edge = _graph.instance(ed);
             vertex_descriptor inputVertexDesc = _graph.target(ed);
             Vertex& inputVertex = _graph.instance(inputVertexDesc);
+            isGlobalHashPersistent =
+                isGlobalHashPersistent && inputVertex.getProcessDataAtTime()._isGlobalHashPersistent;
 
             const std::size_t inputGlobalHash = _outNodesHash.getHash(inputVertex.getKey());
             // Key is: (clipName, time)
@@ -215,6 +221,7 @@ public:
             boost::hash_combine(seed, inputGlobalHash.second);
         }
         _outNodesHash.addHash(vertex.getKey(), seed);
+        vertex.getProcessDataAtTime()._isGlobalHashPersistent = isGlobalHashPersistent;
         // TUTTLE_LOG_VAR( TUTTLE_TRACE, localHash );
         // TUTTLE_LOG_VAR2( TUTTLE_TRACE, vertex.getKey(), seed );
     }
@@ -623,32 +630,50 @@ private:
     TGraph& _graph;
 };
 
+/**
+ * @brief Collect the vertices in finish order, so the inputs of a node are always before the node.
+ * The RoI are propagated in the reverse order: a node knows what all its outputs need
+ * before asking the RoI of its own inputs.
+ */
 template <class TGraph>
 class PreProcess2 : public boost::default_dfs_visitor
 {
 public:
     typedef typename TGraph::GraphContainer GraphContainer;
     typedef typename TGraph::Vertex Vertex;
+    typedef typename TGraph::vertex_descriptor vertex_descriptor;
 
-    PreProcess2(TGraph& graph)
+    PreProcess2(TGraph& graph, std::vector<vertex_descriptor>& finishOrder)
         : _graph(graph)
+        , _finishOrder(finishOrder)
     {
     }
 
     template <class VertexDescriptor, class Graph>
-    void discover_vertex(VertexDescriptor v, Graph& g)
+    void finish_vertex(VertexDescriptor v, Graph& g)
     {
-        Vertex& vertex = _graph.instance(v);
+        TUTTLE_LOG_TRACE("[Preprocess 2] finish vertex " << _graph.instance(v));
+        _finishOrder.push_back(v);
+    }
 
-        TUTTLE_LOG_TRACE("[Preprocess 2] discover vertex " << vertex);
-        if(vertex.isFake())
-            return;
+    /**
+     * @brief Call preProcess2_reverse on all visited vertices, from the output to the inputs.
+     */
+    void processReverse()
+    {
+        BOOST_REVERSE_FOREACH(const vertex_descriptor v, _finishOrder)
+        {
+            Vertex& vertex = _graph.instance(v);
+            if(vertex.isFake())
+                continue;
 
-        vertex.getProcessNode().preProcess2_reverse(vertex.getProcessDataAtTime());
+            vertex.getProcessNode().preProcess2_reverse(vertex.getProcessDataAtTime());
+        }
     }
 
 private:
     TGraph& _graph;
+    std::vector<vertex_descriptor>& _finishOrder;
 };
 
 template <class TGraph>
@@ -708,17 +733,80 @@ private:
     TGraph& _graph;
 };
 
+/**
+ * @brief Render the chains of point-wise nodes in a single image buffer.
+ *
+ * A point-wise node (e.g. a color correction) renders its output in the buffer of its single input,
+ * if this input is not used by another node. A chain of point-wise nodes only allocates the buffer
+ * of the first input. The images compatibility (bounds, pixel format) is checked by the node process.
+ */
+template <class TGraph>
+class FusePointWiseNodes : public boost::default_dfs_visitor
+{
+public:
+    typedef typename TGraph::Vertex Vertex;
+    typedef typename TGraph::Edge Edge;
+    typedef typename TGraph::vertex_descriptor vertex_descriptor;
+    typedef typename TGraph::edge_descriptor edge_descriptor;
+
+    FusePointWiseNodes(TGraph& graph)
+        : _graph(graph)
+        , _nbFusedNodes(0)
+    {
+    }
+
+    template <class VertexDescriptor, class Graph>
+    void finish_vertex(VertexDescriptor vd, Graph& g)
+    {
+        Vertex& vertex = _graph.instance(vd);
+        if(vertex.isFake())
+            return;
+
+        ProcessVertexAtTimeData& vData = vertex.getProcessDataAtTime();
+        vData._renderInPlace = false;
+        if(vData._inDegree != 1 || vData._cachedOutput.get() != NULL)
+            return;
+        if(vertex.getProcessNode().getNodeType() != INode::eNodeTypeImageEffect ||
+           !vertex.getProcessNode().asImageEffectNode().isPointWise())
+            return;
+
+        BOOST_FOREACH(const edge_descriptor& ed, _graph.getOutEdges(vd))
+        {
+            const Vertex& input = _graph.targetInstance(ed);
+            if(input.isFake() || input.getProcessNode().getNodeType() != INode::eNodeTypeImageEffect)
+                return;
+            const ProcessVertexAtTimeData& inputData = input.getProcessDataAtTime();
+            // The input buffer is modified, so it can't be used by another node, returned as a result
+            // or shared with the render cache.
+            if(inputData._outDegree != 1 || inputData._isFinalNode || inputData._time != vData._time ||
+               inputData._globalHash != 0 || inputData._cachedOutput.get() != NULL)
+                return;
+        }
+        TUTTLE_LOG_TRACE("[Fuse point-wise nodes] render in place " << vertex);
+        vData._renderInPlace = true;
+        ++_nbFusedNodes;
+    }
+
+    std::size_t getNbFusedNodes() const { return _nbFusedNodes; }
+
+private:
+    TGraph& _graph;
+    std::size_t _nbFusedNodes;
+};
+
 template <class TGraph>
 class Process : public boost::default_dfs_visitor
 {
 public:
     typedef typename TGraph::GraphContainer GraphContainer;
     typedef typename TGraph::Vertex Vertex;
+    typedef typename TGraph::vertex_descriptor vertex_descriptor;
 
     Process(TGraph& graph, memory::IMemoryCache& cache)
         : _graph(graph)
         , _cache(cache)
         , _result(NULL)
+        , _writes(NULL)
     {
     }
 
@@ -726,6 +814,7 @@ public:
         : _graph(graph)
         , _cache(cache)
         , _result(&result)
+        , _writes(NULL)
     {
     }
 
@@ -734,6 +823,13 @@ public:
      */
     void setOutputMemoryCache(memory::IMemoryCache& result) { _result = &result; }
 
+    /**
+     * Don't process the writer nodes without consumers, their vertices are added to @p writes to be processed
+     * in background with processVertex (see ComputeOptions::setNbWriteBehindFrames).
+     * The writers chained to other nodes (copy to output) are processed as the other nodes.
+     */
+    void setWriteBehind(std::vector<vertex_descriptor>& writes) { _writes = &writes; }
+
     template <class VertexDescriptor, class Graph>
     void finish_vertex(VertexDescriptor v, Graph& g)
     {
@@ -745,8 +841,31 @@ public:
         if(vertex.isFake())
             return;
 
+        if(_writes && isWriteBehind(vertex))
+        {
+            TUTTLE_LOG_TRACE("[Process] write behind " << vertex);
+            _writes->push_back(v);
+            return;
+        }
+
         // check if abort ?
 
+        processVertex(vertex);
+    }
+
+    /// @brief The vertex is a writer and its output is not used by another node.
+    bool isWriteBehind(const Vertex& vertex) const
+    {
+        if(vertex.getProcessNode().getNodeType() != INode::eNodeTypeImageEffect ||
+           !vertex.getProcessNode().asImageEffectNode().isWriteBehind())
+            return false;
+        // _outDegree counts the nodes using the output, and the output of the graph for the final nodes
+        const ProcessVertexAtTimeData& vData = vertex.getProcessDataAtTime();
+        return vData._outDegree == (vData._isFinalNode ? 1u : 0u);
+    }
+
+    void processVertex(Vertex& vertex)
+    {
         // launch the process
         boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
         vertex.getProcessNode().process(vertex.getProcessDataAtTime());
@@ -776,6 +895,7 @@ private:
     TGraph& _graph;
     memory::IMemoryCache& _cache;
     memory::IMemoryCache* _result;
+    std::vector<vertex_descriptor>* _writes;
     boost::posix_time::time_duration _cumulativeTime;
 };
 
@@ -785,12 +905,19 @@ class PostProcess : public boost::default_dfs_visitor
 public:
     typedef typename TGraph::GraphContainer GraphContainer;
     typedef typename TGraph::Vertex Vertex;
+    typedef typename TGraph::vertex_descriptor vertex_descriptor;
 
     PostProcess(TGraph& graph)
         : _graph(graph)
+        , _writes(NULL)
     {
     }
 
+    /**
+     * The vertices @p writes are not processed yet, they are post-processed after their process in background.
+     */
+    void setWriteBehind(const std::vector<vertex_descriptor>& writes) { _writes = &writes; }
+
     template <class VertexDescriptor, class Graph>
     void initialize_vertex(VertexDescriptor v, Graph& g)
     {
@@ -809,12 +936,15 @@ public:
         TUTTLE_LOG_TRACE("[Post-process] finish_vertex " << vertex);
         if(vertex.isFake())
             return;
+        if(_writes && std::find(_writes->begin(), _writes->end(), v) != _writes->end())
+            return;
 
         vertex.getProcessNode().postProcess(vertex.getProcessDataAtTime());
     }
 
 private:
     TGraph& _graph;
+    const std::vector<vertex_descriptor>* _writes;
 };
 
 template <class TGraph>
@@ -0,0 +1,117 @@
+#include "Allocator.hpp"
+
+#include <tuttle/common/system/system.hpp>
+#include <tuttle/common/utils/global.hpp>
+
+#include <algorithm>
+#include <new>
+#include <cstdlib>
+
+#ifdef __WINDOWS__
+#include <malloc.h>
+#elif defined(__UNIX__)
+#include <sys/mman.h>
+#endif
+
+namespace tuttle
+{
+namespace host
+{
+namespace memory
+{
+
+namespace
+{
+
+char* allocateAligned(const std::size_t size)
+{
+#ifdef __WINDOWS__
+    void* data = _aligned_malloc(size, kMemoryAlignment);
+#else
+    void* data = NULL;
+    if(posix_memalign(&data, kMemoryAlignment, size) != 0)
+        data = NULL;
+#endif
+    if(data == NULL)
+        throw std::bad_alloc();
+    return static_cast<char*>(data);
+}
+
+void freeAligned(char* data)
+{
+#ifdef __WINDOWS__
+    _aligned_free(data);
+#else
+    free(data);
+#endif
+}
+
+#if defined(__UNIX__) && defined(MAP_ANONYMOUS)
+#define TUTTLE_MEMORY_WITH_MMAP
+
+char* allocateMmap(const std::size_t size, const bool hugePages)
+{
+    // the pages are only mapped at the first write, by the thread which renders the image
+    void* data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(data == MAP_FAILED)
+        throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    if(hugePages && madvise(data, size, MADV_HUGEPAGE) != 0)
+    {
+        TUTTLE_LOG_DEBUG("[Memory Pool] transparent huge pages not available");
+    }
+#endif
+    return static_cast<char*>(data);
+}
+#endif
+}
+
+char* allocateBuffer(const EMemoryAllocator allocator, std::size_t size)
+{
+    // empty buffers still need a valid address
+    size = std::max(size, std::size_t(1));
+    switch(allocator)
+    {
+#ifdef TUTTLE_MEMORY_WITH_MMAP
+        case eMemoryAllocatorMmap:
+            return allocateMmap(size, false);
+        case eMemoryAllocatorHugePages:
+            return allocateMmap(size, true);
+#endif
+        default:
+            return allocateAligned(size);
+    }
+}
+
+void freeBuffer(const EMemoryAllocator allocator, char* data, std::size_t size)
+{
+    size = std::max(size, std::size_t(1));
+    switch(allocator)
+    {
+#ifdef TUTTLE_MEMORY_WITH_MMAP
+        case eMemoryAllocatorMmap:
+        case eMemoryAllocatorHugePages:
+            munmap(data, size);
+            break;
+#endif
+        default:
+            freeAligned(data);
+    }
+}
+
+std::string mapMemoryAllocatorEnumToString(const EMemoryAllocator allocator)
+{
+    switch(allocator)
+    {
+        case eMemoryAllocatorAligned:
+            return "aligned";
+        case eMemoryAllocatorMmap:
+            return "mmap";
+        case eMemoryAllocatorHugePages:
+            return "huge pages";
+    }
+    return "unknown";
+}
+}
+}
+}
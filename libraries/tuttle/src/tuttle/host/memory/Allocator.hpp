@@ -0,0 +1,44 @@
+#ifndef _TUTTLE_HOST_CORE_ALLOCATOR_HPP_
+#define _TUTTLE_HOST_CORE_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <string>
+
+namespace tuttle
+{
+namespace host
+{
+namespace memory
+{
+
+/**
+ * @brief Allocation backends of the MemoryPool buffers.
+ */
+enum EMemoryAllocator
+{
+    eMemoryAllocatorAligned = 0, ///< heap allocation aligned on kMemoryAlignment bytes
+    eMemoryAllocatorMmap,        ///< anonymous mmap, the pages are placed on the NUMA node of their first writer
+    eMemoryAllocatorHugePages    ///< anonymous mmap with transparent huge pages
+};
+
+/// minimal alignment of the buffers, enough for SIMD instructions
+static const std::size_t kMemoryAlignment = 64;
+
+/**
+ * @brief Allocate @p size bytes with the @p allocator backend.
+ * On systems without mmap, the mmap backends use the aligned allocation.
+ * @exception std::bad_alloc
+ */
+char* allocateBuffer(const EMemoryAllocator allocator, const std::size_t size);
+
+/**
+ * @brief Free a buffer allocated by allocateBuffer with the same @p allocator and @p size.
+ */
+void freeBuffer(const EMemoryAllocator allocator, char* data, const std::size_t size);
+
+std::string mapMemoryAllocatorEnumToString(const EMemoryAllocator allocator);
+}
+}
+}
+
+#endif
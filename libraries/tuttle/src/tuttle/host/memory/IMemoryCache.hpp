@@ -55,7 +55,10 @@ public:
     virtual ~IMemoryCache() = 0;
     /// @todo tuttle: use key here, instead of (name, time)
     virtual void put(const std::string& identifier, const double time, CACHE_ELEMENT pData) = 0;
+    /// put an element which can also be found with the hash of the node which computed it
+    virtual void put(const std::string& identifier, const double time, const std::size_t hash, CACHE_ELEMENT pData) = 0;
     virtual CACHE_ELEMENT get(const std::string& identifier, const double time) const = 0;
+    virtual CACHE_ELEMENT getByHash(const std::size_t hash) const = 0;
     virtual CACHE_ELEMENT getUnusedWithSize(const std::size_t requestedSize) const = 0;
     virtual std::size_t size() const = 0;
     virtual bool empty() const = 0;
@@ -64,6 +67,8 @@ public:
     virtual const std::string& getPluginName(const CACHE_ELEMENT&) const = 0;
     virtual bool remove(const CACHE_ELEMENT&) = 0;
     virtual void clearUnused() = 0;
+    /// remove unused elements, least recently used first, until @p size bytes are released
+    virtual void clearUnused(const std::size_t size) = 0;
     virtual void clearAll() = 0;
     virtual std::ostream& outputStream(std::ostream& os) const = 0;
     friend std::ostream& operator<<(std::ostream& os, const This& v);
@@ -51,6 +51,9 @@ public:
     virtual void clear(size_t size) = 0;
     virtual void clearOne() = 0;
     virtual void clear() = 0;
+    virtual void trim(const std::size_t highWaterMark) = 0;
+    virtual void startTrimmer(const std::size_t highWaterMark, const std::size_t periodMs) = 0;
+    virtual void stopTrimmer() = 0;
     virtual IPoolDataPtr allocate(const size_t size) = 0;
     virtual std::size_t updateMemoryAuthorizedWithRAM() = 0;
 };
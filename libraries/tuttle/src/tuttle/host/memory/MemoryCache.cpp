@@ -4,6 +4,7 @@
 #include <boost/foreach.hpp>
 
 #include <functional>
+#include <map>
 
 namespace tuttle
 {
@@ -21,42 +22,11 @@ bool isUnused(const CACHE_ELEMENT& cacheElement)
     return cacheElement->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerHost) < 1;
 }
 
-/// Functor to get the smallest unused element in cache
-struct UnusedDataFitSize : public std::unary_function<CACHE_ELEMENT*, void>
+/// Check if the cache element can be removed to release its memory.
+bool isUnusedData(const CACHE_ELEMENT& cacheElement)
 {
-    UnusedDataFitSize(std::size_t size)
-        : _sizeNeeded(size)
-        , _bestMatchDiff(ULONG_MAX)
-        , _pBestMatch()
-    {
-    }
-
-    void operator()(const std::pair<Key, CACHE_ELEMENT>& pData)
-    {
-        // used data
-        if(!isUnused(pData.second))
-            return;
-
-        const std::size_t bufferSize = pData.second->getPoolData()->reservedSize();
-
-        // Check minimum amount of memory
-        if(_sizeNeeded > bufferSize)
-            return;
-
-        const std::size_t diff = bufferSize - _sizeNeeded;
-        if(diff >= _bestMatchDiff)
-            return;
-        _bestMatchDiff = diff;
-        _pBestMatch = pData.second;
-    }
-
-    CACHE_ELEMENT bestMatch() { return _pBestMatch; }
-
-private:
-    const std::size_t _sizeNeeded;
-    std::size_t _bestMatchDiff;
-    CACHE_ELEMENT _pBestMatch;
-};
+    return cacheElement.get() != NULL && cacheElement->getPoolData() && isUnused(cacheElement);
+}
 }
 
 MemoryCache& MemoryCache::operator=(const MemoryCache& cache)
@@ -66,13 +36,32 @@ MemoryCache& MemoryCache::operator=(const MemoryCache& cache)
     boost::mutex::scoped_lock lockerMap1(cache._mutexMap);
     boost::mutex::scoped_lock lockerMap2(_mutexMap);
     _map = cache._map;
+    _hashIndex = cache._hashIndex;
+    _useCount = cache._useCount;
     return *this;
 }
 
 void MemoryCache::put(const std::string& identifier, const double time, CACHE_ELEMENT pData)
+{
+    put(identifier, time, 0, pData);
+}
+
+void MemoryCache::put(const std::string& identifier, const double time, const std::size_t hash, CACHE_ELEMENT pData)
 {
     boost::mutex::scoped_lock lockerMap(_mutexMap);
-    _map[Key(identifier, time)] = pData;
+    const Key key(identifier, time);
+    Entry& entry = _map[key];
+    if(entry._hash != 0 && entry._hash != hash)
+    {
+        boost::unordered_map<std::size_t, Key>::iterator itHash = _hashIndex.find(entry._hash);
+        if(itHash != _hashIndex.end() && itHash->second == key)
+            _hashIndex.erase(itHash);
+    }
+    entry._element = pData;
+    entry._hash = hash;
+    entry._lastUse = _useCount++;
+    if(hash != 0)
+        _hashIndex.insert(std::make_pair(hash, key)).first->second = key;
 }
 
 CACHE_ELEMENT MemoryCache::get(const std::string& identifier, const double time) const
@@ -82,7 +71,21 @@ CACHE_ELEMENT MemoryCache::get(const std::string& identifier, const double time)
 
     if(itr == _map.end())
         return CACHE_ELEMENT();
-    return itr->second;
+    itr->second._lastUse = _useCount++;
+    return itr->second._element;
+}
+
+CACHE_ELEMENT MemoryCache::getByHash(const std::size_t hash) const
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    boost::unordered_map<std::size_t, Key>::const_iterator itHash = _hashIndex.find(hash);
+    if(itHash == _hashIndex.end())
+        return CACHE_ELEMENT();
+    MAP::const_iterator itr = _map.find(itHash->second);
+    if(itr == _map.end() || itr->second._hash != hash)
+        return CACHE_ELEMENT();
+    itr->second._lastUse = _useCount++;
+    return itr->second._element;
 }
 
 CACHE_ELEMENT MemoryCache::get(const std::size_t& i) const
@@ -94,13 +97,38 @@ CACHE_ELEMENT MemoryCache::get(const std::size_t& i) const
 
     if(itr == _map.end())
         return CACHE_ELEMENT();
-    return itr->second;
+    return itr->second._element;
 }
 
+/**
+ * The least recently used element with a buffer which can be reused for @p requestedSize,
+ * or the smallest unused element big enough.
+ */
 CACHE_ELEMENT MemoryCache::getUnusedWithSize(const std::size_t requestedSize) const
 {
     boost::mutex::scoped_lock lockerMap(_mutexMap);
-    return std::for_each(_map.begin(), _map.end(), UnusedDataFitSize(requestedSize)).bestMatch();
+    const Entry* lruMatch = NULL;
+    const Entry* bestMatch = NULL;
+    BOOST_FOREACH(const MAP::value_type& item, _map)
+    {
+        const Entry& entry = item.second;
+        if(!isUnusedData(entry._element))
+            continue;
+
+        const std::size_t bufferSize = entry._element->getPoolData()->reservedSize();
+        // Check minimum amount of memory
+        if(requestedSize > bufferSize)
+            continue;
+        if(bufferSize <= 2 * requestedSize && (!lruMatch || entry._lastUse < lruMatch->_lastUse))
+            lruMatch = &entry;
+        if(!bestMatch || bufferSize < bestMatch->_element->getPoolData()->reservedSize())
+            bestMatch = &entry;
+    }
+    if(lruMatch)
+        return lruMatch->_element;
+    if(bestMatch)
+        return bestMatch->_element;
+    return CACHE_ELEMENT();
 }
 
 std::size_t MemoryCache::size() const
@@ -129,13 +157,13 @@ const std::string EMPTY_STRING = "";
 template <typename T>
 struct FindValuePredicate : public std::unary_function<typename T::value_type, bool>
 {
-    const typename T::mapped_type& _value;
-    FindValuePredicate(const typename T::mapped_type& value)
+    const CACHE_ELEMENT& _value;
+    FindValuePredicate(const CACHE_ELEMENT& value)
         : _value(value)
     {
     }
 
-    bool operator()(const typename T::value_type& pair) { return pair.second == _value; }
+    bool operator()(const typename T::value_type& pair) { return pair.second._element == _value; }
 };
 }
 
@@ -149,6 +177,17 @@ MemoryCache::MAP::iterator MemoryCache::getIteratorForValue(const CACHE_ELEMENT&
     return std::find_if(_map.begin(), _map.end(), FindValuePredicate<MAP>(pData));
 }
 
+MemoryCache::MAP::iterator MemoryCache::erase(MAP::iterator it)
+{
+    if(it->second._hash != 0)
+    {
+        boost::unordered_map<std::size_t, Key>::iterator itHash = _hashIndex.find(it->second._hash);
+        if(itHash != _hashIndex.end() && itHash->second == it->first)
+            _hashIndex.erase(itHash);
+    }
+    return _map.erase(it);
+}
+
 double MemoryCache::getTime(const CACHE_ELEMENT& pData) const
 {
     boost::mutex::scoped_lock lockerMap(_mutexMap);
@@ -172,12 +211,14 @@ const std::string& MemoryCache::getPluginName(const CACHE_ELEMENT& pData) const
 bool MemoryCache::remove(const CACHE_ELEMENT& pData)
 {
     boost::mutex::scoped_lock lockerMap(_mutexMap);
-    const MAP::iterator itr = getIteratorForValue(pData);
-
-    if(itr == _map.end())
-        return false;
-    _map.erase(itr);
-    return true;
+    bool removed = false;
+    // the same element may be used at different times
+    for(MAP::iterator itr = getIteratorForValue(pData); itr != _map.end(); itr = getIteratorForValue(pData))
+    {
+        erase(itr);
+        removed = true;
+    }
+    return removed;
 }
 
 void MemoryCache::clearUnused()
@@ -185,10 +226,9 @@ void MemoryCache::clearUnused()
     boost::mutex::scoped_lock lockerMap(_mutexMap);
     for(MAP::iterator it = _map.begin(); it != _map.end();)
     {
-        if(isUnused(it->second))
+        if(isUnused(it->second._element))
         {
-            _map.erase(
-                it++); // post-increment here, increments 'it' and returns a copy of the original 'it' to be used by erase()
+            it = erase(it);
         }
         else
         {
@@ -197,11 +237,31 @@ void MemoryCache::clearUnused()
     }
 }
 
+void MemoryCache::clearUnused(const std::size_t size)
+{
+    boost::mutex::scoped_lock lockerMap(_mutexMap);
+    std::map<std::size_t, Key> unusedByAge;
+    BOOST_FOREACH(const MAP::value_type& item, _map)
+    {
+        if(isUnusedData(item.second._element))
+            unusedByAge.insert(std::make_pair(item.second._lastUse, item.first));
+    }
+    std::size_t releasedSize = 0;
+    for(std::map<std::size_t, Key>::const_iterator it = unusedByAge.begin();
+        it != unusedByAge.end() && releasedSize < size; ++it)
+    {
+        MAP::iterator itr = _map.find(it->second);
+        releasedSize += itr->second._element->getPoolData()->reservedSize();
+        erase(itr);
+    }
+}
+
 void MemoryCache::clearAll()
 {
     TUTTLE_LOG_DEBUG(" - MEMORYCACHE::CLEARALL - ");
     boost::mutex::scoped_lock lockerMap(_mutexMap);
     _map.clear();
+    _hashIndex.clear();
 }
 
 std::ostream& operator<<(std::ostream& os, const MemoryCache& v)
@@ -209,9 +269,9 @@ std::ostream& operator<<(std::ostream& os, const MemoryCache& v)
     os << "[MemoryCache] size:" << v.size() << std::endl;
     BOOST_FOREACH(const MemoryCache::MAP::value_type& i, v._map)
     {
-        os << "[MemoryCache] " << i.first << " id:" << i.second->getId()
-           << " ref host:" << i.second->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerHost)
-           << " ref plugins:" << i.second->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerPlugin)
+        os << "[MemoryCache] " << i.first << " id:" << i.second._element->getId()
+           << " ref host:" << i.second._element->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerHost)
+           << " ref plugins:" << i.second._element->getReferenceCount(ofx::imageEffect::OfxhImage::eReferenceOwnerPlugin)
            << std::endl;
     }
     return os;
@@ -19,24 +19,47 @@ class MemoryCache : public IMemoryCache
     typedef MemoryCache This;
 
 public:
-    MemoryCache(const MemoryCache& other) { *this = other; }
-    MemoryCache() {}
+    MemoryCache(const MemoryCache& other)
+        : _useCount(0)
+    {
+        *this = other;
+    }
+    MemoryCache()
+        : _useCount(0)
+    {
+    }
     ~MemoryCache() {}
 
     MemoryCache& operator=(const MemoryCache& cache);
 
 private:
-    typedef boost::unordered_map<Key, CACHE_ELEMENT, KeyHash> MAP;
+    struct Entry
+    {
+        Entry()
+            : _hash(0)
+            , _lastUse(0)
+        {
+        }
+        CACHE_ELEMENT _element;
+        std::size_t _hash;            ///< hash of the node which computed the element, 0 if unknown
+        mutable std::size_t _lastUse; ///< access order, for the least recently used eviction
+    };
+    typedef boost::unordered_map<Key, Entry, KeyHash> MAP;
     //	typedef std::map<Key, CACHE_ELEMENT> MAP;
     MAP _map;
-    mutable boost::mutex _mutexMap; ///< Mutex for cache data map.
+    boost::unordered_map<std::size_t, Key> _hashIndex; ///< last element put for each hash
+    mutable std::size_t _useCount;                     ///< access order generator
+    mutable boost::mutex _mutexMap;                    ///< Mutex for cache data map.
 
     MAP::const_iterator getIteratorForValue(const CACHE_ELEMENT&) const;
     MAP::iterator getIteratorForValue(const CACHE_ELEMENT&);
+    MAP::iterator erase(MAP::iterator it);
 
 public:
     void put(const std::string& identifier, const double time, CACHE_ELEMENT pData);
+    void put(const std::string& identifier, const double time, const std::size_t hash, CACHE_ELEMENT pData);
     CACHE_ELEMENT get(const std::string& identifier, const double time) const;
+    CACHE_ELEMENT getByHash(const std::size_t hash) const;
     CACHE_ELEMENT get(const std::size_t& i) const;
     CACHE_ELEMENT getUnusedWithSize(const std::size_t requestedSize) const;
     std::size_t size() const;
@@ -46,6 +69,7 @@ public:
     const std::string& getPluginName(const CACHE_ELEMENT&) const;
     bool remove(const CACHE_ELEMENT&);
     void clearUnused();
+    void clearUnused(const std::size_t size);
     void clearAll();
     std::ostream& outputStream(std::ostream& os) const
     {
@@ -1,4 +1,5 @@
 #include "MemoryPool.hpp"
+#include "Allocator.hpp"
 
 #include <tuttle/common/utils/global.hpp>
 #include <tuttle/common/system/memoryInfo.hpp>
@@ -27,17 +28,19 @@ private:
     friend class MemoryPool;
 
 public:
-    PoolData(IPool& pool, const std::size_t size)
+    PoolData(IPool& pool, const std::size_t size, const EMemoryAllocator allocator)
         : _pool(pool)
         , _id(_count++)
         , _reservedSize(size)
         , _size(size)
-        , _pData(new char[size])
+        , _allocator(allocator)
+        , _pData(allocateBuffer(allocator, size))
         , _refCount(0)
+        , _lastUse(0)
     {
     }
 
-    ~PoolData() { delete[] _pData; }
+    ~PoolData() { freeBuffer(_allocator, _pData, _reservedSize); }
 
 public:
     bool operator==(const PoolData& other) const { return _id == other._id; }
@@ -62,10 +65,26 @@ private:
     const std::size_t _id;           ///< unique id to identify one memory data
     const std::size_t _reservedSize; ///< memory allocated
     std::size_t _size;               ///< memory requested
+    const EMemoryAllocator _allocator; ///< backend used to allocate the data
     char* const _pData;              ///< own the data
     int _refCount;                   ///< counter on clients currently using this data
+    std::size_t _lastUse;            ///< release order of the data, to evict the least recently used
 };
 
+namespace
+{
+/// Predicate on the datas to delete
+struct DataIn
+{
+    DataIn(const boost::unordered_set<PoolData*>& datas)
+        : _datas(datas)
+    {
+    }
+    bool operator()(const PoolData& data) const { return _datas.count(const_cast<PoolData*>(&data)) != 0; }
+    const boost::unordered_set<PoolData*>& _datas;
+};
+}
+
 void intrusive_ptr_add_ref(IPoolData* pData)
 {
     pData->addRef();
@@ -91,12 +110,18 @@ void PoolData::release()
 }
 
 MemoryPool::MemoryPool(const std::size_t maxSize)
-    : _memoryAuthorized(maxSize)
+    : _releaseCount(0)
+    , _usedMemorySize(0)
+    , _unusedMemorySize(0)
+    , _wastedMemorySize(0)
+    , _memoryAuthorized(maxSize)
+    , _stopTrimmer(false)
 {
 }
 
 MemoryPool::~MemoryPool()
 {
+    stopTrimmer();
     if(!_dataUsed.empty())
     {
         TUTTLE_LOG_DEBUG(
@@ -108,11 +133,10 @@ MemoryPool::~MemoryPool()
 void MemoryPool::referenced(PoolData* pData)
 {
     boost::mutex::scoped_lock locker(_mutex);
-    DataList::iterator it = _dataUnused.find(pData);
-
-    if(it != _dataUnused.end())
+    if(_dataUnused.erase(std::make_pair(pData->reservedSize(), pData)))
     {
-        _dataUnused.erase(it);
+        _dataUnusedByAge.erase(pData->_lastUse);
+        _unusedMemorySize -= pData->reservedSize();
     }
     else // a really new data
     {
@@ -120,59 +144,34 @@ void MemoryPool::referenced(PoolData* pData)
         _dataMap[pData->data()] = pData;
     }
     _dataUsed.insert(pData);
+    _usedMemorySize += pData->reservedSize();
+    _wastedMemorySize += pData->reservedSize() - pData->size();
 }
 
 void MemoryPool::released(PoolData* pData)
 {
     boost::mutex::scoped_lock locker(_mutex);
     _dataUsed.erase(pData);
-    _dataUnused.insert(pData);
+    _usedMemorySize -= pData->reservedSize();
+    _wastedMemorySize -= pData->reservedSize() - pData->size();
+    _dataUnused.insert(std::make_pair(pData->reservedSize(), pData));
+    pData->_lastUse = _releaseCount++;
+    _dataUnusedByAge[pData->_lastUse] = pData;
+    _unusedMemorySize += pData->reservedSize();
 }
 
 namespace
 {
-
-/// Functor to get the smallest element in pool
-struct DataFitSize : public std::unary_function<PoolData*, void>
-{
-    DataFitSize(std::size_t size)
-        : _sizeNeeded(size)
-        , _bestMatchDiff(ULONG_MAX)
-        , _pBestMatch(NULL)
-    {
-    }
-
-    void operator()(PoolData* pData)
-    {
-        const std::size_t dataSize = pData->reservedSize();
-
-        // Check minimum amount of memory
-        if(_sizeNeeded > dataSize)
-            return;
-        // Do not reuse too big buffers
-        if(dataSize > _maxBufferRatio * _sizeNeeded)
-            return;
-        const std::size_t diff = dataSize - _sizeNeeded;
-        if(diff >= _bestMatchDiff)
-            return;
-        _bestMatchDiff = diff;
-        _pBestMatch = pData;
-    }
-
-    PoolData* bestMatch() { return _pBestMatch; }
-
-private:
-    static const double _maxBufferRatio; //< max ratio between used and unused part of the buffer
-    const std::size_t _sizeNeeded;
-    std::size_t _bestMatchDiff;
-    PoolData* _pBestMatch;
-};
-
-const double DataFitSize::_maxBufferRatio = 2.0;
+/// Do not reuse too big buffers: max ratio between the reserved size and the requested size
+const std::size_t maxBufferRatio = 2;
 }
 
 IPoolDataPtr MemoryPool::allocate(const std::size_t size)
 {
+    // The buffer is only marked as used when the returned IPoolDataPtr takes a reference,
+    // so the whole allocation is serialized.
+    boost::mutex::scoped_lock allocationLocker(_allocationMutex);
+
     // Try to reuse a buffer available in the MemoryPool
     IPoolData* pData = getOneAvailableData(size);
     if(pData != NULL)
@@ -204,17 +203,10 @@ IPoolDataPtr MemoryPool::allocate(const std::size_t size)
     std::size_t availableSize = getAvailableMemorySize();
     if(size > availableSize)
     {
-        // Try to release elements from the MemoryCache (make them available to the MemoryPool)
+        // Try to release elements from the MemoryCache (make them available to the MemoryPool),
+        // the least recently used first and only what is needed.
         TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the MemoryCache");
-        memoryCache.clearUnused();
-
-        availableSize = getAvailableMemorySize();
-        if(size > availableSize)
-        {
-            // Release elements from the MemoryPool (make them available to the OS)
-            TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the MemoryPool");
-            clear();
-        }
+        memoryCache.clearUnused(size - availableSize);
 
         availableSize = getAvailableMemorySize();
         if(size > availableSize)
@@ -226,9 +218,22 @@ IPoolDataPtr MemoryPool::allocate(const std::size_t size)
         }
     }
 
+    {
+        // Release unused elements from the MemoryPool (make them available to the OS),
+        // only what is needed to keep the allocated memory under the authorized size.
+        boost::mutex::scoped_lock locker(_mutex);
+        const std::size_t allocatedSize = _usedMemorySize + _unusedMemorySize;
+        if(allocatedSize + size > _memoryAuthorized)
+        {
+            TUTTLE_LOG_TRACE("[Memory Pool] Release elements from the MemoryPool");
+            releaseUnusedDatas(allocatedSize + size - _memoryAuthorized);
+        }
+    }
+
     // Allocate a new buffer in MemoryPool
-    TUTTLE_LOG_TRACE("[Memory Pool] allocate " << size << " bytes");
-    return new PoolData(*this, size);
+    const EMemoryAllocator allocator = core().getPreferences().getMemoryAllocator();
+    TUTTLE_LOG_TRACE("[Memory Pool] allocate " << size << " bytes (" << mapMemoryAllocatorEnumToString(allocator) << ")");
+    return new PoolData(*this, size, allocator);
 }
 
 std::size_t MemoryPool::updateMemoryAuthorizedWithRAM()
@@ -238,35 +243,22 @@ std::size_t MemoryPool::updateMemoryAuthorizedWithRAM()
     return _memoryAuthorized;
 }
 
-namespace
-{
-
-std::size_t accumulateReservedSize(const std::size_t& sum, const IPoolData* pData)
-{
-    return sum + pData->reservedSize();
-}
-
-std::size_t accumulateWastedSize(const std::size_t& sum, const IPoolData* pData)
-{
-    return sum + (pData->reservedSize() - pData->size());
-}
-}
-
 std::size_t MemoryPool::getUsedMemorySize() const
 {
     boost::mutex::scoped_lock locker(_mutex);
-    return std::accumulate(_dataUsed.begin(), _dataUsed.end(), 0, &accumulateReservedSize);
+    return _usedMemorySize;
 }
 
 std::size_t MemoryPool::getAllocatedAndUnusedMemorySize() const
 {
     boost::mutex::scoped_lock locker(_mutex);
-    return std::accumulate(_dataUnused.begin(), _dataUnused.end(), 0, &accumulateReservedSize);
+    return _unusedMemorySize;
 }
 
 std::size_t MemoryPool::getAllocatedMemorySize() const
 {
-    return getUsedMemorySize() + getAllocatedAndUnusedMemorySize();
+    boost::mutex::scoped_lock locker(_mutex);
+    return _usedMemorySize + _unusedMemorySize;
 }
 
 std::size_t MemoryPool::getMaxMemorySize() const
@@ -282,7 +274,7 @@ std::size_t MemoryPool::getAvailableMemorySize() const
 std::size_t MemoryPool::getWastedMemorySize() const
 {
     boost::mutex::scoped_lock locker(_mutex);
-    return std::accumulate(_dataUsed.begin(), _dataUsed.end(), 0, std::ptr_fun(&accumulateWastedSize));
+    return _wastedMemorySize;
 }
 
 std::size_t MemoryPool::getDataUsedSize() const
@@ -298,24 +290,95 @@ std::size_t MemoryPool::getDataUnusedSize() const
 PoolData* MemoryPool::getOneAvailableData(const size_t size)
 {
     boost::mutex::scoped_lock locker(_mutex);
-    return std::for_each(_dataUnused.begin(), _dataUnused.end(), DataFitSize(size)).bestMatch();
+    // smallest unused buffer big enough
+    DataListBySize::const_iterator it = _dataUnused.lower_bound(std::make_pair(size, static_cast<PoolData*>(NULL)));
+    if(it == _dataUnused.end() || it->first > maxBufferRatio * size)
+        return NULL;
+    return it->second;
+}
+
+std::size_t MemoryPool::releaseUnusedDatas(const std::size_t size)
+{
+    boost::unordered_set<PoolData*> toDelete;
+    std::size_t freedSize = 0;
+    while(freedSize < size && !_dataUnusedByAge.empty())
+    {
+        PoolData* pData = _dataUnusedByAge.begin()->second;
+        _dataUnusedByAge.erase(_dataUnusedByAge.begin());
+        _dataUnused.erase(std::make_pair(pData->reservedSize(), pData));
+        _dataMap.erase(pData->data());
+        freedSize += pData->reservedSize();
+        toDelete.insert(pData);
+    }
+    _unusedMemorySize -= freedSize;
+    if(!toDelete.empty())
+    {
+        TUTTLE_LOG_TRACE("[Memory Pool] Free " << toDelete.size() << " buffers (" << freedSize << " bytes)");
+        _allDatas.erase_if(DataIn(toDelete));
+    }
+    return freedSize;
 }
 
 void MemoryPool::clear(std::size_t size)
 {
-    /// @todo tuttle
+    boost::mutex::scoped_lock allocationLocker(_allocationMutex);
+    boost::mutex::scoped_lock locker(_mutex);
+    releaseUnusedDatas(size);
 }
 
 void MemoryPool::clear()
 {
+    boost::mutex::scoped_lock allocationLocker(_allocationMutex);
     boost::mutex::scoped_lock locker(_mutex);
-    _dataUnused.clear();
+    releaseUnusedDatas(_unusedMemorySize);
 }
 
 void MemoryPool::clearOne()
 {
+    boost::mutex::scoped_lock allocationLocker(_allocationMutex);
     boost::mutex::scoped_lock locker(_mutex);
-    _dataUnused.erase(_dataUnused.begin());
+    releaseUnusedDatas(1);
+}
+
+void MemoryPool::trim(const std::size_t highWaterMark)
+{
+    boost::mutex::scoped_lock allocationLocker(_allocationMutex);
+    boost::mutex::scoped_lock locker(_mutex);
+    const std::size_t allocatedSize = _usedMemorySize + _unusedMemorySize;
+    if(allocatedSize > highWaterMark)
+        releaseUnusedDatas(allocatedSize - highWaterMark);
+}
+
+void MemoryPool::startTrimmer(const std::size_t highWaterMark, const std::size_t periodMs)
+{
+    stopTrimmer();
+    TUTTLE_LOG_DEBUG("[Memory Pool] start trimmer, high-water mark: " << highWaterMark << " bytes");
+    _stopTrimmer = false;
+    _trimmerThread = boost::thread(&MemoryPool::trimmer, this, highWaterMark, periodMs);
+}
+
+void MemoryPool::stopTrimmer()
+{
+    if(!_trimmerThread.joinable())
+        return;
+    {
+        boost::mutex::scoped_lock locker(_trimmerMutex);
+        _stopTrimmer = true;
+    }
+    _trimmerCondition.notify_all();
+    _trimmerThread.join();
+}
+
+void MemoryPool::trimmer(const std::size_t highWaterMark, const std::size_t periodMs)
+{
+    boost::mutex::scoped_lock locker(_trimmerMutex);
+    while(!_stopTrimmer)
+    {
+        _trimmerCondition.timed_wait(locker, boost::posix_time::milliseconds(periodMs));
+        if(_stopTrimmer)
+            break;
+        trim(highWaterMark);
+    }
 }
 
 std::ostream& operator<<(std::ostream& os, const MemoryPool& memoryPool)
@@ -8,6 +8,7 @@
 #include <boost/thread.hpp>
 
 #include <map>
+#include <set>
 #include <list>
 #include <sstream>
 #include <numeric>
@@ -60,20 +61,57 @@ public:
 
     PoolData* getOneAvailableData(const size_t size);
 
+    /**
+     * @brief Free unused buffers, least recently used first, until @p size bytes are given back to the system.
+     */
     void clear(std::size_t size);
     void clear();
     void clearOne();
 
+    /**
+     * @brief Free unused buffers, least recently used first, until the allocated memory is under @p highWaterMark.
+     */
+    void trim(const std::size_t highWaterMark);
+
+    /**
+     * @brief Start a thread which calls trim( @p highWaterMark ) every @p periodMs milliseconds.
+     */
+    void startTrimmer(const std::size_t highWaterMark, const std::size_t periodMs = 1000);
+    void stopTrimmer();
+
     friend std::ostream& operator<<(std::ostream& os, const This& v);
 
+private:
+    /**
+     * @brief Delete unused buffers, least recently used first, until @p size bytes are freed.
+     * @warning _mutex needs to be locked.
+     * @return the freed size
+     */
+    std::size_t releaseUnusedDatas(const std::size_t size);
+
+    void trimmer(const std::size_t highWaterMark, const std::size_t periodMs);
+
 private:
     typedef boost::unordered_set<PoolData*> DataList;
+    /// unused datas sorted by reserved size, to get the best fit buffer with a lower_bound
+    typedef std::set<std::pair<std::size_t, PoolData*> > DataListBySize;
     boost::ptr_list<PoolData> _allDatas; // the owner
     std::map<char*, PoolData*> _dataMap;
     DataList _dataUsed;
-    DataList _dataUnused;
+    DataListBySize _dataUnused;
+    std::map<std::size_t, PoolData*> _dataUnusedByAge; ///< unused datas sorted by release order
+    std::size_t _releaseCount;                         ///< release order generator
+    std::size_t _usedMemorySize;   ///< sum of the reserved size of used datas
+    std::size_t _unusedMemorySize; ///< sum of the reserved size of unused datas
+    std::size_t _wastedMemorySize; ///< sum of the reserved but not requested size of used datas
     std::size_t _memoryAuthorized;
     mutable boost::mutex _mutex;
+    boost::mutex _allocationMutex; ///< an unused buffer must not be given to two render threads
+
+    boost::thread _trimmerThread;
+    boost::mutex _trimmerMutex;
+    boost::condition_variable _trimmerCondition;
+    bool _stopTrimmer;
 };
 
 #ifndef SWIG
@@ -247,6 +247,7 @@ int OfxhImage::getRowBytes() const
 
 int OfxhImage::getReferenceCount(const EReferenceOwner from) const
 {
+    boost::mutex::scoped_lock locker(_referenceCountMutex);
     RefMap::const_iterator it = _referenceCount.find(from);
     if(it == _referenceCount.end())
         return 0;
@@ -255,14 +256,22 @@ int OfxhImage::getReferenceCount(const EReferenceOwner from) const
 
 void OfxhImage::addReference(const EReferenceOwner from, const std::size_t n)
 {
-    const std::ptrdiff_t refC = _referenceCount[from] = getReferenceCount(from) + n;
+    std::ptrdiff_t refC = 0;
+    {
+        boost::mutex::scoped_lock locker(_referenceCountMutex);
+        refC = _referenceCount[from] += n;
+    }
     TUTTLE_LOG_INFO("[Ofxh Image] add reference with degree " << n << ", clipName:" << getClipName() << ", time:"
                                                               << getTime() << ", id:" << getId() << ", ref:" << refC);
 }
 
 bool OfxhImage::releaseReference(const EReferenceOwner from)
 {
-    const std::ptrdiff_t refC = _referenceCount[from] = getReferenceCount(from) - 1;
+    std::ptrdiff_t refC = 0;
+    {
+        boost::mutex::scoped_lock locker(_referenceCountMutex);
+        refC = _referenceCount[from] -= 1;
+    }
     TUTTLE_LOG_INFO("[Ofxh Image] release reference, clipName:" << getClipName() << ", time:" << getTime()
                                                                 << ", id:" << getId() << ", ref:" << refC);
     if(refC < 0)
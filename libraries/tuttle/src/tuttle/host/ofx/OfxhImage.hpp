@@ -38,6 +38,8 @@
 
 #include <ofxImageEffect.h>
 
+#include <boost/thread/mutex.hpp>
+
 namespace tuttle
 {
 namespace host
@@ -72,6 +74,7 @@ protected:
     std::ptrdiff_t _id;           ///< temp.... for check
     typedef std::map<EReferenceOwner, std::ptrdiff_t> RefMap;
     RefMap _referenceCount; ///< reference count on this image
+    mutable boost::mutex _referenceCountMutex; ///< the memory cache reads it from other render threads
     std::string _clipName;  ///< for debug
     OfxTime _time;          ///< for debug
 
@@ -158,6 +158,13 @@ bool OfxhImageEffectNodeBase::temporalAccess() const
     return _properties.getIntProperty(kOfxImageEffectPropTemporalClipAccess) != 0;
 }
 
+/// does each output pixel only depend on the input pixel at the same position
+
+bool OfxhImageEffectNodeBase::isPointWise() const
+{
+    return _properties.getIntProperty(kTuttleOfxImageEffectPropPointWise) != 0;
+}
+
 /// is the given RGBA/A pixel depth supported by the effect
 
 bool OfxhImageEffectNodeBase::isBitDepthSupported(const std::string& s) const
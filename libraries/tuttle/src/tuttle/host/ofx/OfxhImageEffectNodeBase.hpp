@@ -97,6 +97,9 @@ public:
     /// does this effect need random temporal access
     bool temporalAccess() const;
 
+    /// does each output pixel only depend on the input pixel at the same position
+    bool isPointWise() const;
+
     /// is the given bit depth supported by the effect
     bool isBitDepthSupported(const std::string& s) const;
 
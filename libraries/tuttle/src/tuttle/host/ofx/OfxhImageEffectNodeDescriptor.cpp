@@ -37,6 +37,7 @@ static property::OfxhPropSpec effectDescriptorStuff[] = {
     {kOfxImageEffectPropSupportedPixelDepths, property::ePropTypeString, 0, false, ""},
     {kTuttleOfxImageEffectPropSupportedExtensions, property::ePropTypeString, 0, false, ""},
     {kTuttleOfxImageEffectPropEvaluation, property::ePropTypeDouble, 1, false, "-1"},
+    {kTuttleOfxImageEffectPropPointWise, property::ePropTypeInt, 1, false, "0"},
     {kOfxImageEffectPluginPropFieldRenderTwiceAlways, property::ePropTypeInt, 1, false, "1"},
     {kOfxImageEffectPropSupportsMultipleClipDepths, property::ePropTypeInt, 1, false, "0"},
     {kOfxImageEffectPropSupportsMultipleClipPARs, property::ePropTypeInt, 1, false, "0"},
@@ -1,6 +1,8 @@
 #include "OfxhMultiThreadSuite.hpp"
 #include "OfxhCore.hpp"
 
+#include <tuttle/host/Core.hpp>
+
 #include <boost/thread/thread.hpp>
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/thread/tss.hpp>
@@ -24,7 +26,7 @@ namespace
 struct ThreadSpecificData
 {
     ThreadSpecificData(unsigned int threadIndex)
-        : _index(0)
+        : _index(threadIndex)
     {
     }
     unsigned int _index;
@@ -32,10 +34,21 @@ struct ThreadSpecificData
 
 boost::thread_specific_ptr<ThreadSpecificData> ptr;
 
-void launchThread(OfxThreadFunctionV1 func, unsigned int threadIndex, unsigned int threadMax, void* customArg)
+void launchThread(OfxThreadFunctionV1 func, unsigned int threadMax, void* customArg, const unsigned int threadIndex)
 {
-    ptr.reset(new ThreadSpecificData(threadIndex));
+    ThreadSpecificData* data = ptr.get();
+    if(data == NULL)
+    {
+        ptr.reset(new ThreadSpecificData(threadIndex));
+        func(threadIndex, threadMax, customArg);
+        ptr.reset();
+        return;
+    }
+    // multiThread called from a spawned thread, restore the index of the parent function at the end
+    const unsigned int parentIndex = data->_index;
+    data->_index = threadIndex;
     func(threadIndex, threadMax, customArg);
+    data->_index = parentIndex;
 }
 
 OfxStatus multiThread(OfxThreadFunctionV1 func, const unsigned int nThreads, void* customArg)
@@ -46,16 +59,11 @@ OfxStatus multiThread(OfxThreadFunctionV1 func, const unsigned int nThreads, voi
     }
     else if(nThreads == 1)
     {
-        func(0, 1, customArg);
+        launchThread(func, 1, customArg, 0);
     }
     else
     {
-        boost::thread_group group;
-        for(unsigned int i = 0; i < nThreads; ++i)
-        {
-            group.create_thread(boost::bind(launchThread, func, i, nThreads, customArg));
-        }
-        group.join_all();
+        core().getThreadPool().parallelFor(nThreads, boost::bind(launchThread, func, nThreads, customArg, _1));
     }
     return kOfxStatOK;
 }
@@ -63,7 +71,7 @@ OfxStatus multiThread(OfxThreadFunctionV1 func, const unsigned int nThreads, voi
 OfxStatus multiThreadNumCPUs(unsigned int* const nCPUs)
 {
     //	*nCPUs = 1; /// @todo tuttle: needs to have an option to disable multithreading (force only one cpu).
-    *nCPUs = boost::thread::hardware_concurrency();
+    *nCPUs = core().getThreadPool().getNbThreads();
     TUTTLE_LOG_INFO("[Multi thread] CPUs used: " << *nCPUs);
     return kOfxStatOK;
 }
@@ -72,7 +80,7 @@ OfxStatus multiThreadIndex(unsigned int* const threadIndex)
 {
     //	*threadIndex = boost::this_thread::get_id(); //	we don't want a global thead id, but the thead index inside a node
     // multithread process.
-    if(ptr.get() != NULL)
+    if(ptr.get() == NULL)
     {
         *threadIndex = 0;
         return kOfxStatFailed;
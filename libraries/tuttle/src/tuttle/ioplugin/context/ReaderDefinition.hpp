@@ -3,11 +3,19 @@
 
 #include <tuttle/plugin/context/Definition.hpp>
 
+#include <cstddef>
+
 namespace tuttle
 {
 namespace plugin
 {
 
+static const std::string kParamReaderReadAhead = "readAhead";
+static const std::string kParamReaderReadAheadMemory = "readAheadMemory";
+
+/// number of threads reading the files in advance
+static const std::size_t kReaderReadAheadNbThreads = 2;
+
 enum EParamReaderBitDepth
 {
     eParamReaderBitDepthAuto = 0,
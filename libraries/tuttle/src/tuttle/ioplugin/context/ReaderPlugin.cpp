@@ -19,6 +19,8 @@ ReaderPlugin::ReaderPlugin(OfxImageEffectHandle handle)
     _isSequence = sequenceParser::browseSequence(_filePattern, _paramFilepath->getValue());
     _paramBitDepth = fetchChoiceParam(kTuttlePluginBitDepth);
     _paramChannel = fetchChoiceParam(kTuttlePluginChannel);
+    _paramReadAhead = fetchIntParam(kParamReaderReadAhead);
+    _paramReadAheadMemory = fetchIntParam(kParamReaderReadAheadMemory);
 }
 
 ReaderPlugin::~ReaderPlugin()
@@ -30,6 +32,9 @@ void ReaderPlugin::changedParam(const OFX::InstanceChangedArgs& args, const std:
     if(paramName == kTuttlePluginFilename)
     {
         _isSequence = sequenceParser::browseSequence(_filePattern, _paramFilepath->getValue());
+
+        boost::mutex::scoped_lock lock(_fileHeadersMutex);
+        _fileHeaders.clear();
     }
 }
 
@@ -91,10 +96,36 @@ bool ReaderPlugin::getTimeDomain(OfxRangeD& range)
     return true;
 }
 
+void ReaderPlugin::beginSequenceRender(const OFX::BeginSequenceRenderArguments& args)
+{
+    const std::size_t depth = _paramReadAhead->getValue();
+    if(!_isSequence || args.isInteractive || depth == 0 || args.frameStep <= 0)
+        return;
+
+    // the files of the sequence, in the order of the render
+    std::vector<std::string> filepaths;
+    for(OfxTime time = args.frameRange.min; time <= args.frameRange.max; time += args.frameStep)
+    {
+        filepaths.push_back(getAbsoluteFilenameAt(time));
+    }
+    const std::size_t maxMemory = std::size_t(_paramReadAheadMemory->getValue()) * 1024 * 1024;
+    _prefetcher.start(filepaths, depth, maxMemory, kReaderReadAheadNbThreads, usePrefetchedFiles());
+}
+
 void ReaderPlugin::render(const OFX::RenderArguments& args)
 {
     std::string filename = getAbsoluteFilenameAt(args.time);
     TUTTLE_LOG_INFO("        >-- " << filename);
+    if(!usePrefetchedFiles())
+    {
+        // move the read ahead window
+        _prefetcher.get(filename);
+    }
+}
+
+void ReaderPlugin::endSequenceRender(const OFX::EndSequenceRenderArguments& args)
+{
+    _prefetcher.stop();
 }
 
 std::string ReaderPlugin::getAbsoluteFilenameAt(const OfxTime time) const
@@ -174,5 +205,29 @@ OFX::EBitDepth ReaderPlugin::getOfxExplicitConversion() const
     }
     return OFX::eBitDepthNone;
 }
+
+boost::shared_ptr<const ReaderPrefetcher::FileData> ReaderPlugin::getPrefetchedFile(const std::string& filepath)
+{
+    return _prefetcher.get(filepath);
+}
+
+boost::shared_ptr<const ReaderFileHeader> ReaderPlugin::findFileHeader(const std::string& filepath,
+                                                                       const std::time_t lastWriteTime)
+{
+    boost::mutex::scoped_lock lock(_fileHeadersMutex);
+    std::map<std::string, FileHeaderEntry>::const_iterator it = _fileHeaders.find(filepath);
+    if(it == _fileHeaders.end() || it->second._lastWriteTime != lastWriteTime)
+        return boost::shared_ptr<const ReaderFileHeader>();
+    return it->second._header;
+}
+
+void ReaderPlugin::addFileHeader(const std::string& filepath, const std::time_t lastWriteTime,
+                                 const boost::shared_ptr<const ReaderFileHeader>& header)
+{
+    boost::mutex::scoped_lock lock(_fileHeadersMutex);
+    FileHeaderEntry& entry = _fileHeaders[filepath];
+    entry._lastWriteTime = lastWriteTime;
+    entry._header = header;
+}
 }
 }
@@ -4,6 +4,7 @@
 #include <boost/gil/channel_algorithm.hpp> // force to use the boostHack version first
 
 #include "ReaderDefinition.hpp"
+#include "ReaderPrefetcher.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 #include <tuttle/plugin/exceptions.hpp>
@@ -12,6 +13,11 @@
 
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <ctime>
+#include <map>
 
 namespace tuttle
 {
@@ -20,6 +26,17 @@ namespace plugin
 
 namespace bfs = boost::filesystem;
 
+/**
+ * @brief Header of an image file, read once and shared by the RoD, the clip preferences and the render.
+ *
+ * Each reader derives it with the values it needs and a constructor which reads them from the file (see
+ * ReaderPlugin::getFileHeader). The constructor throws if the file can't be read.
+ */
+struct ReaderFileHeader
+{
+    virtual ~ReaderFileHeader() {}
+};
+
 class ReaderPlugin : public OFX::ImageEffect
 {
 public:
@@ -32,7 +49,9 @@ public:
     virtual void getClipPreferences(OFX::ClipPreferencesSetter& clipPreferences);
     virtual bool getTimeDomain(OfxRangeD& range);
 
+    virtual void beginSequenceRender(const OFX::BeginSequenceRenderArguments& args);
     virtual void render(const OFX::RenderArguments& args);
+    virtual void endSequenceRender(const OFX::EndSequenceRenderArguments& args);
 
 public:
     std::string getAbsoluteFilenameAt(const OfxTime time) const;
@@ -47,22 +66,79 @@ public:
 
     OFX::EBitDepth getOfxExplicitConversion() const;
 
+    /**
+     * @brief Header of the file @p filepath, read by Header( filepath ) on the first call.
+     * The header is read again if the file was modified since.
+     * @return NULL if the file doesn't exist
+     */
+    template <class Header>
+    boost::shared_ptr<const Header> getFileHeader(const std::string& filepath);
+
+    /**
+     * @brief Content of the file @p filepath if it was read in advance, see usePrefetchedFiles.
+     * @return NULL if the file needs to be read by the render
+     */
+    boost::shared_ptr<const ReaderPrefetcher::FileData> getPrefetchedFile(const std::string& filepath);
+
 protected:
     virtual inline bool varyOnTime() const { return _isSequence; }
 
+    /**
+     * @brief The render decodes the files from the memory returned by getPrefetchedFile.
+     * Otherwise the files read in advance are not kept, they are only read to fill the cache of the system.
+     */
+    virtual bool usePrefetchedFiles() const { return false; }
+
 public:
     OFX::Clip* _clipDst; ///< Destination image clip
     /// @name user parameters
     /// @{
-    OFX::StringParam* _paramFilepath; ///< File path
-    OFX::ChoiceParam* _paramBitDepth; ///< Explicit bit depth conversion
-    OFX::ChoiceParam* _paramChannel;  ///< Explicit component conversion
-                                      /// @}
+    OFX::StringParam* _paramFilepath;     ///< File path
+    OFX::ChoiceParam* _paramBitDepth;     ///< Explicit bit depth conversion
+    OFX::ChoiceParam* _paramChannel;      ///< Explicit component conversion
+    OFX::IntParam* _paramReadAhead;       ///< Number of files read in advance
+    OFX::IntParam* _paramReadAheadMemory; ///< Memory of the files read in advance (in MB)
+                                          /// @}
+
+private:
+    boost::shared_ptr<const ReaderFileHeader> findFileHeader(const std::string& filepath,
+                                                             const std::time_t lastWriteTime);
+    void addFileHeader(const std::string& filepath, const std::time_t lastWriteTime,
+                       const boost::shared_ptr<const ReaderFileHeader>& header);
 
 private:
     bool _isSequence;
     sequenceParser::Sequence _filePattern; ///< Filename pattern manager
+
+    struct FileHeaderEntry
+    {
+        std::time_t _lastWriteTime;
+        boost::shared_ptr<const ReaderFileHeader> _header;
+    };
+    boost::mutex _fileHeadersMutex;
+    std::map<std::string, FileHeaderEntry> _fileHeaders; ///< headers of the files of the sequence
+
+    ReaderPrefetcher _prefetcher;
 };
+
+template <class Header>
+boost::shared_ptr<const Header> ReaderPlugin::getFileHeader(const std::string& filepath)
+{
+    boost::system::error_code error;
+    const std::time_t lastWriteTime = bfs::last_write_time(filepath, error);
+    if(error)
+        return boost::shared_ptr<const Header>();
+
+    boost::shared_ptr<const Header> header =
+        boost::dynamic_pointer_cast<const Header>(findFileHeader(filepath, lastWriteTime));
+    if(!header)
+    {
+        // read outside of the lock, the renders of the other files don't wait
+        header.reset(new Header(filepath));
+        addFileHeader(filepath, lastWriteTime, header);
+    }
+    return header;
+}
 }
 }
 
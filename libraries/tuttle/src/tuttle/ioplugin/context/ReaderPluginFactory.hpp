@@ -41,6 +41,25 @@ void describeReaderParamsInContext(OFX::ImageEffectDescriptor& desc, OFX::EConte
     explicitConversion->setAnimates(false);
     desc.addClipPreferencesSlaveParam(*explicitConversion);
 
+    OFX::IntParamDescriptor* readAhead = desc.defineIntParam(kParamReaderReadAhead);
+    readAhead->setLabel("Read ahead");
+    readAhead->setHint("Number of files read in advance by background threads during the render of a sequence "
+                       "(0 to disable).");
+    readAhead->setRange(0, 64);
+    readAhead->setDisplayRange(0, 16);
+    readAhead->setDefault(4);
+    readAhead->setAnimates(false);
+    readAhead->setEvaluateOnChange(false);
+
+    OFX::IntParamDescriptor* readAheadMemory = desc.defineIntParam(kParamReaderReadAheadMemory);
+    readAheadMemory->setLabel("Read ahead memory (MB)");
+    readAheadMemory->setHint("Maximal size of the files kept in memory by the read ahead.");
+    readAheadMemory->setRange(1, 65536);
+    readAheadMemory->setDisplayRange(1, 4096);
+    readAheadMemory->setDefault(512);
+    readAheadMemory->setAnimates(false);
+    readAheadMemory->setEvaluateOnChange(false);
+
     if(OFX::getImageEffectHostDescription()->supportsMultipleClipDepths)
     {
         explicitConversion->setDefault(0);
@@ -0,0 +1,201 @@
+#include "ReaderPrefetcher.hpp"
+
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+
+#include <algorithm>
+
+namespace tuttle
+{
+namespace plugin
+{
+
+namespace bfs = boost::filesystem;
+
+namespace
+{
+/// size of the reads when the content of the files is not kept
+const std::size_t kReadBufferSize = 1024 * 1024;
+}
+
+ReaderPrefetcher::ReaderPrefetcher()
+    : _next(0)
+    , _current(0)
+    , _released(0)
+    , _depth(0)
+    , _maxMemory(0)
+    , _memory(0)
+    , _keepData(false)
+    , _stop(false)
+{
+}
+
+ReaderPrefetcher::~ReaderPrefetcher()
+{
+    stop();
+}
+
+void ReaderPrefetcher::start(const std::vector<std::string>& filepaths, const std::size_t depth,
+                             const std::size_t maxMemory, const std::size_t nbThreads, const bool keepData)
+{
+    stop();
+
+    boost::mutex::scoped_lock lock(_mutex);
+    _files.resize(filepaths.size());
+    for(std::size_t i = 0; i < filepaths.size(); ++i)
+    {
+        _files[i]._filepath = filepaths[i];
+        _files[i]._state = eFileStateWaiting;
+        _indexes[filepaths[i]] = i;
+    }
+    _next = _current = _released = 0;
+    _depth = depth;
+    _maxMemory = maxMemory;
+    _memory = 0;
+    _keepData = keepData;
+    _stop = false;
+    for(std::size_t i = 0; i < nbThreads; ++i)
+    {
+        _workers.push_back(
+            boost::shared_ptr<boost::thread>(new boost::thread(boost::bind(&ReaderPrefetcher::worker, this))));
+    }
+}
+
+void ReaderPrefetcher::stop()
+{
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        _stop = true;
+    }
+    _changed.notify_all();
+    BOOST_FOREACH(const boost::shared_ptr<boost::thread>& worker, _workers)
+    {
+        worker->join();
+    }
+    _workers.clear();
+
+    boost::mutex::scoped_lock lock(_mutex);
+    BOOST_FOREACH(File& file, _files)
+    {
+        release(file);
+    }
+    _files.clear();
+    _indexes.clear();
+}
+
+boost::shared_ptr<const ReaderPrefetcher::FileData> ReaderPrefetcher::get(const std::string& filepath)
+{
+    boost::unique_lock<boost::mutex> lock(_mutex);
+    std::map<std::string, std::size_t>::const_iterator it = _indexes.find(filepath);
+    if(it == _indexes.end())
+        return boost::shared_ptr<const FileData>();
+    const std::size_t index = it->second;
+    File& file = _files[index];
+
+    // the render doesn't read the file a second time
+    while(file._state == eFileStateReading)
+        _changed.wait(lock);
+
+    boost::shared_ptr<const FileData> data = file._data;
+    release(file);
+
+    // move the window, the renders of the parallel frames use the files a bit out of order
+    _current = std::max(_current, index + 1);
+    _next = std::max(_next, _current);
+    while(_released + _depth <= index)
+    {
+        release(_files[_released]);
+        ++_released;
+    }
+    _changed.notify_all();
+    return data;
+}
+
+bool ReaderPrefetcher::canReadNext() const
+{
+    return _next < _files.size() && _next < _current + _depth && (!_keepData || _memory < _maxMemory);
+}
+
+void ReaderPrefetcher::release(File& file)
+{
+    if(file._data)
+    {
+        _memory -= file._data->size();
+        file._data.reset();
+    }
+}
+
+void ReaderPrefetcher::worker()
+{
+    boost::unique_lock<boost::mutex> lock(_mutex);
+    for(;;)
+    {
+        while(!_stop && !canReadNext())
+            _changed.wait(lock);
+        if(_stop)
+            return;
+
+        const std::size_t index = _next++;
+        File& file = _files[index];
+        file._state = eFileStateReading;
+        const std::string filepath = file._filepath;
+        const bool keepData = _keepData;
+
+        boost::shared_ptr<const FileData> data;
+        lock.unlock();
+        try
+        {
+            data = readFile(filepath, keepData);
+        }
+        catch(...)
+        {
+            // the render reads the file itself and reports the error
+            TUTTLE_LOG_DEBUG("[Reader prefetcher] Unable to read " << filepath);
+        }
+        lock.lock();
+
+        file._state = eFileStateRead;
+        if(data && index >= _released && index >= _current)
+        {
+            file._data = data;
+            _memory += data->size();
+        }
+        _changed.notify_all();
+    }
+}
+
+boost::shared_ptr<const ReaderPrefetcher::FileData> ReaderPrefetcher::readFile(const std::string& filepath,
+                                                                               const bool keepData)
+{
+    bfs::ifstream stream(filepath, std::ios::in | std::ios::binary);
+    if(!stream)
+    {
+        BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to open file")
+                                                << exception::filename(filepath));
+    }
+
+    if(!keepData)
+    {
+        std::vector<char> buffer(kReadBufferSize);
+        while(stream.read(&buffer[0], buffer.size()))
+        {
+        }
+        return boost::shared_ptr<const FileData>();
+    }
+
+    const std::size_t size = boost::numeric_cast<std::size_t>(bfs::file_size(filepath));
+    boost::shared_ptr<FileData> data(new FileData(size));
+    if(size && !stream.read(&(*data)[0], size))
+    {
+        BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to read file")
+                                                << exception::filename(filepath));
+    }
+    return data;
+}
+}
+}
@@ -0,0 +1,98 @@
+#ifndef _TUTTLE_IOPLUGIN_CONTEXT_READERPREFETCHER_HPP_
+#define _TUTTLE_IOPLUGIN_CONTEXT_READERPREFETCHER_HPP_
+
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tuttle
+{
+namespace plugin
+{
+
+/**
+ * @brief Read-ahead of the files of a sequence.
+ *
+ * During the render of a sequence, background threads read the next files while the current
+ * frame is decoded and processed, so the latency of the storage is hidden.
+ * The files read in advance are bounded by a number of files and a memory size.
+ */
+class ReaderPrefetcher : boost::noncopyable
+{
+public:
+    typedef std::vector<char, OfxAllocator<char> > FileData;
+
+public:
+    ReaderPrefetcher();
+    ~ReaderPrefetcher();
+
+    /**
+     * @brief Start to read the files @p filepaths, in this order.
+     * @param depth maximal number of files read in advance
+     * @param maxMemory maximal size of the files kept in memory (in bytes)
+     * @param nbThreads number of I/O threads
+     * @param keepData keep the content of the files, otherwise they are only read to fill the cache of the system
+     */
+    void start(const std::vector<std::string>& filepaths, const std::size_t depth, const std::size_t maxMemory,
+               const std::size_t nbThreads, const bool keepData);
+
+    /// @brief Stop the threads and free the files
+    void stop();
+
+    /**
+     * @brief Content of the file @p filepath which is going to be read by a render.
+     * Waits if the file is being read. The files before it move out of the read-ahead window.
+     * @return NULL if the file wasn't read in advance (not in the sequence, not kept, or read error)
+     */
+    boost::shared_ptr<const FileData> get(const std::string& filepath);
+
+private:
+    enum EFileState
+    {
+        eFileStateWaiting = 0,
+        eFileStateReading,
+        eFileStateRead
+    };
+
+    struct File
+    {
+        std::string _filepath;
+        EFileState _state;
+        boost::shared_ptr<const FileData> _data;
+    };
+
+    void worker();
+    bool canReadNext() const;
+    void release(File& file);
+
+    /// @return the content of the file, or NULL if @p keepData is false
+    static boost::shared_ptr<const FileData> readFile(const std::string& filepath, const bool keepData);
+
+private:
+    std::vector<File> _files;
+    std::map<std::string, std::size_t> _indexes; ///< index of each file in _files
+    std::size_t _next;                           ///< next file to read
+    std::size_t _current;                        ///< first file not used by a render
+    std::size_t _released;                       ///< the files before it are released
+    std::size_t _depth;
+    std::size_t _maxMemory;
+    std::size_t _memory; ///< size of the files in memory
+    bool _keepData;
+    bool _stop;
+    std::vector<boost::shared_ptr<boost::thread> > _workers;
+    boost::mutex _mutex;
+    boost::condition_variable _changed;
+};
+}
+}
+
+#endif
@@ -16,7 +16,9 @@
 #include <boost/exception/info.hpp>
 #include <boost/exception/error_info.hpp>
 #include <boost/throw_exception.hpp>
+#include <boost/thread/mutex.hpp>
 
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 
@@ -42,6 +44,10 @@ protected:
 
 private:
     unsigned int _nbThreads;
+    OfxPointI _tileSize;     ///< (0, 0) to give one slab of rows to each thread
+    OfxPointI _nbTiles;      ///< number of tiles in the render window
+    std::size_t _nextTile;   ///< next tile to process
+    boost::mutex _tileMutex; ///< protects _nextTile
 
 public:
     /** @brief ctor */
@@ -50,7 +56,10 @@ public:
         , _effect(effect)
         , _imageOrientation(imageOrientation)
         , _nbThreads(0) // auto, maximum allowable number of CPUs will be used
+        , _nextTile(0)
     {
+        _tileSize.x = _tileSize.y = 0;
+        _nbTiles.x = _nbTiles.y = 0;
         _dstPixelRod.x1 = _dstPixelRod.y1 = _dstPixelRod.x2 = _dstPixelRod.y2 = 0;
         _dstPixelRodSize.x = _dstPixelRodSize.y = 0;
         _renderWindowSize.x = _renderWindowSize.y = 0;
@@ -69,6 +78,21 @@ public:
     void setNbThreads(const unsigned int nbThreads) { _nbThreads = nbThreads; }
     void setNbThreadsAuto() { _nbThreads = 0; }
 
+    /**
+     * @brief Cut the render window into tiles of @p width x @p height pixels.
+     * Each thread pulls the next tile until all are done, so the threads stay busy
+     * when the cost of the pixels is uneven.
+     * A size of 0 uses the full width (or height) of the render window.
+     */
+    void setTileSize(const int width, const int height)
+    {
+        _tileSize.x = width;
+        _tileSize.y = height;
+    }
+    /// @brief Back to one horizontal slab of rows per thread (default).
+    void setNoTiles() { setTileSize(0, 0); }
+    bool useTiles() const { return _tileSize.x > 0 || _tileSize.y > 0; }
+
     /** @brief called before any MP is done */
     virtual void preProcess() { progressBegin(_renderWindowSize.y * _renderWindowSize.x); }
 
@@ -144,6 +168,12 @@ public:
      */
     void multiThreadFunction(const unsigned int threadId, const unsigned int nThreads)
     {
+        if(useTiles())
+        {
+            multiThreadTiles();
+            return;
+        }
+
         // slice the y range into the number of threads it has
         const int dy = std::abs(_renderArgs.renderWindow.y2 - _renderArgs.renderWindow.y1);
         const int y1 = _renderArgs.renderWindow.y1 + threadId * dy / nThreads;
@@ -158,6 +188,35 @@ public:
         multiThreadProcessImages(winRoW);
     }
 
+private:
+    /** @brief pull tiles from the render window until there is no more */
+    void multiThreadTiles()
+    {
+        const OfxRectI& renderWindow = _renderArgs.renderWindow;
+        const int tileWidth = _tileSize.x > 0 ? _tileSize.x : _renderWindowSize.x;
+        const int tileHeight = _tileSize.y > 0 ? _tileSize.y : _renderWindowSize.y;
+        const std::size_t nbTiles = _nbTiles.x * _nbTiles.y;
+
+        while(!_effect.abort())
+        {
+            std::size_t tile;
+            {
+                boost::mutex::scoped_lock lock(_tileMutex);
+                tile = _nextTile++;
+            }
+            if(tile >= nbTiles)
+                return;
+
+            OfxRectI winRoW;
+            winRoW.x1 = renderWindow.x1 + (tile % _nbTiles.x) * tileWidth;
+            winRoW.y1 = renderWindow.y1 + (tile / _nbTiles.x) * tileHeight;
+            winRoW.x2 = std::min(winRoW.x1 + tileWidth, renderWindow.x2);
+            winRoW.y2 = std::min(winRoW.y1 + tileHeight, renderWindow.y2);
+            multiThreadProcessImages(winRoW);
+        }
+    }
+
+public:
     /** @brief this is called by multiThreadFunction to actually process images, override in derived classes */
     virtual void multiThreadProcessImages(const OfxRectI& windowRoW) = 0;
 
@@ -179,6 +238,15 @@ public:
         // call the pre MP pass
         preProcess();
 
+        if(useTiles())
+        {
+            const int tileWidth = _tileSize.x > 0 ? _tileSize.x : _renderWindowSize.x;
+            const int tileHeight = _tileSize.y > 0 ? _tileSize.y : _renderWindowSize.y;
+            _nbTiles.x = (_renderWindowSize.x + tileWidth - 1) / tileWidth;
+            _nbTiles.y = (_renderWindowSize.y + tileHeight - 1) / tileHeight;
+            _nextTile = 0;
+        }
+
         // call the base multi threading code, should put a pre & post thread calls in too
         multiThread(_nbThreads);
 
@@ -0,0 +1,82 @@
+#ifndef _TUTTLE_PLUGIN_REDUCEEXECUTOR_HPP_
+#define _TUTTLE_PLUGIN_REDUCEEXECUTOR_HPP_
+
+#include <ofxsMultiThread.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include <cstddef>
+
+namespace tuttle
+{
+namespace plugin
+{
+
+namespace detail
+{
+
+/**
+ * @brief Run the blocks of a task on the threads of the host, each thread pulls the next block.
+ */
+template <class Task>
+class ReduceTaskProcessor : public OFX::MultiThread::Processor
+{
+public:
+    ReduceTaskProcessor(Task& task, const std::size_t nbBlocks)
+        : _task(task)
+        , _nbBlocks(nbBlocks)
+        , _nextBlock(0)
+    {
+    }
+
+    void multiThreadFunction(const unsigned int threadId, const unsigned int nThreads)
+    {
+        for(;;)
+        {
+            std::size_t block;
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                block = _nextBlock++;
+            }
+            if(block >= _nbBlocks)
+                return;
+            _task(block);
+        }
+    }
+
+private:
+    Task& _task;
+    const std::size_t _nbBlocks;
+    std::size_t _nextBlock; ///< protected by _mutex
+    boost::mutex _mutex;
+};
+}
+
+/**
+ * @brief Executor of the terry reductions (terry::algorithm::reduce_pixels) on the threads of the host.
+ *
+ * The reductions merge the blocks in a fixed order, so the results are the same with any number of threads.
+ */
+class ReduceExecutor
+{
+public:
+    /// @param nbThreads number of threads, 0 to use all the CPUs allowed by the host
+    explicit ReduceExecutor(const unsigned int nbThreads = 0)
+        : _nbThreads(nbThreads)
+    {
+    }
+
+    template <class Task>
+    void operator()(Task& task, const std::size_t nbBlocks) const
+    {
+        detail::ReduceTaskProcessor<Task> processor(task, nbBlocks);
+        processor.multiThread(_nbThreads);
+    }
+
+private:
+    unsigned int _nbThreads;
+};
+}
+}
+
+#endif
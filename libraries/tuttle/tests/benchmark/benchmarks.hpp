@@ -0,0 +1,12 @@
+#ifndef _TUTTLE_TEST_BENCHMARKS_HPP_
+#define _TUTTLE_TEST_BENCHMARKS_HPP_
+
+/**
+ * @brief Benchmarks of tuttle host.
+ * They only print timings, so they are built with the tests but are not run by ctest.
+ */
+
+void benchmarkAllocators();
+void benchmarkThreadPool();
+
+#endif
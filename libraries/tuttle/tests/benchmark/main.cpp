@@ -0,0 +1,44 @@
+#include "benchmarks.hpp"
+
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+
+struct Benchmark
+{
+    const char* name;
+    void (*function)();
+};
+
+const Benchmark benchmarks[] = {{"allocators", &benchmarkAllocators}, {"threadPool", &benchmarkThreadPool}};
+const std::size_t nbBenchmarks = sizeof(benchmarks) / sizeof(Benchmark);
+
+bool isSelected(const Benchmark& benchmark, int argc, char** argv)
+{
+    if(argc < 2)
+        return true;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], benchmark.name) == 0)
+            return true;
+    }
+    return false;
+}
+}
+
+/**
+ * @brief Run the benchmarks given on the command line, or all of them.
+ */
+int main(int argc, char** argv)
+{
+    for(std::size_t i = 0; i < nbBenchmarks; ++i)
+    {
+        if(!isSelected(benchmarks[i], argc, argv))
+            continue;
+        std::cout << "benchmark " << benchmarks[i].name << std::endl;
+        benchmarks[i].function();
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "benchmarks.hpp"
+
+#include <tuttle/host/memory/Allocator.hpp>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <cstring>
+#include <numeric>
+#include <iostream>
+
+using namespace tuttle::host;
+
+void benchmarkAllocators()
+{
+    const std::size_t size = 256 * 1024 * 1024;
+    const memory::EMemoryAllocator allocators[] = {memory::eMemoryAllocatorAligned, memory::eMemoryAllocatorMmap,
+                                                   memory::eMemoryAllocatorHugePages};
+    for(std::size_t i = 0; i < sizeof(allocators) / sizeof(memory::EMemoryAllocator); ++i)
+    {
+        const memory::EMemoryAllocator allocator = allocators[i];
+        boost::posix_time::ptime t0(boost::posix_time::microsec_clock::local_time());
+        char* data = memory::allocateBuffer(allocator, size);
+
+        // first write, with the page faults
+        std::memset(data, 1, size);
+        boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
+        std::memset(data, 2, size);
+        boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
+        const std::size_t sum = std::accumulate(reinterpret_cast<const std::size_t*>(data),
+                                                reinterpret_cast<const std::size_t*>(data + size), std::size_t(0));
+        boost::posix_time::ptime t3(boost::posix_time::microsec_clock::local_time());
+        memory::freeBuffer(allocator, data, size);
+
+        const double mb = size / (1024.0 * 1024.0);
+        std::cout << "allocator " << memory::mapMemoryAllocatorEnumToString(allocator) << ":" << std::endl;
+        std::cout << "  first fill: " << mb * 1e6 / (t1 - t0).total_microseconds() << " MB/s" << std::endl;
+        std::cout << "  fill: " << mb * 1e6 / (t2 - t1).total_microseconds() << " MB/s" << std::endl;
+        std::cout << "  read: " << mb * 1e6 / (t3 - t2).total_microseconds() << " MB/s";
+        // use the sum, so the read is not optimized out
+        std::cout << (sum != 0 ? "" : " (empty)") << std::endl;
+    }
+}
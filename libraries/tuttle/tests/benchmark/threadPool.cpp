@@ -0,0 +1,60 @@
+#include "benchmarks.hpp"
+
+#include <tuttle/host/ThreadPool.hpp>
+#include <tuttle/host/ofx/OfxhMultiThreadSuite.hpp>
+
+#include <ofxMultiThread.h>
+
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/bind.hpp>
+
+#include <iostream>
+
+using namespace tuttle::host;
+
+namespace
+{
+
+const OfxMultiThreadSuiteV1& multiThreadSuite()
+{
+    return *static_cast<OfxMultiThreadSuiteV1*>(ofx::getMultithreadSuite(1));
+}
+
+void emptyFunction(unsigned int, unsigned int, void*)
+{
+}
+
+void launchEmpty(unsigned int threadIndex, unsigned int threadMax)
+{
+    emptyFunction(threadIndex, threadMax, NULL);
+}
+}
+
+void benchmarkThreadPool()
+{
+    const unsigned int nbCalls = 500;
+    const unsigned int nThreads = boost::thread::hardware_concurrency();
+
+    boost::posix_time::ptime t0(boost::posix_time::microsec_clock::local_time());
+    for(unsigned int c = 0; c < nbCalls; ++c)
+    {
+        // previous implementation: new threads at each call
+        boost::thread_group group;
+        for(unsigned int i = 0; i < nThreads; ++i)
+        {
+            group.create_thread(boost::bind(launchEmpty, i, nThreads));
+        }
+        group.join_all();
+    }
+    boost::posix_time::ptime t1(boost::posix_time::microsec_clock::local_time());
+    for(unsigned int c = 0; c < nbCalls; ++c)
+    {
+        multiThreadSuite().multiThread(emptyFunction, nThreads, NULL);
+    }
+    boost::posix_time::ptime t2(boost::posix_time::microsec_clock::local_time());
+
+    std::cout << "multiThread with " << nThreads << " threads, per call:" << std::endl;
+    std::cout << "  thread group: " << (t1 - t0).total_microseconds() / nbCalls << " us" << std::endl;
+    std::cout << "  thread pool: " << (t2 - t1).total_microseconds() / nbCalls << " us" << std::endl;
+}
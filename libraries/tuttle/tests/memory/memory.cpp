@@ -4,8 +4,10 @@
 // custom host
 #include <tuttle/host/memory/MemoryPool.hpp>
 #include <tuttle/host/memory/MemoryCache.hpp>
+#include <tuttle/host/memory/Allocator.hpp>
 
 #include <iostream>
+#include <vector>
 
 using namespace boost::unit_test;
 using namespace std;
@@ -107,6 +109,102 @@ BOOST_AUTO_TEST_CASE(memoryPool)
     }
 }
 
+BOOST_AUTO_TEST_CASE(memoryPool_bestFit)
+{
+    memory::MemoryPool pool(1000);
+    {
+        // allocate buffers of different sizes at the same time
+        std::vector<memory::IPoolDataPtr> datas;
+        for(std::size_t size = 10; size <= 100; size += 10)
+            datas.push_back(pool.allocate(size));
+        BOOST_CHECK_EQUAL(550U, pool.getUsedMemorySize());
+        BOOST_CHECK_EQUAL(550U, pool.getAllocatedMemorySize());
+        BOOST_CHECK_EQUAL(10U, pool.getDataUsedSize());
+    }
+    BOOST_CHECK_EQUAL(0U, pool.getUsedMemorySize());
+    BOOST_CHECK_EQUAL(550U, pool.getAllocatedAndUnusedMemorySize());
+    BOOST_CHECK_EQUAL(10U, pool.getDataUnusedSize());
+    {
+        // each request takes the smallest buffer big enough
+        const memory::IPoolDataPtr pData45 = pool.allocate(45);
+        const memory::IPoolDataPtr pData50 = pool.allocate(50);
+        const memory::IPoolDataPtr pData41 = pool.allocate(41);
+        BOOST_CHECK_EQUAL(50U, pData45->reservedSize());
+        BOOST_CHECK_EQUAL(60U, pData50->reservedSize());
+        BOOST_CHECK_EQUAL(70U, pData41->reservedSize());
+        BOOST_CHECK_EQUAL(180U, pool.getUsedMemorySize());
+        BOOST_CHECK_EQUAL(370U, pool.getAllocatedAndUnusedMemorySize());
+        BOOST_CHECK_EQUAL(5U + 10U + 29U, pool.getWastedMemorySize());
+    }
+    BOOST_CHECK_EQUAL(0U, pool.getUsedMemorySize());
+    BOOST_CHECK_EQUAL(0U, pool.getWastedMemorySize());
+    BOOST_CHECK_EQUAL(550U, pool.getAllocatedMemorySize());
+}
+
+BOOST_AUTO_TEST_CASE(memoryPool_clear)
+{
+    memory::MemoryPool pool(1000);
+    {
+        memory::IPoolDataPtr pData10 = pool.allocate(10);
+        memory::IPoolDataPtr pData20 = pool.allocate(20);
+        memory::IPoolDataPtr pData30 = pool.allocate(30);
+        // release order: 20, 30, 10
+        pData20.reset();
+        pData30.reset();
+    }
+    BOOST_CHECK_EQUAL(60U, pool.getAllocatedAndUnusedMemorySize());
+
+    // the least recently used buffers are freed first, only what is needed
+    pool.clear(25);
+    BOOST_CHECK_EQUAL(10U, pool.getAllocatedAndUnusedMemorySize());
+    BOOST_CHECK_EQUAL(1U, pool.getDataUnusedSize());
+    {
+        const memory::IPoolDataPtr pData = pool.allocate(10);
+        BOOST_CHECK_EQUAL(10U, pData->reservedSize());
+        BOOST_CHECK_EQUAL(10U, pool.getAllocatedMemorySize());
+    }
+
+    // trim to a high-water mark
+    {
+        const memory::IPoolDataPtr pData100 = pool.allocate(100);
+        const memory::IPoolDataPtr pData200 = pool.allocate(200);
+    }
+    BOOST_CHECK_EQUAL(310U, pool.getAllocatedMemorySize());
+    // release order: 10, 200, 100
+    pool.trim(250);
+    BOOST_CHECK_EQUAL(100U, pool.getAllocatedMemorySize());
+    pool.trim(250);
+    BOOST_CHECK_EQUAL(100U, pool.getAllocatedMemorySize());
+    pool.clearOne();
+    BOOST_CHECK_EQUAL(0U, pool.getAllocatedMemorySize());
+}
+
+BOOST_AUTO_TEST_CASE(allocators)
+{
+    // a size which is not a multiple of the pages
+    const std::size_t size = 4 * 1024 * 1024 + 100;
+    const memory::EMemoryAllocator allocators[] = {memory::eMemoryAllocatorAligned, memory::eMemoryAllocatorMmap,
+                                                   memory::eMemoryAllocatorHugePages};
+    for(std::size_t i = 0; i < sizeof(allocators) / sizeof(memory::EMemoryAllocator); ++i)
+    {
+        const memory::EMemoryAllocator allocator = allocators[i];
+        BOOST_TEST_MESSAGE("allocator " << memory::mapMemoryAllocatorEnumToString(allocator));
+        char* data = memory::allocateBuffer(allocator, size);
+        BOOST_REQUIRE(data != NULL);
+        BOOST_CHECK_EQUAL(0U, reinterpret_cast<std::size_t>(data) % memory::kMemoryAlignment);
+
+        // the whole buffer is writable
+        for(std::size_t j = 0; j < size; ++j)
+            data[j] = static_cast<char>(j % 127);
+        bool valid = true;
+        for(std::size_t j = 0; j < size && valid; ++j)
+            valid = data[j] == static_cast<char>(j % 127);
+        BOOST_CHECK(valid);
+
+        memory::freeBuffer(allocator, data, size);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(memoryCache)
 {
     memory::MemoryCache cache;
@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE tuttle_threadPool
+#include <tuttle/test/main.hpp>
+
+#include <tuttle/host/ThreadPool.hpp>
+#include <tuttle/host/ofx/OfxhMultiThreadSuite.hpp>
+
+#include <ofxMultiThread.h>
+
+#include <boost/thread/thread.hpp>
+
+#include <vector>
+#include <numeric>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace
+{
+
+const OfxMultiThreadSuiteV1& multiThreadSuite()
+{
+    return *static_cast<OfxMultiThreadSuiteV1*>(ofx::getMultithreadSuite(1));
+}
+
+struct IndexCheck
+{
+    std::vector<unsigned int> _calls;
+    std::vector<unsigned int> _indexes;
+};
+
+void checkIndex(unsigned int threadIndex, unsigned int threadMax, void* customArg)
+{
+    IndexCheck& check = *static_cast<IndexCheck*>(customArg);
+    unsigned int index = threadMax;
+    multiThreadSuite().multiThreadIndex(&index);
+    check._calls[threadIndex] += 1;
+    check._indexes[threadIndex] = index;
+}
+
+void nestedCall(unsigned int threadIndex, unsigned int threadMax, void* customArg)
+{
+    std::vector<unsigned int>& counts = *static_cast<std::vector<unsigned int>*>(customArg);
+    IndexCheck check;
+    check._calls.resize(threadMax, 0);
+    check._indexes.resize(threadMax, threadMax);
+    multiThreadSuite().multiThread(checkIndex, threadMax, &check);
+
+    unsigned int index = threadMax;
+    multiThreadSuite().multiThreadIndex(&index);
+    counts[threadIndex] = (index == threadIndex) ? std::accumulate(check._calls.begin(), check._calls.end(), 0u) : 0;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(threadPool_tests_suite01)
+
+BOOST_AUTO_TEST_CASE(multiThread_indexes)
+{
+    const unsigned int nThreads = 16;
+    IndexCheck check;
+    check._calls.resize(nThreads, 0);
+    check._indexes.resize(nThreads, nThreads);
+
+    BOOST_CHECK_EQUAL(kOfxStatOK, multiThreadSuite().multiThread(checkIndex, nThreads, &check));
+    for(unsigned int i = 0; i < nThreads; ++i)
+    {
+        BOOST_CHECK_EQUAL(1U, check._calls[i]);
+        BOOST_CHECK_EQUAL(i, check._indexes[i]);
+    }
+    BOOST_CHECK(!multiThreadSuite().multiThreadIsSpawnedThread());
+}
+
+BOOST_AUTO_TEST_CASE(multiThread_nested)
+{
+    const unsigned int nThreads = 8;
+    std::vector<unsigned int> counts(nThreads, 0);
+
+    BOOST_CHECK_EQUAL(kOfxStatOK, multiThreadSuite().multiThread(nestedCall, nThreads, &counts));
+    for(unsigned int i = 0; i < nThreads; ++i)
+    {
+        BOOST_CHECK_EQUAL(nThreads, counts[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(multiThread_repeated)
+{
+    // the threads of the pool are reused by consecutive calls
+    const unsigned int nbCalls = 500;
+    const unsigned int nThreads = boost::thread::hardware_concurrency();
+    IndexCheck check;
+    check._calls.resize(nThreads, 0);
+    check._indexes.resize(nThreads, nThreads);
+
+    for(unsigned int c = 0; c < nbCalls; ++c)
+    {
+        BOOST_REQUIRE_EQUAL(kOfxStatOK, multiThreadSuite().multiThread(checkIndex, nThreads, &check));
+    }
+    for(unsigned int i = 0; i < nThreads; ++i)
+    {
+        BOOST_CHECK_EQUAL(nbCalls, check._calls[i]);
+        BOOST_CHECK_EQUAL(i, check._indexes[i]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
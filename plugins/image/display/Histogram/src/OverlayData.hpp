@@ -59,23 +59,26 @@ struct AverageBarData
  */
 typedef boost::multi_array<unsigned char, 2, OfxAllocator<unsigned char> > bool_2d;
 
+/**
+ * @brief View on the selection, to reduce it with the source view
+ */
+inline boost::gil::gray8c_view_t selection_view(const bool_2d& selection)
+{
+    return boost::gil::interleaved_view(selection.shape()[1], selection.shape()[0],
+                                        reinterpret_cast<const boost::gil::gray8_pixel_t*>(selection.data()),
+                                        selection.shape()[1]);
+}
+
+/**
+ * @brief Reducer of the histograms of an image (see terry::algorithm::reduce_pixels)
+ */
 struct Pixel_compute_histograms
 {
-    HistogramBufferData& _data; // HistogramBufferData to fill up
-    bool_2d& _imgBool;          // bool selection img (pixels)
-    std::ssize_t _height;       // height of src clip
-    std::ssize_t _width;        // width of src clip
-    std::ssize_t _y, _x;        // position of the current pixel (functor needs to know which pixel is it)
-    bool _isSelectionMode;      // do we work on all of the pixels (normal histograms) or only on selection
-
-    Pixel_compute_histograms(bool_2d& selection, HistogramBufferData& data, const bool isSelectionMode)
+    HistogramBufferData _data; // histograms of the pixels reduced by this functor
+
+    /// @param data empty buffers of the size of the histograms
+    explicit Pixel_compute_histograms(const HistogramBufferData& data)
         : _data(data)
-        , _imgBool(selection)
-        , _height(_imgBool.shape()[0])
-        , _width(_imgBool.shape()[1])
-        , _y(0)
-        , _x(0)
-        , _isSelectionMode(isSelectionMode)
     {
     }
 
@@ -93,78 +96,78 @@ struct Pixel_compute_histograms
     }
 
     template <typename Pixel>
-    Pixel operator()(const Pixel& p)
+    void operator()(const Pixel& p)
     {
         using namespace boost::gil;
-        bool ok = false;
+        int indice;
+        double val;
+        hsl32f_pixel_t hsl_pix; // needed to work in HSL (entry is RGBA)
+        rgba32f_pixel_t pix;
 
-        BOOST_ASSERT(_y >= 0);
-        BOOST_ASSERT(_x >= 0);
-        BOOST_ASSERT(std::ssize_t(_imgBool.shape()[0]) > _y);
-        BOOST_ASSERT(std::ssize_t(_imgBool.shape()[1]) > _x);
+        color_convert(p, pix);       // convert input to RGBA
+        color_convert(pix, hsl_pix); // convert RGBA tp HSL
 
-        // int revert_y = (_height-1)-_y;
-
-        if(_isSelectionMode == false)
-            ok = true;
-        else if(_imgBool[_y][_x] && _isSelectionMode)
-            ok = true;
-
-        if(ok) // if current pixel is selected
+        // RGBA
+        for(int v = 0; v < boost::gil::num_channels<Pixel>::type::value; ++v)
         {
-            int indice;
-            double val;
-            hsl32f_pixel_t hsl_pix; // needed to work in HSL (entry is RGBA)
-            rgba32f_pixel_t pix;
-
-            color_convert(p, pix);       // convert input to RGBA
-            color_convert(pix, hsl_pix); // convert RGBA tp HSL
-
-            // RGBA
-            for(int v = 0; v < boost::gil::num_channels<Pixel>::type::value; ++v)
+            val = p[v];
+            if(val >= 0 && val <= 1)
             {
-                val = p[v];
-                if(val >= 0 && val <= 1)
-                {
-                    double inter = round(val * (_data._step - 1));
-                    indice = inter;
-                    if(v == 0)
-                        _data._bufferRed.at(indice) += 1; // increments red buffer
-                    else if(v == 1)
-                        _data._bufferGreen.at(indice) += 1; // increments green buffer
-                    else if(v == 2)
-                        _data._bufferBlue.at(indice) += 1; // increments blue buffer
-                    else if(v == 3)
-                        _data._bufferAlpha.at(indice) += 1; // increments alpha buffer
-                }
+                double inter = round(val * (_data._step - 1));
+                indice = inter;
+                if(v == 0)
+                    _data._bufferRed.at(indice) += 1; // increments red buffer
+                else if(v == 1)
+                    _data._bufferGreen.at(indice) += 1; // increments green buffer
+                else if(v == 2)
+                    _data._bufferBlue.at(indice) += 1; // increments blue buffer
+                else if(v == 3)
+                    _data._bufferAlpha.at(indice) += 1; // increments alpha buffer
             }
+        }
 
-            // HLS
-            for(int v = 0; v < boost::gil::num_channels<hsl32f_pixel_t>::type::value; ++v)
+        // HLS
+        for(int v = 0; v < boost::gil::num_channels<hsl32f_pixel_t>::type::value; ++v)
+        {
+            val = hsl_pix[v];
+            if(val >= 0 && val <= 1)
             {
-                val = hsl_pix[v];
-                if(val >= 0 && val <= 1)
-                {
-                    double inter = round(val * (_data._step - 1));
-                    indice = inter;
-                    if(v == 0)
-                        _data._bufferHue.at(indice) += 1; // increments hue buffer
-                    else if(v == 2)
-                        _data._bufferLightness.at(indice) += 1; // increments saturation buffer
-                    else if(v == 1)
-                        _data._bufferSaturation.at(indice) += 1; // increments lightness buffer
-                }
+                double inter = round(val * (_data._step - 1));
+                indice = inter;
+                if(v == 0)
+                    _data._bufferHue.at(indice) += 1; // increments hue buffer
+                else if(v == 2)
+                    _data._bufferLightness.at(indice) += 1; // increments saturation buffer
+                else if(v == 1)
+                    _data._bufferSaturation.at(indice) += 1; // increments lightness buffer
             }
         }
+    }
 
-        // Check pixel position
-        ++_x;
-        if(_x == _width)
-        {
-            ++_y;
-            _x = 0;
-        }
-        return p;
+    /// @brief only count the selected pixels
+    template <typename Pixel>
+    void operator()(const Pixel& p, const boost::gil::gray8_pixel_t& selected)
+    {
+        if(selected[0]) // if current pixel is selected
+            (*this)(p);
+    }
+
+    void merge(const Pixel_compute_histograms& other)
+    {
+        mergeVector(_data._bufferRed, other._data._bufferRed);
+        mergeVector(_data._bufferGreen, other._data._bufferGreen);
+        mergeVector(_data._bufferBlue, other._data._bufferBlue);
+        mergeVector(_data._bufferHue, other._data._bufferHue);
+        mergeVector(_data._bufferLightness, other._data._bufferLightness);
+        mergeVector(_data._bufferSaturation, other._data._bufferSaturation);
+        mergeVector(_data._bufferAlpha, other._data._bufferAlpha);
+    }
+
+private:
+    static void mergeVector(HistogramVector& v, const HistogramVector& other)
+    {
+        for(std::size_t i = 0; i < v.size(); ++i)
+            v[i] += other[i];
     }
 };
 
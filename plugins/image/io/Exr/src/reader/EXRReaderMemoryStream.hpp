@@ -0,0 +1,65 @@
+#ifndef _TUTTLE_PLUGIN_EXR_READER_MEMORYSTREAM_HPP_
+#define _TUTTLE_PLUGIN_EXR_READER_MEMORYSTREAM_HPP_
+
+#include <tuttle/ioplugin/context/ReaderPrefetcher.hpp>
+
+#include <ImfIO.h>
+#include <ImfInt64.h>
+#include <Iex.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstring>
+#include <string>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace exr
+{
+namespace reader
+{
+
+/**
+ * @brief Exr input stream on the content of a file read in advance (see ReaderPrefetcher)
+ */
+class EXRReaderMemoryStream : public Imf::IStream
+{
+public:
+    typedef ReaderPrefetcher::FileData FileData;
+
+public:
+    EXRReaderMemoryStream(const std::string& filepath, const boost::shared_ptr<const FileData>& data)
+        : Imf::IStream(filepath.c_str())
+        , _data(data)
+        , _position(0)
+    {
+    }
+
+    bool read(char c[], int n)
+    {
+        if(n < 0 || _position + n > _data->size())
+            throw Iex::InputExc("Unexpected end of file.");
+        if(n)
+            std::memcpy(c, &(*_data)[_position], n);
+        _position += n;
+        return _position < _data->size();
+    }
+
+    Imf::Int64 tellg() { return _position; }
+
+    void seekg(Imf::Int64 pos) { _position = pos; }
+
+    void clear() {}
+
+private:
+    boost::shared_ptr<const FileData> _data;
+    Imf::Int64 _position;
+};
+}
+}
+}
+}
+
+#endif
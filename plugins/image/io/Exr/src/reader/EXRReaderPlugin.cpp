@@ -24,6 +24,11 @@ namespace bfs = boost::filesystem;
 using namespace Imf;
 using namespace boost::gil;
 
+EXRFileHeader::EXRFileHeader(const std::string& filepath)
+    : _header(InputFile(filepath.c_str()).header())
+{
+}
+
 EXRReaderPlugin::EXRReaderPlugin(OfxImageEffectHandle handle)
     : ReaderPlugin(handle)
     , _par(1.0)
@@ -128,13 +133,12 @@ void EXRReaderPlugin::changedParam(const OFX::InstanceChangedArgs& args, const s
 
 void EXRReaderPlugin::updateCombos()
 {
-    const std::string filepath(getAbsoluteFirstFilename());
-    if(!bfs::exists(filepath))
+    const boost::shared_ptr<const EXRFileHeader> header = getFileHeader<EXRFileHeader>(getAbsoluteFirstFilename());
+    if(!header)
         return;
 
     // read dims
-    InputFile in(filepath.c_str());
-    const Header& h = in.header();
+    const Header& h = header->_header;
     const ChannelList& cl = h.channels();
 
     _par = h.pixelAspectRatio();
@@ -269,56 +273,57 @@ void EXRReaderPlugin::getClipPreferences(OFX::ClipPreferencesSetter& clipPrefere
 bool EXRReaderPlugin::getRegionOfDefinition(const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod)
 {
     const std::string filepath(getAbsoluteFilenameAt(args.time));
-    if(!bfs::exists(filepath))
+    boost::shared_ptr<const EXRFileHeader> header;
+    try
     {
-        BOOST_THROW_EXCEPTION(exception::FileInSequenceNotExist() << exception::user("EXR: Unable to open file")
+        header = getFileHeader<EXRFileHeader>(filepath);
+    }
+    catch(...)
+    {
+        BOOST_THROW_EXCEPTION(exception::FileInSequenceNotExist() << exception::user("EXR: Unable to open file.")
                                                                   << exception::filename(filepath));
     }
-
-    try
+    if(!header)
     {
-        InputFile in(filepath.c_str());
-        const Header& h = in.header();
-        const Imath::Box2i displayWindow(h.displayWindow());
-        // Exr is top to bottom and OpenFX is bottom to top.
-        const double height = (displayWindow.max.y - displayWindow.min.y) + 1;
+        BOOST_THROW_EXCEPTION(exception::FileInSequenceNotExist() << exception::user("EXR: Unable to open file")
+                                                                  << exception::filename(filepath));
+    }
 
-        if(_paramOutputData->getValue() == 0)
-        {
-            rod.x1 = displayWindow.min.x;
-            rod.x2 = displayWindow.max.x + 1;
-            rod.y1 = height - (displayWindow.max.y + 1);
-            rod.y2 = height - displayWindow.min.y;
-        }
-        else
-        {
-            const Imath::Box2i dataWindow(h.dataWindow());
-
-            //			TUTTLE_LOG_INFO( "ExrReaderPlugin: displayWindow: " << displayWindow.min.x << ", " <<
-            // displayWindow.min.y
-            //<< ", " << displayWindow.max.x << ", " << displayWindow.max.y );
-            //			TUTTLE_LOG_INFO( "ExrReaderPlugin: dataWindow: " << h.dataWindow().min.x << ", " <<
-            // h.dataWindow().min.y
-            //<< ", " << h.dataWindow().max.x << ", " << h.dataWindow().max.y );
-
-            rod.x1 = dataWindow.min.x;
-            rod.x2 = dataWindow.max.x + 1;
-            rod.y1 = height - (dataWindow.max.y + 1);
-            rod.y2 = height - dataWindow.min.y;
-        }
-        rod.x1 *= h.pixelAspectRatio();
-        rod.x2 *= h.pixelAspectRatio();
+    const Header& h = header->_header;
+    const Imath::Box2i displayWindow(h.displayWindow());
+    // Exr is top to bottom and OpenFX is bottom to top.
+    const double height = (displayWindow.max.y - displayWindow.min.y) + 1;
 
-        rod.x1 *= args.renderScale.x;
-        rod.x2 *= args.renderScale.x;
-        rod.y1 *= args.renderScale.y;
-        rod.y2 *= args.renderScale.y;
+    if(_paramOutputData->getValue() == 0)
+    {
+        rod.x1 = displayWindow.min.x;
+        rod.x2 = displayWindow.max.x + 1;
+        rod.y1 = height - (displayWindow.max.y + 1);
+        rod.y2 = height - displayWindow.min.y;
     }
-    catch(...)
+    else
     {
-        BOOST_THROW_EXCEPTION(exception::FileInSequenceNotExist() << exception::user("EXR: Unable to open file.")
-                                                                  << exception::filename(getAbsoluteFilenameAt(args.time)));
+        const Imath::Box2i dataWindow(h.dataWindow());
+
+        //			TUTTLE_LOG_INFO( "ExrReaderPlugin: displayWindow: " << displayWindow.min.x << ", " <<
+        // displayWindow.min.y
+        //<< ", " << displayWindow.max.x << ", " << displayWindow.max.y );
+        //			TUTTLE_LOG_INFO( "ExrReaderPlugin: dataWindow: " << h.dataWindow().min.x << ", " <<
+        // h.dataWindow().min.y
+        //<< ", " << h.dataWindow().max.x << ", " << h.dataWindow().max.y );
+
+        rod.x1 = dataWindow.min.x;
+        rod.x2 = dataWindow.max.x + 1;
+        rod.y1 = height - (dataWindow.max.y + 1);
+        rod.y2 = height - dataWindow.min.y;
     }
+    rod.x1 *= h.pixelAspectRatio();
+    rod.x2 *= h.pixelAspectRatio();
+
+    rod.x1 *= args.renderScale.x;
+    rod.x2 *= args.renderScale.x;
+    rod.y1 *= args.renderScale.y;
+    rod.y2 *= args.renderScale.y;
     return true;
 }
 
@@ -3,6 +3,7 @@
 
 #include <tuttle/ioplugin/context/ReaderPlugin.hpp>
 #include <ImfInputFile.h>
+#include <ImfHeader.h>
 
 namespace tuttle
 {
@@ -27,6 +28,16 @@ struct EXRReaderProcessParams
     bool _displayWindow;
 };
 
+/**
+ * @brief Header of an exr file, shared by the RoD, the clip preferences and the render
+ */
+struct EXRFileHeader : public ReaderFileHeader
+{
+    explicit EXRFileHeader(const std::string& filepath);
+
+    Imf::Header _header;
+};
+
 /**
  * @brief Exr reader
  */
@@ -46,6 +57,9 @@ public:
     const std::vector<std::string>& channelNames() const { return _channelNames; }
     const std::vector<OFX::ChoiceParam*>& channelChoice() const { return _paramsChannelChoice; }
 
+protected:
+    bool usePrefetchedFiles() const { return true; }
+
 private:
     void updateCombos();
 
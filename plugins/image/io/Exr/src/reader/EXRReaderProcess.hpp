@@ -8,6 +8,8 @@
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
 
+#include "EXRReaderMemoryStream.hpp"
+
 #include <ImfInputFile.h>
 
 #include <boost/scoped_ptr.hpp>
@@ -33,7 +35,8 @@ protected:
 
     EXRReaderPlugin& _plugin; ///< Rendering plugin
     EXRReaderProcessParams _params;
-    boost::scoped_ptr<Imf::InputFile> _exrImage; ///< Pointer to an exr image
+    boost::scoped_ptr<EXRReaderMemoryStream> _exrStream; ///< Content of the file if it was read in advance
+    boost::scoped_ptr<Imf::InputFile> _exrImage;         ///< Pointer to an exr image
 
     template <typename PixelType>
     void initExrChannel(DataVector& data, Imf::Slice& slice, Imf::FrameBuffer& frameBuffer, Imf::PixelType pixelType,
@@ -54,7 +57,7 @@ public:
 
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
 
-    void readImage(const std::string& filepath);
+    void readImage();
 };
 }
 }
@@ -62,7 +62,16 @@ void EXRReaderProcess<View>::setup(const OFX::RenderArguments& args)
 
     try
     {
-        _exrImage.reset(new Imf::InputFile(_params._filepath.c_str()));
+        const boost::shared_ptr<const ReaderPrefetcher::FileData> data = _plugin.getPrefetchedFile(_params._filepath);
+        if(data)
+        {
+            _exrStream.reset(new EXRReaderMemoryStream(_params._filepath, data));
+            _exrImage.reset(new Imf::InputFile(*_exrStream));
+        }
+        else
+        {
+            _exrImage.reset(new Imf::InputFile(_params._filepath.c_str()));
+        }
     }
     catch(...)
     {
@@ -86,7 +95,7 @@ void EXRReaderProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow
 
     try
     {
-        readImage(_params._filepath);
+        readImage();
     }
     catch(boost::exception& e)
     {
@@ -103,15 +112,15 @@ void EXRReaderProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow
 }
 
 template <class View>
-void EXRReaderProcess<View>::readImage(const std::string& filepath)
+void EXRReaderProcess<View>::readImage()
 {
     using namespace boost;
     using namespace mpl;
     using namespace boost::gil;
     using namespace Imf;
 
-    EXRReaderProcessParams params = _plugin.getProcessParams(this->_renderArgs.time);
-    Imf::InputFile in(filepath.c_str());
+    // the file opened by setup
+    Imf::InputFile& in = *_exrImage;
 
     int nbChannels = std::min(_params._fileNbChannels, int(num_channels<View>::type::value));
     nbChannels = std::min(nbChannels, _params._userNbComponents);
@@ -122,7 +131,7 @@ void EXRReaderProcess<View>::readImage(const std::string& filepath)
                               << exception::user() + "EXR: doesn't support " + _params._fileNbChannels + " channels.");
     }
 
-    channelCopy(in, params, this->_dstView, nbChannels);
+    channelCopy(in, _params, this->_dstView, nbChannels);
 }
 
 template <class View>
@@ -130,6 +130,7 @@ void Jpeg2000ReaderPlugin::getClipPreferences(OFX::ClipPreferencesSetter& clipPr
  */
 void Jpeg2000ReaderPlugin::render(const OFX::RenderArguments& args)
 {
+    ReaderPlugin::render(args);
     if(retrieveFileInfo(args.time)._failed)
     {
         BOOST_THROW_EXCEPTION(exception::BitDepthMismatch() << exception::user("Jpeg2000: get file info failed"));
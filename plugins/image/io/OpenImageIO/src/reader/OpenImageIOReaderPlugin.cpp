@@ -20,6 +20,22 @@ namespace reader
 namespace bfs = boost::filesystem;
 using namespace boost::gil;
 
+OpenImageIOFileHeader::OpenImageIOFileHeader(const std::string& filepath)
+{
+    boost::scoped_ptr<OpenImageIO::ImageInput> in(OpenImageIO::ImageInput::create(filepath));
+    if(!in)
+    {
+        BOOST_THROW_EXCEPTION(exception::File() << exception::user("OpenImageIO: Unable to open file")
+                                                << exception::filename(filepath));
+    }
+    if(!in->open(filepath, _spec))
+    {
+        BOOST_THROW_EXCEPTION(exception::Unknown() << exception::user("OIIO Reader: " + in->geterror())
+                                                   << exception::filename(filepath));
+    }
+    in->close();
+}
+
 OpenImageIOReaderPlugin::OpenImageIOReaderPlugin(OfxImageEffectHandle handle)
     : ReaderPlugin(handle)
 {
@@ -42,32 +58,17 @@ bool OpenImageIOReaderPlugin::getRegionOfDefinition(const OFX::RegionOfDefinitio
 {
     const std::string filename(getAbsoluteFilenameAt(args.time));
 
-    if(!bfs::exists(filename))
+    const boost::shared_ptr<const OpenImageIOFileHeader> header = getFileHeader<OpenImageIOFileHeader>(filename);
+    if(!header)
     {
         BOOST_THROW_EXCEPTION(exception::FileInSequenceNotExist() << exception::user("OpenImageIO: Unable to open file")
                                                                   << exception::filename(filename));
     }
 
-    boost::scoped_ptr<OpenImageIO::ImageInput> in(OpenImageIO::ImageInput::create(filename));
-    if(!in)
-    {
-        BOOST_THROW_EXCEPTION(exception::File() << exception::user("OpenImageIO: Unable to open file")
-                                                << exception::filename(filename));
-    }
-    OpenImageIO::ImageSpec spec;
-
-    if(!in->open(filename, spec))
-    {
-        BOOST_THROW_EXCEPTION(exception::Unknown() << exception::user("OIIO Reader: " + in->geterror())
-                                                   << exception::filename(filename));
-    }
-
     rod.x1 = 0;
-    rod.x2 = spec.width * this->_clipDst->getPixelAspectRatio();
+    rod.x2 = header->_spec.width * this->_clipDst->getPixelAspectRatio();
     rod.y1 = 0;
-    rod.y2 = spec.height;
-
-    in->close();
+    rod.y2 = header->_spec.height;
     return true;
 }
 
@@ -77,12 +78,6 @@ void OpenImageIOReaderPlugin::getClipPreferences(OFX::ClipPreferencesSetter& cli
 
     const std::string filename(getAbsoluteFirstFilename());
 
-    if(!bfs::exists(filename))
-    {
-        BOOST_THROW_EXCEPTION(exception::FileInSequenceNotExist() << exception::user("OpenImageIO: Unable to open file")
-                                                                  << exception::filename(filename));
-    }
-
     // if no filename
     if(filename.size() == 0)
     {
@@ -92,20 +87,13 @@ void OpenImageIOReaderPlugin::getClipPreferences(OFX::ClipPreferencesSetter& cli
         return;
     }
 
-    OpenImageIO::ImageInput* in = OpenImageIO::ImageInput::create(filename);
-
-    if(!in)
-    {
-        BOOST_THROW_EXCEPTION(exception::Unknown() << exception::user("OIIO Reader: " + in->geterror())
-                                                   << exception::filename(filename));
-    }
-
-    OpenImageIO::ImageSpec spec;
-    if(!in->open(filename, spec))
+    const boost::shared_ptr<const OpenImageIOFileHeader> header = getFileHeader<OpenImageIOFileHeader>(filename);
+    if(!header)
     {
-        BOOST_THROW_EXCEPTION(exception::Unknown() << exception::user("OIIO Reader: " + in->geterror())
-                                                   << exception::filename(filename));
+        BOOST_THROW_EXCEPTION(exception::FileInSequenceNotExist() << exception::user("OpenImageIO: Unable to open file")
+                                                                  << exception::filename(filename));
     }
+    const OpenImageIO::ImageSpec& spec = header->_spec;
 
     if(getExplicitBitDepthConversion() == eParamReaderBitDepthAuto)
     {
@@ -144,7 +132,6 @@ void OpenImageIOReaderPlugin::getClipPreferences(OFX::ClipPreferencesSetter& cli
             case OpenImageIO::TypeDesc::NONE:
             default:
             {
-                in->close();
                 BOOST_THROW_EXCEPTION(exception::ImageFormat() << exception::user("bad input format"));
             }
         }
@@ -179,7 +166,6 @@ void OpenImageIOReaderPlugin::getClipPreferences(OFX::ClipPreferencesSetter& cli
 
     const float par = spec.get_float_attribute("PixelAspectRatio", 1.0f);
     clipPreferences.setPixelAspectRatio(*this->_clipDst, par);
-    in->close();
 }
 
 /**
@@ -3,6 +3,8 @@
 
 #include <tuttle/ioplugin/context/ReaderPlugin.hpp>
 
+#include <imageio.h>
+
 namespace tuttle
 {
 namespace plugin
@@ -17,6 +19,16 @@ struct OpenImageIOReaderProcessParams
     std::string _filepath; ///< filepath
 };
 
+/**
+ * @brief Header of a file read by OpenImageIO, shared by the RoD, the clip preferences and the render
+ */
+struct OpenImageIOFileHeader : public ReaderFileHeader
+{
+    explicit OpenImageIOFileHeader(const std::string& filepath);
+
+    OpenImageIO::ImageSpec _spec;
+};
+
 /**
  * @brief OpenImageIO reader
  *
@@ -27,6 +27,7 @@ class png_reader_info : public file_mgr
 protected:
     png_structp _png_ptr;
     png_infop _info_ptr;
+    png_uint_32 width, height;
     int bit_depth, color_type, interlace_type;
 
 public:
@@ -73,11 +74,10 @@ public:
 
     void read_header()
     {
-        png_uint_32 width, height;
-
         png_get_IHDR(_png_ptr, _info_ptr, &width, &height, &bit_depth, &color_type, &interlace_type, int_p_NULL, int_p_NULL);
     }
 
+    point2<std::ptrdiff_t> get_dimensions() { return point2<std::ptrdiff_t>(width, height); }
     int get_bit_depth() { return bit_depth; }
     int get_color_type() { return color_type; }
     int get_interlace_type() { return interlace_type; }
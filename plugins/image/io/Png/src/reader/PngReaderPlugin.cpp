@@ -21,6 +21,18 @@ namespace reader
 
 namespace bfs = boost::filesystem;
 
+PngFileHeader::PngFileHeader(const std::string& filepath)
+{
+    // all the values from a single open of the file
+    detail::png_reader_info info(filepath);
+    info.read_header();
+    const point2<std::ptrdiff_t> dimensions = info.get_dimensions();
+    _width = dimensions.x;
+    _height = dimensions.y;
+    _bitDepth = info.get_bit_depth();
+    _colorType = info.get_color_type();
+}
+
 PngReaderPlugin::PngReaderPlugin(OfxImageEffectHandle handle)
     : ReaderPlugin(handle)
 {
@@ -42,26 +54,27 @@ void PngReaderPlugin::changedParam(const OFX::InstanceChangedArgs& args, const s
 bool PngReaderPlugin::getRegionOfDefinition(const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod)
 {
     const std::string filename(getAbsoluteFilenameAt(args.time));
-    if(!boost::filesystem::exists(filename))
-    {
-        BOOST_THROW_EXCEPTION(exception::FileInSequenceNotExist() << exception::user("PNG: Unable to open file")
-                                                                  << exception::filename(filename));
-    }
-
+    boost::shared_ptr<const PngFileHeader> header;
     try
     {
-        point2<ptrdiff_t> pngDims = png_read_dimensions(filename);
-        rod.x1 = 0;
-        rod.x2 = pngDims.x * this->_clipDst->getPixelAspectRatio();
-        rod.y1 = 0;
-        rod.y2 = pngDims.y;
-        TUTTLE_LOG_VAR(TUTTLE_INFO, rod);
+        header = getFileHeader<PngFileHeader>(filename);
     }
     catch(std::exception& e)
     {
         BOOST_THROW_EXCEPTION(exception::FileNotExist() << exception::user("PNG: Unable to open file")
                                                         << exception::dev(e.what()) << exception::filename(filename));
     }
+    if(!header)
+    {
+        BOOST_THROW_EXCEPTION(exception::FileInSequenceNotExist() << exception::user("PNG: Unable to open file")
+                                                                  << exception::filename(filename));
+    }
+
+    rod.x1 = 0;
+    rod.x2 = header->_width * this->_clipDst->getPixelAspectRatio();
+    rod.y1 = 0;
+    rod.y2 = header->_height;
+    TUTTLE_LOG_VAR(TUTTLE_INFO, rod);
     return true;
 }
 
@@ -70,18 +83,22 @@ void PngReaderPlugin::getClipPreferences(OFX::ClipPreferencesSetter& clipPrefere
     ReaderPlugin::getClipPreferences(clipPreferences);
     const std::string filename(getAbsoluteFirstFilename());
 
-    if(getExplicitBitDepthConversion() == eParamReaderBitDepthAuto)
+    boost::shared_ptr<const PngFileHeader> header;
+    if(getExplicitBitDepthConversion() == eParamReaderBitDepthAuto ||
+       getExplicitChannelConversion() == eParamReaderChannelAuto)
     {
-        OFX::EBitDepth bd = OFX::eBitDepthNone;
-        if(!boost::filesystem::exists(filename))
+        header = getFileHeader<PngFileHeader>(filename);
+        if(!header)
         {
             BOOST_THROW_EXCEPTION(exception::FileNotExist() << exception::user("PNG: Unable to open file")
                                                             << exception::filename(filename));
         }
-        int bitDepth;
-        bitDepth = png_read_precision(filename);
+    }
 
-        switch(bitDepth)
+    if(getExplicitBitDepthConversion() == eParamReaderBitDepthAuto)
+    {
+        OFX::EBitDepth bd = OFX::eBitDepthNone;
+        switch(header->_bitDepth)
         {
             case 8:
                 bd = OFX::eBitDepthUByte;
@@ -97,7 +114,7 @@ void PngReaderPlugin::getClipPreferences(OFX::ClipPreferencesSetter& clipPrefere
 
     if(getExplicitChannelConversion() == eParamReaderChannelAuto)
     {
-        switch(png_read_color_type(filename))
+        switch(header->_colorType)
         {
             case 0:
                 clipPreferences.setClipComponents(*this->_clipDst, OFX::ePixelComponentAlpha);
@@ -17,6 +17,19 @@ struct PngReaderProcessParams
     std::string _filepath; ///< filepath
 };
 
+/**
+ * @brief Header of a png file, shared by the RoD, the clip preferences and the render
+ */
+struct PngFileHeader : public ReaderFileHeader
+{
+    explicit PngFileHeader(const std::string& filepath);
+
+    std::ptrdiff_t _width;
+    std::ptrdiff_t _height;
+    int _bitDepth;
+    int _colorType;
+};
+
 /**
  * @brief Png reader
  *
@@ -38,6 +38,7 @@ void ColorTransformPluginFactory::describe(OFX::ImageEffectDescriptor& desc)
 
     // plugin flags
     desc.setSupportsTiles(kSupportTiles);
+    desc.setPointWise(true);
     desc.setRenderThreadSafety(OFX::eRenderFullySafe);
 }
 
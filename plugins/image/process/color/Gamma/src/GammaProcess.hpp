@@ -1,8 +1,14 @@
 #ifndef _TUTTLE_PLUGIN_GAMMA_PROCESS_HPP_
 #define _TUTTLE_PLUGIN_GAMMA_PROCESS_HPP_
 
+#include "GammaPlugin.hpp"
+
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
-#include <boost/scoped_ptr.hpp>
+#include <terry/numeric/pixel_lut.hpp>
+
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 namespace tuttle
 {
@@ -11,6 +17,35 @@ namespace plugin
 namespace gamma
 {
 
+/**
+ * @brief Gamma correction of a pixel, the reference implementation.
+ */
+template <class Pixel>
+struct GammaPixel
+{
+    GammaProcessParams<float> _params;
+
+    GammaPixel(const GammaProcessParams<float>& params)
+        : _params(params)
+    {
+    }
+
+    Pixel operator()(const Pixel& src) const;
+};
+
+/// integer channels: lookup table built once per render
+struct GammaLutTag
+{
+};
+/// interleaved float RGB(A) channels: vectorized polynomial approximation of pow
+struct GammaFastPowTag
+{
+};
+/// other images: evaluation of the gamma on each pixel
+struct GammaPixelTag
+{
+};
+
 /**
  * @brief Gamma process
  *
@@ -20,14 +55,40 @@ class GammaProcess : public ImageGilFilterProcessor<View>
 {
 public:
     typedef float Scalar;
+    typedef typename View::value_type Pixel;
+    typedef typename boost::gil::channel_type<View>::type Channel;
+    typedef typename boost::mpl::if_c<
+        boost::is_integral<typename boost::gil::channel_traits<Channel>::value_type>::value, GammaLutTag,
+        typename boost::mpl::if_c<(boost::gil::num_channels<View>::value >= 3 && !boost::gil::is_planar<View>::value),
+                                  GammaFastPowTag, GammaPixelTag>::type>::type ProcessTag;
 
 protected:
     GammaPlugin& _plugin; ///< Rendering plugin
+    GammaProcessParams<Scalar> _params;
+    float _exponents[4]; ///< exponent of each channel, for the float images
 
 public:
     GammaProcess(GammaPlugin& effect);
 
+    void setup(const OFX::RenderArguments& args);
+
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
+
+private:
+    void setupLut(GammaLutTag);
+    void setupLut(GammaFastPowTag) {}
+    void setupLut(GammaPixelTag) {}
+
+    void processRow(typename View::x_iterator src_it, typename View::x_iterator dst_it, const int width,
+                    GammaLutTag) const;
+    void processRow(typename View::x_iterator src_it, typename View::x_iterator dst_it, const int width,
+                    GammaFastPowTag) const;
+    void processRow(typename View::x_iterator src_it, typename View::x_iterator dst_it, const int width,
+                    GammaPixelTag) const;
+
+    /// only allocated for the integer images
+    typename boost::mpl::if_<boost::is_same<ProcessTag, GammaLutTag>, terry::numeric::pixel_lut<Pixel>, int>::type
+        _lut;
 };
 }
 }
@@ -1,8 +1,11 @@
 #include <terry/globals.hpp>
+#include <terry/numeric/fast_pow.hpp>
 #include <tuttle/plugin/exceptions.hpp>
 
 #include "GammaPlugin.hpp"
 
+#include <cmath>
+
 namespace tuttle
 {
 namespace plugin
@@ -10,6 +13,37 @@ namespace plugin
 namespace gamma
 {
 
+template <class Pixel>
+Pixel GammaPixel<Pixel>::operator()(const Pixel& src) const
+{
+    using namespace boost::gil;
+    rgba32f_pixel_t wpix;
+    // x^a = e^aln(x)
+    color_convert(src, wpix);
+    if(wpix[0] > 0.0)
+    {
+        wpix[0] = exp(log(wpix[0]) * _params.iRGamma);
+    }
+
+    if(wpix[1] > 0.0)
+    {
+        wpix[1] = exp(log(wpix[1]) * _params.iGGamma);
+    }
+
+    if(wpix[2] > 0.0)
+    {
+        wpix[2] = exp(log(wpix[2]) * _params.iBGamma);
+    }
+
+    if(wpix[3] > 0.0)
+    {
+        wpix[3] = exp(log(wpix[3]) * _params.iAGamma);
+    }
+    Pixel dst;
+    color_convert(wpix, dst);
+    return dst;
+}
+
 template <class View>
 GammaProcess<View>::GammaProcess(GammaPlugin& effect)
     : ImageGilFilterProcessor<View>(effect, eImageOrientationIndependant)
@@ -17,6 +51,25 @@ GammaProcess<View>::GammaProcess(GammaPlugin& effect)
 {
 }
 
+template <class View>
+void GammaProcess<View>::setup(const OFX::RenderArguments& args)
+{
+    ImageGilFilterProcessor<View>::setup(args);
+    _params = _plugin.getProcessParams(args.renderScale);
+    _exponents[0] = _params.iRGamma;
+    _exponents[1] = _params.iGGamma;
+    _exponents[2] = _params.iBGamma;
+    _exponents[3] = _params.iAGamma;
+    setupLut(ProcessTag());
+}
+
+template <class View>
+void GammaProcess<View>::setupLut(GammaLutTag)
+{
+    // 256 or 65536 evaluations instead of one per pixel
+    _lut.build(GammaPixel<Pixel>(_params));
+}
+
 /**
  * @brief Function called by rendering thread each time a process must be done.
  * @param[in] procWindowRoW  Processing window
@@ -24,57 +77,43 @@ GammaProcess<View>::GammaProcess(GammaPlugin& effect)
 template <class View>
 void GammaProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 {
-    using namespace boost::gil;
-    GammaProcessParams<GammaPlugin::Scalar> params = _plugin.getProcessParams();
     OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates(procWindowRoW);
     const OfxPointI procWindowSize = {procWindowRoW.x2 - procWindowRoW.x1, procWindowRoW.y2 - procWindowRoW.y1};
 
-    rgba32f_pixel_t wpix;
-
     for(int y = procWindowOutput.y1; y < procWindowOutput.y2; ++y)
     {
-        typename View::x_iterator src_it = this->_srcView.x_at(procWindowOutput.x1, y);
-        typename View::x_iterator dst_it = this->_dstView.x_at(procWindowOutput.x1, y);
-        for(int x = procWindowOutput.x1; x < procWindowOutput.x2; ++x, ++src_it, ++dst_it)
-        {
-            // x^a = e^aln(x)
-            color_convert(*src_it, wpix);
-            if(wpix[0] > 0.0)
-            {
-                wpix[0] = exp(log(wpix[0]) * params.iRGamma);
-            }
-
-            if(wpix[1] > 0.0)
-            {
-                wpix[1] = exp(log(wpix[1]) * params.iGGamma);
-            }
-
-            if(wpix[2] > 0.0)
-            {
-                wpix[2] = exp(log(wpix[2]) * params.iBGamma);
-            }
-
-            if(wpix[3] > 0.0)
-            {
-                wpix[3] = exp(log(wpix[3]) * params.iAGamma);
-            }
-            color_convert(wpix, *dst_it);
-        }
+        processRow(this->_srcView.x_at(procWindowOutput.x1, y), this->_dstView.x_at(procWindowOutput.x1, y),
+                   procWindowSize.x, ProcessTag());
         if(this->progressForward(procWindowSize.x))
             return;
     }
-    /*
-       const OfxRectI procWindowSrc = this->translateRegion( procWindowRoW, this->_srcPixelRod );
-       OfxPointI procWindowSize = { procWindowRoW.x2 - procWindowRoW.x1,
-                                 procWindowRoW.y2 - procWindowRoW.y1 };
-       View src = subimage_view( this->_srcView, procWindowSrc.x1, procWindowSrc.y1,
-                              procWindowSize.x,
-                              procWindowSize.y );
-       View dst = subimage_view( this->_dstView, procWindowOutput.x1, procWindowOutput.y1,
-                              procWindowSize.x,
-                              procWindowSize.y );
-       copy_pixels( src, dst );
-     */
+}
+
+template <class View>
+void GammaProcess<View>::processRow(typename View::x_iterator src_it, typename View::x_iterator dst_it,
+                                    const int width, GammaLutTag) const
+{
+    for(int x = 0; x < width; ++x, ++src_it, ++dst_it)
+        *dst_it = _lut(*src_it);
+}
+
+template <class View>
+void GammaProcess<View>::processRow(typename View::x_iterator src_it, typename View::x_iterator dst_it,
+                                    const int width, GammaFastPowTag) const
+{
+    // interleaved float channels, contiguous along the row
+    static const std::size_t nbChannels = boost::gil::num_channels<View>::value;
+    terry::numeric::pow_floats(reinterpret_cast<const float*>(&(*src_it)[0]), width * nbChannels, _exponents,
+                               nbChannels, reinterpret_cast<float*>(&(*dst_it)[0]));
+}
+
+template <class View>
+void GammaProcess<View>::processRow(typename View::x_iterator src_it, typename View::x_iterator dst_it,
+                                    const int width, GammaPixelTag) const
+{
+    const GammaPixel<Pixel> gammaPixel(_params);
+    for(int x = 0; x < width; ++x, ++src_it, ++dst_it)
+        *dst_it = gammaPixel(*src_it);
 }
 }
 }
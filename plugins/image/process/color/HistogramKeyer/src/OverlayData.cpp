@@ -3,7 +3,9 @@
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 
-#include <terry/algorithm/transform_pixels.hpp>
+#include <tuttle/plugin/ReduceExecutor.hpp>
+
+#include <terry/algorithm/reduce_pixels.hpp>
 
 namespace tuttle
 {
@@ -41,10 +43,12 @@ void OverlayData::computeHistogramBufferData(HistogramBufferData& data, SView& s
     BOOST_ASSERT(srcView.width() == std::size_t(_size.x));
     BOOST_ASSERT(srcView.height() == std::size_t(_size.y));
 
-    Pixel_compute_histograms funct(_imgBool, data, isSelection); // functor declaration
-
-    terry::algorithm::transform_pixels(srcView, funct); //(USED functor reference)
-    // boost::gil::for_each_pixel(srcView, funct);		(NOT USED)
+    // parallel reduction of the histograms, from the empty buffers of data
+    const Pixel_compute_histograms empty(data);
+    if(isSelection)
+        data = terry::algorithm::reduce_pixels(srcView, selection_view(_imgBool), empty, ReduceExecutor())._data;
+    else
+        data = terry::algorithm::reduce_pixels(srcView, empty, ReduceExecutor())._data;
 
     this->correctHistogramBufferData(data); // correct Histogram data to make up for discretization (average)
 }
@@ -381,8 +385,9 @@ void OverlayData::computeCurveFromSelectionData(OFX::Clip* clipSrc, const OfxTim
         clearAll(imgSize);
     }
     // Compute histogram buffer
-    Pixel_compute_histograms funct(_imgBool, _curveFromSelection, true); // functor declaration
-    terry::algorithm::transform_pixels(srcView, funct);                  //(USED functor reference)
+    const Pixel_compute_histograms empty(_curveFromSelection);
+    _curveFromSelection =
+        terry::algorithm::reduce_pixels(srcView, selection_view(_imgBool), empty, ReduceExecutor())._data;
 
     this->correctHistogramBufferData(_curveFromSelection); // correct Histogram data to make up for discretization (average)
 }
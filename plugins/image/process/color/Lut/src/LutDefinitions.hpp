@@ -12,6 +12,16 @@ namespace lut
 
 static const std::string kHelp = "help";
 static const std::string kInputFilenameLabel = "3D Lut input filename";
+
+static const std::string kParamInterpolation = "interpolation";
+static const std::string kParamInterpolationTetrahedral = "Tetrahedral";
+static const std::string kParamInterpolationTrilinear = "Trilinear";
+
+enum EParamInterpolation
+{
+    eParamInterpolationTetrahedral = 0,
+    eParamInterpolationTrilinear
+};
 }
 }
 }
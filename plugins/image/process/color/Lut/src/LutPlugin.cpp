@@ -21,6 +21,7 @@ LutPlugin::LutPlugin(OfxImageEffectHandle handle)
     : ImageEffectGilPlugin(handle)
 {
     _sFilename = fetchStringParam(kTuttlePluginFilename);
+    _paramInterpolation = fetchChoiceParam(kParamInterpolation);
 }
 
 /**
@@ -41,7 +42,7 @@ void LutPlugin::render(const OFX::RenderArguments& args)
         {
             BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to read lut file."));
         }
-        _lut3D.reset(new TetraInterpolator(), _lutReader);
+        compileLut();
     }
     if(!_lutReader.readOk())
     {
@@ -62,10 +63,21 @@ void LutPlugin::changedParam(const OFX::InstanceChangedArgs& args, const std::st
             {
                 BOOST_THROW_EXCEPTION(exception::File() << exception::user("Unable to read lut file..."));
             }
-            _lut3D.reset(new TetraInterpolator(), _lutReader);
+            compileLut();
         }
     }
 }
+
+void LutPlugin::compileLut()
+{
+    const std::size_t dimSize = _lutReader.steps().size();
+    if(dimSize < 2 || _lutReader.data().size() != dimSize * dimSize * dimSize * 3)
+    {
+        BOOST_THROW_EXCEPTION(exception::File() << exception::user("Invalid lut file: wrong lattice size."));
+    }
+    _lut3D.reset(new TetraInterpolator(), _lutReader);
+    _compiledLut.compile(_lut3D, _lutReader.steps());
+}
 }
 }
 }
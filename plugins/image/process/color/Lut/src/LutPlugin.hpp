@@ -3,6 +3,7 @@
 
 #include "lutEngine/LutReader.hpp"
 #include "lutEngine/Lut.hpp"
+#include "lutEngine/CompiledLut.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
@@ -26,11 +27,17 @@ public:
     void render(const OFX::RenderArguments& args);
     void changedParam(const OFX::InstanceChangedArgs& args, const std::string& paramName);
 
+private:
+    /// Set the lut from the file read and bake it for the render
+    void compileLut();
+
 public:
-    OFX::StringParam* _sFilename; ///< Filename
+    OFX::StringParam* _sFilename;          ///< Filename
+    OFX::ChoiceParam* _paramInterpolation; ///< Interpolation between the lattice nodes
 
     LutReader _lutReader; ///< Reader
     Lut3D _lut3D;
+    CompiledLut3D _compiledLut; ///< Lut3D baked for the render
 };
 }
 }
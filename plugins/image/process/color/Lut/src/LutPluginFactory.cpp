@@ -35,6 +35,7 @@ void LutPluginFactory::describe(OFX::ImageEffectDescriptor& desc)
     desc.addSupportedBitDepth(OFX::eBitDepthFloat);
 
     desc.setSupportsTiles(kSupportTiles);
+    desc.setPointWise(true);
     // desc.setRenderThreadSafety( OFX::eRenderFullySafe ); //< @todo tuttle: remove process data from LutPlugin
 }
 
@@ -62,6 +63,15 @@ void LutPluginFactory::describeInContext(OFX::ImageEffectDescriptor& desc, OFX::
     filename->setDefault("");
     filename->setLabels(kTuttlePluginFilenameLabel, kTuttlePluginFilenameLabel, kTuttlePluginFilenameLabel);
     filename->setStringType(OFX::eStringTypeFilePath);
+
+    OFX::ChoiceParamDescriptor* interpolation = desc.defineChoiceParam(kParamInterpolation);
+    interpolation->setLabel("Interpolation");
+    interpolation->appendOption(kParamInterpolationTetrahedral, "Tetrahedral: 4 lattice nodes per pixel");
+    interpolation->appendOption(kParamInterpolationTrilinear, "Trilinear: 8 lattice nodes per pixel");
+    interpolation->setHint("Interpolation between the nodes of the lut lattice.\n"
+                           "Tetrahedral: preserves the neutral axis of the lut, the usual choice for color luts.\n"
+                           "Trilinear: weighted average of the 8 nodes of the lattice cell around the color.");
+    interpolation->setDefault(eParamInterpolationTetrahedral);
 }
 
 /**
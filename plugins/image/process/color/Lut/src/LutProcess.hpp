@@ -2,6 +2,7 @@
 #define _TUTTLE_PLUGIN_LUTPROCESS_HPP_
 
 #include "LutPlugin.hpp"
+#include "LutDefinitions.hpp"
 #include "lutEngine/LutReader.hpp"
 #include "lutEngine/Lut.hpp"
 
@@ -28,8 +29,9 @@ template <class View>
 class LutProcess : public ImageGilFilterProcessor<View>
 {
 private:
-    Lut3D* _lut3D;      ///< Lut3D
-    LutPlugin& _plugin; ///< Rendering plugin
+    const CompiledLut3D* _lut;          ///< Lut3D baked by the plugin
+    LutPlugin& _plugin;                 ///< Rendering plugin
+    EParamInterpolation _interpolation; ///< Interpolation kernel
 
 public:
     LutProcess<View>(LutPlugin& instance);
@@ -37,6 +39,7 @@ public:
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
 
     // Lut3D Transform
+    template <class Kernel>
     void applyLut(View& dst, View& src, const OfxRectI& procWindow);
 };
 }
@@ -33,7 +33,8 @@ LutProcess<View>::LutProcess(LutPlugin& instance)
     : ImageGilFilterProcessor<View>(instance, eImageOrientationIndependant)
     , _plugin(instance)
 {
-    _lut3D = &_plugin._lut3D;
+    _lut = &_plugin._compiledLut;
+    _interpolation = static_cast<EParamInterpolation>(_plugin._paramInterpolation->getValue());
 }
 
 /**
@@ -45,16 +46,27 @@ void LutProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 {
     OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates(procWindowRoW);
 
-    applyLut(this->_dstView, this->_srcView, procWindowOutput);
+    switch(_interpolation)
+    {
+        case eParamInterpolationTetrahedral:
+            applyLut<TetraKernel>(this->_dstView, this->_srcView, procWindowOutput);
+            break;
+        case eParamInterpolationTrilinear:
+            applyLut<TrilinKernel>(this->_dstView, this->_srcView, procWindowOutput);
+            break;
+    }
 }
 
 template <class View>
+template <class Kernel>
 void LutProcess<View>::applyLut(View& dst, View& src, const OfxRectI& procWindow)
 {
     using namespace terry;
     typedef typename View::x_iterator vIterator;
     typedef typename channel_type<View>::type Pixel;
     const OfxPointI procWindowSize = {procWindow.x2 - procWindow.x1, procWindow.y2 - procWindow.y1};
+    const CompiledLut3D& lut = *_lut;
+    float col[CompiledLut3D::kNodeSize];
 
     for(int y = procWindow.y1; y < procWindow.y2; ++y)
     {
@@ -62,10 +74,12 @@ void LutProcess<View>::applyLut(View& dst, View& src, const OfxRectI& procWindow
         vIterator dit = dst.row_begin(y);
         for(int x = procWindow.x1; x < procWindow.x2; ++x)
         {
-            tuttle::Color col = _lut3D->getColor((*sit)[0], (*sit)[1], (*sit)[2]);
-            (*dit)[0] = static_cast<Pixel>(col.x);
-            (*dit)[1] = static_cast<Pixel>(col.y);
-            (*dit)[2] = static_cast<Pixel>(col.z);
+            // the lut works on normalized values, whatever the bit depth
+            lut.apply<Kernel>(channel_convert<bits32f>((*sit)[0]), channel_convert<bits32f>((*sit)[1]),
+                              channel_convert<bits32f>((*sit)[2]), col);
+            (*dit)[0] = channel_convert<Pixel>(bits32f(col[0]));
+            (*dit)[1] = channel_convert<Pixel>(bits32f(col[1]));
+            (*dit)[2] = channel_convert<Pixel>(bits32f(col[2]));
             if(dst.num_channels() > 3)
                 (*dit)[3] = channel_traits<typename channel_type<View>::type>::max_value();
             ++sit;
@@ -0,0 +1,67 @@
+#include "CompiledLut.hpp"
+#include "Color.hpp"
+
+#include <cmath>
+
+namespace tuttle
+{
+
+const std::size_t CompiledLut3D::kNodeSize;
+const std::size_t CompiledLut3D::kShaperSize;
+
+void CompiledLut3D::compile(const AbstractLut& lut, const LutReader::VectorDouble& steps)
+{
+    _dimSize = lut.dimSize();
+    _lattice.clear();
+    _shaper.clear();
+    if(empty())
+        return;
+
+    _offsetZ = kNodeSize;
+    _offsetY = _offsetZ * _dimSize;
+    _offsetX = _offsetY * _dimSize;
+    _latticeScale = _dimSize - 1.0f;
+
+    _lattice.resize(_dimSize * _dimSize * _dimSize * kNodeSize, 0.f);
+    std::vector<float>::iterator node = _lattice.begin();
+    for(std::size_t x = 0; x < _dimSize; ++x)
+    {
+        for(std::size_t y = 0; y < _dimSize; ++y)
+        {
+            for(std::size_t z = 0; z < _dimSize; ++z, node += kNodeSize)
+            {
+                const Color color = lut.getIndexedColor(x, y, z);
+                node[0] = color.x;
+                node[1] = color.y;
+                node[2] = color.z;
+            }
+        }
+    }
+
+    // input shaper: the normalized input range covers the range of the steps
+    if(steps.size() != _dimSize || steps.back() <= steps.front())
+        return;
+    bool uniform = true;
+    for(std::size_t i = 0; i < _dimSize; ++i)
+    {
+        if(i > 0 && steps[i] <= steps[i - 1])
+            return; // not a valid shaper, use the uniform lattice
+        const double expected = steps.back() * i / (_dimSize - 1.0);
+        if(std::abs(steps[i] - expected) > 1e-6 * steps.back())
+            uniform = false;
+    }
+    if(uniform)
+        return;
+
+    _shaper.resize(kShaperSize);
+    std::size_t node0 = 0;
+    for(std::size_t i = 0; i < kShaperSize; ++i)
+    {
+        const double input = steps.front() + (steps.back() - steps.front()) * i / (kShaperSize - 1.0);
+        while(node0 + 2 < _dimSize && input >= steps[node0 + 1])
+            ++node0;
+        const double t = (input - steps[node0]) / (steps[node0 + 1] - steps[node0]);
+        _shaper[i] = static_cast<float>(node0 + std::max(0.0, std::min(t, 1.0)));
+    }
+}
+}
@@ -0,0 +1,178 @@
+#ifndef _LUTENGINE_COMPILEDLUT_HPP_
+#define _LUTENGINE_COMPILEDLUT_HPP_
+
+#include "AbstractLut.hpp"
+#include "LutReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace tuttle
+{
+
+/**
+ * @brief Trilinear interpolation of the 8 corners of a lattice cell.
+ * @param p first channel of the corner (0, 0, 0), the other corners are at @p ox, @p oy, @p oz floats
+ */
+struct TrilinKernel
+{
+    static inline void interpolate(const float* p, const std::ptrdiff_t ox, const std::ptrdiff_t oy,
+                                   const std::ptrdiff_t oz, const float dx, const float dy, const float dz, float* out)
+    {
+        for(int c = 0; c < 4; ++c)
+        {
+            const float c00 = p[c] + dx * (p[ox + c] - p[c]);
+            const float c01 = p[oz + c] + dx * (p[ox + oz + c] - p[oz + c]);
+            const float c10 = p[oy + c] + dx * (p[ox + oy + c] - p[oy + c]);
+            const float c11 = p[oy + oz + c] + dx * (p[ox + oy + oz + c] - p[oy + oz + c]);
+            const float c0 = c00 + dy * (c10 - c00);
+            const float c1 = c01 + dy * (c11 - c01);
+            out[c] = c0 + dz * (c1 - c0);
+        }
+    }
+};
+
+/**
+ * @brief Tetrahedral interpolation, the same tetrahedra as TetraInterpolator.
+ * The tetrahedron is the path from the corner (0, 0, 0) to (1, 1, 1) along the axes sorted by fraction.
+ */
+struct TetraKernel
+{
+    static inline void interpolate(const float* p, const std::ptrdiff_t ox, const std::ptrdiff_t oy,
+                                   const std::ptrdiff_t oz, const float dx, const float dy, const float dz, float* out)
+    {
+        std::ptrdiff_t a, b; // offsets of the 2 intermediate corners
+        float w1, w2, w3;    // fractions sorted in decreasing order
+        if(dx >= dy)
+        {
+            if(dy >= dz) // T1
+            {
+                a = ox;
+                b = ox + oy;
+                w1 = dx;
+                w2 = dy;
+                w3 = dz;
+            }
+            else if(dx >= dz) // T2
+            {
+                a = ox;
+                b = ox + oz;
+                w1 = dx;
+                w2 = dz;
+                w3 = dy;
+            }
+            else // T3
+            {
+                a = oz;
+                b = ox + oz;
+                w1 = dz;
+                w2 = dx;
+                w3 = dy;
+            }
+        }
+        else
+        {
+            if(dz >= dy) // T6
+            {
+                a = oz;
+                b = oy + oz;
+                w1 = dz;
+                w2 = dy;
+                w3 = dx;
+            }
+            else if(dz >= dx) // T5
+            {
+                a = oy;
+                b = oy + oz;
+                w1 = dy;
+                w2 = dz;
+                w3 = dx;
+            }
+            else // T4
+            {
+                a = oy;
+                b = ox + oy;
+                w1 = dy;
+                w2 = dx;
+                w3 = dz;
+            }
+        }
+        const float* pa = p + a;
+        const float* pb = p + b;
+        const float* p111 = p + ox + oy + oz;
+        for(int c = 0; c < 4; ++c)
+            out[c] = p[c] + w1 * (pa[c] - p[c]) + w2 * (pb[c] - pa[c]) + w3 * (p111[c] - pb[c]);
+    }
+};
+
+/**
+ * @brief 3D lut baked into a flat float lattice, with the input shaper of the file.
+ *
+ * The lattice nodes are padded to 4 floats, so the interpolation kernels are inlined
+ * and work on whole nodes, without any virtual call per pixel.
+ */
+class CompiledLut3D
+{
+public:
+    static const std::size_t kNodeSize = 4;
+    static const std::size_t kShaperSize = 4096;
+
+public:
+    CompiledLut3D()
+        : _dimSize(0)
+    {
+    }
+
+    /**
+     * @brief Bake the lattice of @p lut.
+     * @param steps input values of the lattice nodes (the first line of 3dl files),
+     *        uniform steps don't need any shaper.
+     */
+    void compile(const AbstractLut& lut, const LutReader::VectorDouble& steps);
+
+    bool empty() const { return _dimSize < 2; }
+    std::size_t dimSize() const { return _dimSize; }
+
+    /**
+     * @brief Apply the lut on a normalized color.
+     * @param out 4 floats, the last one is the padding
+     */
+    template <class Kernel>
+    inline void apply(const float r, const float g, const float b, float* out) const
+    {
+        const std::ptrdiff_t last = _dimSize - 2;
+        const float cx = toLattice(r);
+        const float cy = toLattice(g);
+        const float cz = toLattice(b);
+        const std::ptrdiff_t x0 = std::min(static_cast<std::ptrdiff_t>(cx), last);
+        const std::ptrdiff_t y0 = std::min(static_cast<std::ptrdiff_t>(cy), last);
+        const std::ptrdiff_t z0 = std::min(static_cast<std::ptrdiff_t>(cz), last);
+        const float* p = &_lattice[x0 * _offsetX + y0 * _offsetY + z0 * _offsetZ];
+        Kernel::interpolate(p, _offsetX, _offsetY, _offsetZ, cx - x0, cy - y0, cz - z0, out);
+    }
+
+private:
+    /// @return the lattice coordinate of a normalized input value, clamped to the lattice
+    inline float toLattice(const float v) const
+    {
+        const float vc = std::max(0.f, std::min(v, 1.f));
+        if(_shaper.empty())
+            return vc * _latticeScale;
+        const float p = vc * (kShaperSize - 1);
+        const std::size_t i = std::min(static_cast<std::size_t>(p), kShaperSize - 2);
+        return _shaper[i] + (p - i) * (_shaper[i + 1] - _shaper[i]);
+    }
+
+private:
+    std::size_t _dimSize;
+    std::ptrdiff_t _offsetX; ///< distance in floats between two nodes along red
+    std::ptrdiff_t _offsetY;
+    std::ptrdiff_t _offsetZ;
+    float _latticeScale;
+    std::vector<float> _lattice;
+    std::vector<float> _shaper; ///< lattice coordinate of kShaperSize regular input values, empty if uniform
+};
+}
+
+#endif
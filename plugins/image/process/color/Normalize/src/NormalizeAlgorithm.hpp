@@ -7,7 +7,9 @@
 #include <terry/numeric/operations.hpp>
 #include <terry/numeric/assign.hpp>
 #include <terry/numeric/minmax.hpp>
-#include <terry/algorithm/transform_pixels_progress.hpp>
+#include <terry/algorithm/reduce_pixels.hpp>
+
+#include <tuttle/plugin/ReduceExecutor.hpp>
 
 namespace tuttle
 {
@@ -17,7 +19,7 @@ namespace normalize
 {
 
 template <class View, typename LocalChannel>
-void analyseChannel(View& src, typename View::value_type& min, typename View::value_type& max, IProgress& p)
+void analyseChannel(View& src, typename View::value_type& min, typename View::value_type& max)
 {
     using namespace terry;
     using namespace terry::numeric;
@@ -26,13 +28,13 @@ void analyseChannel(View& src, typename View::value_type& min, typename View::va
     typedef channel_view_type<LocalChannel, View> LocalView;
     typename LocalView::type localView(LocalView::make(src));
     pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax(localView(0, 0));
-    transform_pixels_progress(localView, minmax, p);
+    minmax = reduce_pixels(localView, minmax, ReduceExecutor());
     static_fill(min, minmax.min[0]);
     static_fill(max, minmax.max[0]);
 }
 
 /**
- * @brief compute min and max from input view analyse.
+ * @brief compute min and max from input view analyse, in a single parallel pass.
  *
  * @param[in] src: input image to analyse
  * @param[in] analyseMode: choose the analyse method
@@ -41,7 +43,7 @@ void analyseChannel(View& src, typename View::value_type& min, typename View::va
  */
 template <class View>
 void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, typename View::value_type& min,
-                        typename View::value_type& max, IProgress& p)
+                        typename View::value_type& max)
 {
     using namespace terry;
     using namespace terry::numeric;
@@ -54,8 +56,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, p);
+            minmax = reduce_pixels(src, minmax, ReduceExecutor());
             min = minmax.min;
             max = minmax.max;
             break;
@@ -66,7 +67,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
             typedef typename color_converted_view_type<View, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<typename LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -76,7 +77,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
             typedef channel_view_type<red_t, View> LocalView;
             typename LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -86,7 +87,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
             typedef channel_view_type<green_t, View> LocalView;
             typename LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -96,7 +97,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
             typedef channel_view_type<blue_t, View> LocalView;
             typename LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -106,7 +107,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
             typedef channel_view_type<alpha_t, View> LocalView;
             typename LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -116,8 +117,7 @@ void analyseInputMinMax(const View& src, const EParamAnalyseMode analyseMode, ty
 
 template <>
 void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalyseMode analyseMode,
-                        boost::gil::rgb32f_view_t::value_type& min, boost::gil::rgb32f_view_t::value_type& max,
-                        IProgress& progress)
+                        boost::gil::rgb32f_view_t::value_type& min, boost::gil::rgb32f_view_t::value_type& max)
 {
     using namespace terry;
     using namespace terry::numeric;
@@ -130,8 +130,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, progress);
+            minmax = reduce_pixels(src, minmax, ReduceExecutor());
             min = minmax.min;
             max = minmax.max;
             break;
@@ -142,7 +141,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
             typedef color_converted_view_type<rgb32f_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -152,7 +151,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
             typedef channel_view_type<red_t, rgb32f_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -162,7 +161,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
             typedef channel_view_type<green_t, rgb32f_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -172,7 +171,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
             typedef channel_view_type<blue_t, rgb32f_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -188,8 +187,7 @@ void analyseInputMinMax(const boost::gil::rgb32f_view_t& src, const EParamAnalys
 
 template <>
 void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyseMode analyseMode,
-                        boost::gil::rgb16_view_t::value_type& min, boost::gil::rgb16_view_t::value_type& max,
-                        IProgress& progress)
+                        boost::gil::rgb16_view_t::value_type& min, boost::gil::rgb16_view_t::value_type& max)
 {
     using namespace terry;
     using namespace terry::numeric;
@@ -202,8 +200,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, progress);
+            minmax = reduce_pixels(src, minmax, ReduceExecutor());
             min = minmax.min;
             max = minmax.max;
             break;
@@ -214,7 +211,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
             typedef color_converted_view_type<rgb16_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -224,7 +221,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
             typedef channel_view_type<red_t, rgb16_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -234,7 +231,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
             typedef channel_view_type<green_t, rgb16_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -244,7 +241,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
             typedef channel_view_type<blue_t, rgb16_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, progress);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -260,7 +257,7 @@ void analyseInputMinMax(const boost::gil::rgb16_view_t& src, const EParamAnalyse
 
 template <>
 void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseMode analyseMode,
-                        boost::gil::rgb8_view_t::value_type& min, boost::gil::rgb8_view_t::value_type& max, IProgress& p)
+                        boost::gil::rgb8_view_t::value_type& min, boost::gil::rgb8_view_t::value_type& max)
 {
     using namespace terry;
     using namespace terry::numeric;
@@ -273,8 +270,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, p);
+            minmax = reduce_pixels(src, minmax, ReduceExecutor());
             min = minmax.min;
             max = minmax.max;
             break;
@@ -285,7 +281,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
             typedef color_converted_view_type<rgb8_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -295,7 +291,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
             typedef channel_view_type<red_t, rgb8_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -305,7 +301,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
             typedef channel_view_type<green_t, rgb8_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -315,7 +311,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
             typedef channel_view_type<blue_t, rgb8_view_t> LocalView;
             LocalView::type localView(LocalView::make(src));
             pixel_minmax_by_channel_t<LocalView::type::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -331,8 +327,7 @@ void analyseInputMinMax(const boost::gil::rgb8_view_t& src, const EParamAnalyseM
 
 template <>
 void analyseInputMinMax(const boost::gil::gray32f_view_t& src, const EParamAnalyseMode analyseMode,
-                        boost::gil::gray32f_view_t::value_type& min, boost::gil::gray32f_view_t::value_type& max,
-                        IProgress& p)
+                        boost::gil::gray32f_view_t::value_type& min, boost::gil::gray32f_view_t::value_type& max)
 {
     using namespace terry;
     using namespace terry::numeric;
@@ -345,8 +340,7 @@ void analyseInputMinMax(const boost::gil::gray32f_view_t& src, const EParamAnaly
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, p);
+            minmax = reduce_pixels(src, minmax, ReduceExecutor());
             min = minmax.min;
             max = minmax.max;
             break;
@@ -357,7 +351,7 @@ void analyseInputMinMax(const boost::gil::gray32f_view_t& src, const EParamAnaly
             typedef color_converted_view_type<gray32f_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -376,7 +370,7 @@ void analyseInputMinMax(const boost::gil::gray32f_view_t& src, const EParamAnaly
 
 template <>
 void analyseInputMinMax(const boost::gil::gray16_view_t& src, const EParamAnalyseMode analyseMode,
-                        boost::gil::gray16_view_t::value_type& min, boost::gil::gray16_view_t::value_type& max, IProgress& p)
+                        boost::gil::gray16_view_t::value_type& min, boost::gil::gray16_view_t::value_type& max)
 {
     using namespace terry;
     using namespace terry::numeric;
@@ -389,8 +383,7 @@ void analyseInputMinMax(const boost::gil::gray16_view_t& src, const EParamAnalys
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, p);
+            minmax = reduce_pixels(src, minmax, ReduceExecutor());
             min = minmax.min;
             max = minmax.max;
             break;
@@ -401,7 +394,7 @@ void analyseInputMinMax(const boost::gil::gray16_view_t& src, const EParamAnalys
             typedef color_converted_view_type<gray16_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
@@ -420,7 +413,7 @@ void analyseInputMinMax(const boost::gil::gray16_view_t& src, const EParamAnalys
 
 template <>
 void analyseInputMinMax(const boost::gil::gray8_view_t& src, const EParamAnalyseMode analyseMode,
-                        boost::gil::gray8_view_t::value_type& min, boost::gil::gray8_view_t::value_type& max, IProgress& p)
+                        boost::gil::gray8_view_t::value_type& min, boost::gil::gray8_view_t::value_type& max)
 {
     using namespace terry;
     using namespace terry::numeric;
@@ -433,8 +426,7 @@ void analyseInputMinMax(const boost::gil::gray8_view_t& src, const EParamAnalyse
         case eParamAnalyseModePerChannel:
         {
             pixel_minmax_by_channel_t<Pixel> minmax(src(0, 0));
-            // compute the maximum value
-            transform_pixels_progress(src, minmax, p);
+            minmax = reduce_pixels(src, minmax, ReduceExecutor());
             min = minmax.min;
             max = minmax.max;
             break;
@@ -445,7 +437,7 @@ void analyseInputMinMax(const boost::gil::gray8_view_t& src, const EParamAnalyse
             typedef color_converted_view_type<gray8_view_t, PixelGray>::type LocalView;
             LocalView localView(src);
             pixel_minmax_by_channel_t<LocalView::value_type> minmax(localView(0, 0));
-            transform_pixels_progress(localView, minmax, p);
+            minmax = reduce_pixels(localView, minmax, ReduceExecutor());
             static_fill(min, minmax.min[0]);
             static_fill(max, minmax.max[0]);
             break;
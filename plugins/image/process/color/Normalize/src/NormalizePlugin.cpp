@@ -3,7 +3,6 @@
 #include "NormalizeDefinitions.hpp"
 #include "NormalizeAlgorithm.hpp"
 
-#include <tuttle/plugin/NoProgress.hpp>
 #include <tuttle/plugin/param/gilColor.hpp>
 
 #include <terry/numeric/operations.hpp>
@@ -101,7 +100,6 @@ void NormalizePlugin::changedParam(const OFX::InstanceChangedArgs& args, const s
         OfxRectI srcPixelRod = _clipSrc->getPixelRod(args.time, args.renderScale);
 
         EParamAnalyseMode mode = static_cast<EParamAnalyseMode>(_analyseMode->getValue());
-        NoProgress progress;
 
         switch(_clipSrc->getPixelComponents())
         {
@@ -116,7 +114,7 @@ void NormalizePlugin::changedParam(const OFX::InstanceChangedArgs& args, const s
                         typedef rgba32f_view_t View;
                         typedef View::value_type Pixel;
                         View srcView = getGilView<View>(src.get(), srcPixelRod, eImageOrientationIndependant);
-                        analyseInputMinMax<View>(srcView, mode, min, max, progress);
+                        analyseInputMinMax<View>(srcView, mode, min, max);
                         break;
                     }
                     case OFX::eBitDepthUShort:
@@ -125,7 +123,7 @@ void NormalizePlugin::changedParam(const OFX::InstanceChangedArgs& args, const s
                         typedef View::value_type Pixel;
                         View srcView = getGilView<View>(src.get(), srcPixelRod, eImageOrientationIndependant);
                         Pixel smin, smax;
-                        analyseInputMinMax<View>(srcView, mode, smin, smax, progress);
+                        analyseInputMinMax<View>(srcView, mode, smin, smax);
                         color_convert(smin, min);
                         color_convert(smax, max);
                         break;
@@ -136,7 +134,7 @@ void NormalizePlugin::changedParam(const OFX::InstanceChangedArgs& args, const s
                         typedef View::value_type Pixel;
                         View srcView = getGilView<View>(src.get(), srcPixelRod, eImageOrientationIndependant);
                         Pixel smin, smax;
-                        analyseInputMinMax<View>(srcView, mode, smin, smax, progress);
+                        analyseInputMinMax<View>(srcView, mode, smin, smax);
                         color_convert(smin, min);
                         color_convert(smax, max);
                         break;
@@ -171,7 +169,7 @@ void NormalizePlugin::changedParam(const OFX::InstanceChangedArgs& args, const s
                         typedef rgb32f_view_t View;
                         typedef View::value_type Pixel;
                         View srcView = getGilView<View>(src.get(), srcPixelRod, eImageOrientationIndependant);
-                        analyseInputMinMax<View>(srcView, mode, min, max, progress);
+                        analyseInputMinMax<View>(srcView, mode, min, max);
                         break;
                     }
                     case OFX::eBitDepthUShort:
@@ -180,7 +178,7 @@ void NormalizePlugin::changedParam(const OFX::InstanceChangedArgs& args, const s
                         typedef View::value_type Pixel;
                         View srcView = getGilView<View>(src.get(), srcPixelRod, eImageOrientationIndependant);
                         Pixel smin, smax;
-                        analyseInputMinMax<View>(srcView, mode, smin, smax, progress);
+                        analyseInputMinMax<View>(srcView, mode, smin, smax);
                         color_convert(smin, min);
                         color_convert(smax, max);
                         break;
@@ -191,7 +189,7 @@ void NormalizePlugin::changedParam(const OFX::InstanceChangedArgs& args, const s
                         typedef View::value_type Pixel;
                         View srcView = getGilView<View>(src.get(), srcPixelRod, eImageOrientationIndependant);
                         Pixel smin, smax;
-                        analyseInputMinMax<View>(srcView, mode, smin, smax, progress);
+                        analyseInputMinMax<View>(srcView, mode, smin, smax);
                         color_convert(smin, min);
                         color_convert(smax, max);
                         break;
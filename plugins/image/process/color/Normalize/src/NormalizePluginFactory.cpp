@@ -35,6 +35,7 @@ void NormalizePluginFactory::describe(OFX::ImageEffectDescriptor& desc)
 
     // plugin flags
     desc.setSupportsTiles(kSupportTiles);
+    desc.setPointWise(true); // the analysis of the source is done before the render of the pixels
     desc.setRenderThreadSafety(OFX::eRenderFullySafe);
 }
 
@@ -11,6 +11,16 @@ namespace blur
 {
 
 static const std::string kParamSize = "size";
+static const std::string kParamAlgorithm = "algorithm";
+static const std::string kParamAlgorithmGaussian = "Gaussian";
+static const std::string kParamAlgorithmBox = "Box";
+
+enum EParamAlgorithm
+{
+    eParamAlgorithmGaussian = 0,
+    eParamAlgorithmBox
+};
+
 static const std::string kParamBorder = "border";
 static const std::string kParamBorderNo = "No";
 static const std::string kParamBorderMirror = "Mirror";
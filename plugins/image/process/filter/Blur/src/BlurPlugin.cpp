@@ -3,6 +3,8 @@
 #include "BlurDefinitions.hpp"
 
 #include <terry/point/operations.hpp>
+#include <terry/filter/gaussianKernel.hpp>
+#include <terry/filter/boxBlur.hpp>
 
 #include <boost/gil/gil_all.hpp>
 
@@ -17,6 +19,7 @@ BlurPlugin::BlurPlugin(OfxImageEffectHandle handle)
     : ImageEffectGilPlugin(handle)
 {
     _paramSize = fetchDouble2DParam(kParamSize);
+    _paramAlgorithm = fetchChoiceParam(kParamAlgorithm);
     _paramBorder = fetchChoiceParam(kParamBorder);
     _paramNormalizedKernel = fetchBooleanParam(kParamNormalizedKernel);
     _paramKernelEpsilon = fetchDoubleParam(kParamKernelEpsilon);
@@ -28,13 +31,32 @@ BlurProcessParams<BlurPlugin::Scalar> BlurPlugin::getProcessParams(const OfxPoin
 
     BlurProcessParams<Scalar> params;
     params._size = ofxToGil(_paramSize->getValue()) * ofxToGil(renderScale);
+    params._algorithm = static_cast<EParamAlgorithm>(_paramAlgorithm->getValue());
     params._border = static_cast<EParamBorder>(_paramBorder->getValue());
 
-    const bool normalizedKernel = _paramNormalizedKernel->getValue();
-    const double kernelEpsilon = _paramKernelEpsilon->getValue();
-
-    params._gilKernelX = buildGaussian1DKernel<Scalar>(params._size.x, normalizedKernel, kernelEpsilon);
-    params._gilKernelY = buildGaussian1DKernel<Scalar>(params._size.y, normalizedKernel, kernelEpsilon);
+    switch(params._algorithm)
+    {
+        case eParamAlgorithmGaussian:
+        {
+            const bool normalizedKernel = _paramNormalizedKernel->getValue();
+            const double kernelEpsilon = _paramKernelEpsilon->getValue();
+
+            params._gilKernelX = buildGaussian1DKernel<Scalar>(params._size.x, normalizedKernel, kernelEpsilon);
+            params._gilKernelY = buildGaussian1DKernel<Scalar>(params._size.y, normalizedKernel, kernelEpsilon);
+            params._margin.x = params._gilKernelX.left_size();
+            params._margin.y = params._gilKernelY.left_size();
+            break;
+        }
+        case eParamAlgorithmBox:
+        {
+            // the size is the variance of the gaussian kernel
+            params._boxRadiusX = boxRadiusForGaussian(params._size.x);
+            params._boxRadiusY = boxRadiusForGaussian(params._size.y);
+            params._margin.x = std::accumulate(params._boxRadiusX.begin(), params._boxRadiusX.end(), std::size_t(0));
+            params._margin.y = std::accumulate(params._boxRadiusY.begin(), params._boxRadiusY.end(), std::size_t(0));
+            break;
+        }
+    }
 
     params._boundary_option = convolve_option_extend_mirror;
     switch(params._border)
@@ -79,18 +101,18 @@ bool BlurPlugin::getRegionOfDefinition(const OFX::RegionOfDefinitionArguments& a
     switch(params._border)
     {
         case eParamBorderPadded:
-            rod.x1 = srcRod.x1 + params._gilKernelX.left_size();
-            rod.y1 = srcRod.y1 + params._gilKernelY.left_size();
-            rod.x2 = srcRod.x2 - params._gilKernelX.right_size();
-            rod.y2 = srcRod.y2 - params._gilKernelY.right_size();
+            rod.x1 = srcRod.x1 + params._margin.x;
+            rod.y1 = srcRod.y1 + params._margin.y;
+            rod.x2 = srcRod.x2 - params._margin.x;
+            rod.y2 = srcRod.y2 - params._margin.y;
             return true;
         case eParamBorderBlack:
         case eParamBorderConstant:
         case eParamBorderMirror:
-            rod.x1 = srcRod.x1 - params._gilKernelX.left_size();
-            rod.y1 = srcRod.y1 - params._gilKernelY.left_size();
-            rod.x2 = srcRod.x2 + params._gilKernelX.right_size();
-            rod.y2 = srcRod.y2 + params._gilKernelY.right_size();
+            rod.x1 = srcRod.x1 - params._margin.x;
+            rod.y1 = srcRod.y1 - params._margin.y;
+            rod.x2 = srcRod.x2 + params._margin.x;
+            rod.y2 = srcRod.y2 + params._margin.y;
             return true;
         case eParamBorderNo:
             return false; // don't modify the source image RoD
@@ -105,10 +127,10 @@ void BlurPlugin::getRegionsOfInterest(const OFX::RegionsOfInterestArguments& arg
     OfxRectD srcRod = _clipSrc->getCanonicalRod(args.time);
 
     OfxRectD srcRoi;
-    srcRoi.x1 = srcRod.x1 - params._gilKernelX.left_size();
-    srcRoi.y1 = srcRod.y1 - params._gilKernelY.left_size();
-    srcRoi.x2 = srcRod.x2 + params._gilKernelX.right_size();
-    srcRoi.y2 = srcRod.y2 + params._gilKernelY.right_size();
+    srcRoi.x1 = srcRod.x1 - params._margin.x;
+    srcRoi.y1 = srcRod.y1 - params._margin.y;
+    srcRoi.x2 = srcRod.x2 + params._margin.x;
+    srcRoi.y2 = srcRod.y2 + params._margin.y;
     rois.setRegionOfInterest(*_clipSrc, srcRoi);
 }
 
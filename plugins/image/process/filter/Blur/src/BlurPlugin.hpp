@@ -6,6 +6,8 @@
 
 #include <terry/filter/convolve.hpp>
 
+#include <vector>
+
 #include <boost/gil/gil_all.hpp>
 
 namespace tuttle
@@ -20,11 +22,18 @@ struct BlurProcessParams
 {
     typedef typename terry::filter::kernel_1d<Scalar> Kernel;
     terry::point2<double> _size;
+    EParamAlgorithm _algorithm;
     EParamBorder _border;
     terry::filter::convolve_boundary_option _boundary_option;
 
-    Kernel _gilKernelX;
+    Kernel _gilKernelX; ///< gaussian algorithm
     Kernel _gilKernelY;
+
+    std::vector<std::size_t> _boxRadiusX; ///< box algorithm
+    std::vector<std::size_t> _boxRadiusY;
+
+    /// number of pixels needed around each output pixel
+    terry::point2<std::ptrdiff_t> _margin;
 };
 
 /**
@@ -50,6 +59,7 @@ public:
 
 public:
     OFX::Double2DParam* _paramSize;
+    OFX::ChoiceParam* _paramAlgorithm;
     OFX::ChoiceParam* _paramBorder;
     OFX::BooleanParam* _paramNormalizedKernel;
     OFX::DoubleParam* _paramKernelEpsilon;
@@ -87,6 +87,16 @@ void BlurPluginFactory::describeInContext(OFX::ImageEffectDescriptor& desc, OFX:
     size->setDisplayRange(0, 0, 10, 10);
     size->setDoubleType(OFX::eDoubleTypeScale);
 
+    OFX::ChoiceParamDescriptor* algorithm = desc.defineChoiceParam(kParamAlgorithm);
+    algorithm->setLabel("Algorithm");
+    algorithm->appendOption(kParamAlgorithmGaussian, "Gaussian kernel: exact, the cost grows with the size");
+    algorithm->appendOption(kParamAlgorithmBox, "Box filters: approximation, the cost doesn't depend on the size");
+    algorithm->setHint("Gaussian: convolution with a gaussian kernel, the cost per pixel grows with the size.\n"
+                       "Box: 3 successive box filters of the same variance, the cost per pixel is constant. "
+                       "The result is within a few percents of the gaussian, but the kernel is a piecewise "
+                       "quadratic curve with a finite support. The advanced kernel parameters are not used.");
+    algorithm->setDefault(eParamAlgorithmGaussian);
+
     OFX::ChoiceParamDescriptor* border = desc.defineChoiceParam(kParamBorder);
     border->setLabel("Border");
     border->appendOption(kParamBorderNo);
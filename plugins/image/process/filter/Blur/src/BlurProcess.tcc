@@ -2,6 +2,7 @@
 
 #include <terry/filter/gaussianKernel.hpp>
 #include <terry/filter/convolve.hpp>
+#include <terry/filter/boxBlur.hpp>
 
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
 
@@ -52,18 +53,45 @@ void BlurProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
 
     const Point proc_tl(procWindowRoW.x1 - this->_srcPixelRod.x1, procWindowRoW.y1 - this->_srcPixelRod.y1);
 
-    if(_params._size.x == 0)
+    switch(_params._algorithm)
     {
-        correlate_cols_auto<Pixel>(this->_srcView, _params._gilKernelY, dst, proc_tl, _params._boundary_option);
-    }
-    else if(_params._size.y == 0)
-    {
-        correlate_rows_auto<Pixel>(this->_srcView, _params._gilKernelX, dst, proc_tl, _params._boundary_option);
-    }
-    else
-    {
-        correlate_rows_cols_auto<Pixel, OfxAllocator>(this->_srcView, _params._gilKernelX, _params._gilKernelY, dst, proc_tl,
-                                                      _params._boundary_option);
+        case eParamAlgorithmGaussian:
+        {
+            if(_params._size.x == 0)
+            {
+                correlate_cols_auto<PixelAccum>(this->_srcView, _params._gilKernelY, dst, proc_tl,
+                                                _params._boundary_option);
+            }
+            else if(_params._size.y == 0)
+            {
+                correlate_rows_auto<PixelAccum>(this->_srcView, _params._gilKernelX, dst, proc_tl,
+                                                _params._boundary_option);
+            }
+            else
+            {
+                correlate_rows_cols_auto<PixelAccum, OfxAllocator>(this->_srcView, _params._gilKernelX,
+                                                                   _params._gilKernelY, dst, proc_tl,
+                                                                   _params._boundary_option);
+            }
+            break;
+        }
+        case eParamAlgorithmBox:
+        {
+            if(_params._size.x == 0)
+            {
+                box_blur_cols<PixelAccum>(this->_srcView, _params._boxRadiusY, dst, proc_tl, _params._boundary_option);
+            }
+            else if(_params._size.y == 0)
+            {
+                box_blur_rows<PixelAccum>(this->_srcView, _params._boxRadiusX, dst, proc_tl, _params._boundary_option);
+            }
+            else
+            {
+                box_blur_rows_cols<PixelAccum, OfxAllocator>(this->_srcView, _params._boxRadiusX, _params._boxRadiusY,
+                                                             dst, proc_tl, _params._boundary_option);
+            }
+            break;
+        }
     }
 }
 }
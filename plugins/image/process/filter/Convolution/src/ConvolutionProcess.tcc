@@ -49,12 +49,12 @@ void ConvolutionProcess<View>::multiThreadProcessImages(const OfxRectI& procWind
             {
             */
     if(_params._size.x == 0)
-        correlate_cols_auto<Pixel>(this->_srcView, _params._convY, dst, proc_tl, _params._boundary_option);
+        correlate_cols_auto<PixelAccum>(this->_srcView, _params._convY, dst, proc_tl, _params._boundary_option);
     else if(_params._size.y == 0)
-        correlate_rows_auto<Pixel>(this->_srcView, _params._convX, dst, proc_tl, _params._boundary_option);
+        correlate_rows_auto<PixelAccum>(this->_srcView, _params._convX, dst, proc_tl, _params._boundary_option);
     else
-        correlate_rows_cols_auto<Pixel, OfxAllocator>(this->_srcView, _params._convX, _params._convY, dst, proc_tl,
-                                                      _params._boundary_option);
+        correlate_rows_cols_auto<PixelAccum, OfxAllocator>(this->_srcView, _params._convX, _params._convY, dst, proc_tl,
+                                                           _params._boundary_option);
     /*
             break;
     }
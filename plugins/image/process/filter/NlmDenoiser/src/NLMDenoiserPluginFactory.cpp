@@ -148,6 +148,8 @@ void NLMDenoiserPluginFactory::describeInContext(OFX::ImageEffectDescriptor& des
     optimized->setLabels(kParamOptimizationLabel, kParamOptimizationLabel, kParamOptimizationLabel);
     optimized->setParent(*groupParams);
     optimized->setDefault(true);
+    optimized->setHint("Compute the patch distances with integral images, in parallel over the displacements. "
+                       "Otherwise, use the sliding window of the previous versions, on tiles of rows.");
     optimized->setIsSecret(true);
 
     OFX::DoubleParamDescriptor* preBlurring = desc.defineDoubleParam(kParamPreBlurring);
@@ -64,8 +64,21 @@ protected:
 
     NLMDenoiserPlugin& _plugin; ///< Rendering plugin
 
-    int _margin;              ///< Margin
+    double _sigma;            ///< Noise standard deviation of the current frame
     OfxRectI _upScaledBounds; ///< Upscaled source bounds (margin upscaling)
+    NlmParams _params;        ///< Parameters of the current frame
+
+    /// @name Optimized rendering: integral images, in parallel over the displacements
+    /// @{
+    bool _optimized;                 ///< Use the integral images (otherwise the sliding window, by tiles)
+    OfxPointI _displacementRadius;   ///< Displacements of the neighborhood, limited by the frame size
+    int _bandHeight;                 ///< Height of the bands of rows rendered one after the other
+    OfxRectI _bandProcWindow;        ///< Window of the current band, in its source views
+    std::vector<View> _bandSrcViews; ///< Source views of the current band (with its margin)
+    /// Weights and normalizations accumulated by each thread on the current band
+    boost::ptr_vector<boost::gil::rgba32f_image_t> _threadWeightCumuls;
+    boost::ptr_vector<boost::gil::rgba32f_image_t> _threadWeightNorms;
+    /// @}
 
 protected:
     void addFrame(const OfxRectI& dBounds, const int dstBitDepth, const int dstComponents, const double time, const int z);
@@ -76,13 +89,34 @@ public:
 
     void setup(const OFX::RenderArguments& args);
     void preProcess();
+    void process();
+    void multiThreadFunction(const unsigned int threadId, const unsigned int nThreads);
     void multiThreadProcessImages(const OfxRectI& procWindowRoW);
 
     double computeBandwidth();
     void nlMeans(View& dst, const OfxRectI& procWindow, const NlmParams& params);
 
+    /// @brief Number of displacements computed for each band by the optimized rendering
+    int nbDisplacements() const;
+
+    /// @brief Source views of @p procWindow with the margin of the patches and of the neighborhood.
+    /// @return the window @p procWindow in the returned views
+    OfxRectI sourceViews(const OfxRectI& procWindow, const NlmParams& params, std::vector<View>& subSrcViews) const;
+
+    /// @brief Final estimate of the pixels from the accumulated weights.
+    void estimate(View& dst, const View& src, const boost::gil::rgba32f_view_t& view_wc,
+                  const boost::gil::rgba32f_view_t& view_norm, const NlmParams& params) const;
+
+    /// @brief Patch distances of a sliding window along the rows (reference implementation).
+    void computeWeightsSlidingWindow(const std::vector<View>& srcViews, const OfxRectI& procWindow,
+                                     boost::gil::rgba32f_view_t& view_wc, boost::gil::rgba32f_view_t& view_norm,
+                                     const NlmParams& params);
+
+    /// @brief Patch distances of integral images, for the displacements
+    /// @p firstDisplacement, @p firstDisplacement + @p displacementStep, ...
     void computeWeights(const std::vector<View>& srcViews, const OfxRectI& procWindow, boost::gil::rgba32f_view_t& view_wc,
-                        boost::gil::rgba32f_view_t& view_norm, const NlmParams& params);
+                        boost::gil::rgba32f_view_t& view_norm, const NlmParams& params, const int firstDisplacement,
+                        const int displacementStep);
 };
 }
 }
@@ -10,6 +10,8 @@
 #include <terry/globals.hpp>
 #include <terry/basic_colors.hpp>
 #include <terry/channel.hpp>
+#include <terry/typedefs.hpp>
+#include <terry/algorithm/integral_image.hpp>
 
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
@@ -35,7 +37,12 @@ template <class View>
 NLMDenoiserProcess<View>::NLMDenoiserProcess(NLMDenoiserPlugin& instance)
     : ImageGilProcessor<View>(instance, eImageOrientationIndependant)
     , _plugin(instance)
+    , _sigma(0.0)
+    , _optimized(true)
+    , _bandHeight(0)
 {
+    _displacementRadius.x = _displacementRadius.y = 0;
+
     _paramRedStrength = instance.fetchDoubleParam(kParamRedStrength);
     _paramGreenStrength = instance.fetchDoubleParam(kParamGreenStrength);
     _paramBlueStrength = instance.fetchDoubleParam(kParamBlueStrength);
@@ -130,19 +137,55 @@ void NLMDenoiserProcess<View>::setup(const OFX::RenderArguments& args)
         TUTTLE_LOG_VAR2(TUTTLE_INFO, args.time, t);
         addFrame(dBounds, dstBitDepth, dstComponents, t, i++);
     }
+
+    // Noise variance estimation, on the whole frame so the weights don't depend on the tiles
+    const double nv = imageUtils::noise_variance(_srcViews[0]);
+    _sigma = std::sqrt(nv < 0 ? 0 : nv);
+
+    // Change reference point
+    _params.mix[0] = (float)_paramRedStrength->getValue();
+    _params.mix[1] = (float)_paramGreenStrength->getValue();
+    _params.mix[2] = (float)_paramBlueStrength->getValue();
+    _params.mix[2] = 1.0;
+
+    _params.bws[0] = (float)_paramRedGrainSize->getValue();
+    _params.bws[1] = (float)_paramGreenGrainSize->getValue();
+    _params.bws[2] = (float)_paramBlueGrainSize->getValue();
+    _params.bws[3] = 1.0;
+
+    _params.patchRadius = _paramPatchRadius->getValue();
+    _params.regionRadius = _paramRegionRadius->getValue();
+    _params.preBlurring = (float)_paramPreBlurring->getValue();
+
+    // Each tile (or band) also computes the weights of a margin of rows on both sides of its window,
+    // the tiles are much taller than the margin to keep this redundant work small.
+    const int margin = _params.regionRadius + _params.patchRadius + 1;
+    _optimized = _paramOptimized->getValue();
+    if(_optimized)
+    {
+        // Optimisation based on: AN IMPROVED NON-LOCAL DENOISING ALGORITHM, LNLA 2008
+        // The neighborhood is limited by the size of the frame, not by the size of the bands
+        _displacementRadius.x = std::min(_params.regionRadius, (int)_srcViews[0].width() / 2);
+        _displacementRadius.y = std::min(_params.regionRadius, (int)_srcViews[0].height() / 2);
+        _bandHeight = std::max(8 * margin, 128);
+    }
+    else
+    {
+        this->setTileSize(0, 8 * margin);
+    }
 }
 
 template <class View>
 void NLMDenoiserProcess<View>::preProcess()
 {
     // Initialize progress bar
-    if(_paramOptimized->getValue())
+    if(_optimized)
     {
-        const int min_xpi = std::min((int)_paramRegionRadius->getValue() * 2, (int)_srcViews[0].width()),
-                  min_ypi = std::min((int)_paramRegionRadius->getValue() * 2, (int)_srcViews[0].height());
+        // One step for each displacement of each band
+        const int nbBands = (this->_renderWindowSize.y + _bandHeight - 1) / _bandHeight;
         std::stringstream msg;
         msg << "NL-Means algorithm in progress (automatic bandwidth = " << computeBandwidth() << ").";
-        this->progressBegin(_paramDepth->getValue() * min_xpi * min_ypi, msg.str());
+        this->progressBegin(nbBands * std::max(nbDisplacements(), 1), msg.str());
     }
     else
     {
@@ -154,33 +197,129 @@ void NLMDenoiserProcess<View>::preProcess()
 }
 
 /**
- * @brief Function called by rendering thread each time a process must be done.
- * @param[in] procWindowRoW  Processing window in RoW
+ * @brief Optimized rendering, by bands of rows.
+ *
+ * The displacements of each band are shared between the threads. Each thread accumulates
+ * the weights of its displacements in its own buffers, then the buffers are summed in the
+ * order of the threads, so the result doesn't depend on the scheduling of the threads.
  */
 template <class View>
-void NLMDenoiserProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
+void NLMDenoiserProcess<View>::process()
 {
-    NlmParams params;
-    // Change reference point
-    params.mix[0] = (float)_paramRedStrength->getValue();
-    params.mix[1] = (float)_paramGreenStrength->getValue();
-    params.mix[2] = (float)_paramBlueStrength->getValue();
-    params.mix[2] = 1.0;
+    using namespace boost::gil;
+    using namespace terry;
 
-    params.bws[0] = (float)_paramRedGrainSize->getValue();
-    params.bws[1] = (float)_paramGreenGrainSize->getValue();
-    params.bws[2] = (float)_paramBlueGrainSize->getValue();
-    params.bws[3] = 1.0;
+    typedef typename rgba32f_view_t::x_iterator WeightIt;
+
+    if(!_optimized)
+    {
+        ImageGilProcessor<View>::process();
+        return;
+    }
 
-    params.patchRadius = _paramPatchRadius->getValue();
-    params.regionRadius = _paramRegionRadius->getValue();
-    params.preBlurring = (float)_paramPreBlurring->getValue();
+    const OfxRectI& renderWindow = this->_renderArgs.renderWindow;
+    const int w = renderWindow.x2 - renderWindow.x1;
+    if(w == 0 || renderWindow.y2 - renderWindow.y1 == 0)
+    {
+        BOOST_THROW_EXCEPTION(exception::ImageFormat() << exception::user("RenderWindow empty !"));
+    }
+    preProcess();
 
+    const int nbThreads = std::max(1, std::min((int)OFX::MultiThread::getNumCPUs(), nbDisplacements()));
+    _threadWeightCumuls.clear();
+    _threadWeightNorms.clear();
+    for(int t = 0; t < nbThreads; ++t)
+    {
+        /// @todo: use memory allocated by host using memorySuite
+        _threadWeightCumuls.push_back(new rgba32f_image_t(w, _bandHeight));
+        _threadWeightNorms.push_back(new rgba32f_image_t(w, _bandHeight));
+    }
+
+    for(int y = renderWindow.y1; y < renderWindow.y2 && !_plugin.abort(); y += _bandHeight)
+    {
+        OfxRectI band = renderWindow;
+        band.y1 = y;
+        band.y2 = std::min(y + _bandHeight, renderWindow.y2);
+        const int h = band.y2 - band.y1;
+
+        _bandProcWindow = sourceViews(band, _params, _bandSrcViews);
+        this->multiThread(nbThreads);
+        if(_plugin.abort())
+            break;
+
+        // Sum the weights of all the threads in the buffers of the first one
+        rgba32f_view_t view_wc = subimage_view(view(_threadWeightCumuls[0]), 0, 0, w, h);
+        rgba32f_view_t view_norm = subimage_view(view(_threadWeightNorms[0]), 0, 0, w, h);
+        for(int t = 1; t < nbThreads; ++t)
+        {
+            rgba32f_view_t thread_wc = subimage_view(view(_threadWeightCumuls[t]), 0, 0, w, h);
+            rgba32f_view_t thread_norm = subimage_view(view(_threadWeightNorms[t]), 0, 0, w, h);
+            for(int yj = 0; yj < h; ++yj)
+            {
+                WeightIt wcIter = view_wc.row_begin(yj);
+                WeightIt wnIter = view_norm.row_begin(yj);
+                WeightIt twcIter = thread_wc.row_begin(yj);
+                WeightIt twnIter = thread_norm.row_begin(yj);
+                for(int xj = 0; xj < w; ++xj)
+                {
+                    for(int v = 0; v < 4; ++v)
+                    {
+                        wcIter[xj][v] += twcIter[xj][v];
+                        wnIter[xj][v] += twnIter[xj][v];
+                    }
+                }
+            }
+        }
+
+        View bandDst = subimage_view(this->_dstView, 0, band.y1 - renderWindow.y1, w, h);
+        View bandSrc = subimage_view(_bandSrcViews[0], _bandProcWindow.x1, _bandProcWindow.y1, w, h);
+        estimate(bandDst, bandSrc, view_wc, view_norm, _params);
+    }
+    _bandSrcViews.clear();
+    _threadWeightCumuls.clear();
+    _threadWeightNorms.clear();
+
+    postProcess();
+}
+
+/**
+ * @brief Function called once on each thread: the tiles of the sliding window rendering,
+ * or the displacements of the current band of the optimized rendering.
+ */
+template <class View>
+void NLMDenoiserProcess<View>::multiThreadFunction(const unsigned int threadId, const unsigned int nThreads)
+{
+    using namespace boost::gil;
+    using namespace terry;
+
+    if(!_optimized)
+    {
+        ImageGilProcessor<View>::multiThreadFunction(threadId, nThreads);
+        return;
+    }
+
+    const int w = _bandProcWindow.x2 - _bandProcWindow.x1;
+    const int h = _bandProcWindow.y2 - _bandProcWindow.y1;
+    rgba32f_view_t view_wc = subimage_view(view(_threadWeightCumuls[threadId]), 0, 0, w, h);
+    rgba32f_view_t view_norm = subimage_view(view(_threadWeightNorms[threadId]), 0, 0, w, h);
+    fill_black(view_wc);
+    fill_black(view_norm);
+
+    computeWeights(_bandSrcViews, _bandProcWindow, view_wc, view_norm, _params, threadId, nThreads);
+}
+
+/**
+ * @brief Function called by rendering thread each time a process must be done.
+ * @param[in] procWindowRoW  Processing window in RoW
+ */
+template <class View>
+void NLMDenoiserProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
+{
     // Destination subview cropped by the procwindow
     View subDst = bgil::subimage_view(this->_dstView, procWindowRoW.x1 - this->_renderArgs.renderWindow.x1,
                                       procWindowRoW.y1 - this->_renderArgs.renderWindow.y1,
                                       procWindowRoW.x2 - procWindowRoW.x1, procWindowRoW.y2 - procWindowRoW.y1);
-    nlMeans(subDst, procWindowRoW, params);
+    nlMeans(subDst, procWindowRoW, _params);
 }
 
 template <class View>
@@ -203,37 +342,22 @@ double NLMDenoiserProcess<View>::computeBandwidth()
     return bandwidth / _paramDepth->getValue();
 }
 
-/**
- * @brief Function called to apply nl-means denoising
- *
- * @param[out] dst  Destination image view
- * @param[in] procWindow
- * @param[in] params
- *
- */
 template <class View>
-void NLMDenoiserProcess<View>::nlMeans(View& dst, const OfxRectI& procWindow, const NlmParams& params)
+int NLMDenoiserProcess<View>::nbDisplacements() const
 {
-    using namespace boost::gil;
-    using namespace terry;
-
-    typedef typename rgba32f_view_t::x_iterator WeightIt;
-    typedef typename View::x_iterator x_iterator;
-    typedef typename View::locator Locator;
-
-    const int w = dst.width();
-    const int h = dst.height();
-
-    static const int nc = num_channels<Pixel>::value;
-    boost::array<float, nc> mix;
+    const int nbNeighbors = (2 * _displacementRadius.x + 1) * (2 * _displacementRadius.y + 1) - 1;
+    const int depth = _srcViews.size();
+    // Only half of the displacements of the current frame
+    return nbNeighbors / 2 + (depth - 1) * nbNeighbors;
+}
 
-    for(std::size_t i = 0; i < mix.size(); ++i)
-    {
-        mix[i] = params.mix[i] * channel_traits<Channel>::max_value();
-    }
+template <class View>
+OfxRectI NLMDenoiserProcess<View>::sourceViews(const OfxRectI& procWindow, const NlmParams& params,
+                                               std::vector<View>& subSrcViews) const
+{
+    using namespace boost::gil;
 
-    std::vector<View> subSrcViews;
-    typename std::vector<View>::iterator it;
+    typename std::vector<View>::const_iterator it;
     const int margin = params.regionRadius + params.patchRadius;
 
     // Upscale process window
@@ -251,6 +375,7 @@ void NLMDenoiserProcess<View>::nlMeans(View& dst, const OfxRectI& procWindow, co
     tUpscaledProcWindow.y2 = upscaledProcWindow.y2 - _upScaledBounds.y1;
 
     // Create up-scaled-proc-windowed subviews sequence
+    subSrcViews.clear();
     for(it = _srcViews.begin(); it != _srcViews.end(); ++it)
     {
         subSrcViews.push_back(subimage_view(*it, tUpscaledProcWindow.x1, tUpscaledProcWindow.y1,
@@ -258,6 +383,78 @@ void NLMDenoiserProcess<View>::nlMeans(View& dst, const OfxRectI& procWindow, co
                                             tUpscaledProcWindow.y2 - tUpscaledProcWindow.y1));
     }
 
+    // Bugs bunny is here
+    OfxRectI nProcWindow;
+    nProcWindow.x1 = (procWindow.x1 - upscaledProcWindow.x1);
+    nProcWindow.y1 = (procWindow.y1 - upscaledProcWindow.y1);
+    nProcWindow.x2 = nProcWindow.x1 + (procWindow.x2 - procWindow.x1);
+    nProcWindow.y2 = nProcWindow.y1 + (procWindow.y2 - procWindow.y1);
+    return nProcWindow;
+}
+
+template <class View>
+void NLMDenoiserProcess<View>::estimate(View& dst, const View& src, const boost::gil::rgba32f_view_t& view_wc,
+                                        const boost::gil::rgba32f_view_t& view_norm, const NlmParams& params) const
+{
+    using namespace boost::gil;
+    using namespace terry;
+
+    typedef typename rgba32f_view_t::x_iterator WeightIt;
+    typedef typename View::x_iterator x_iterator;
+
+    static const int nc = num_channels<Pixel>::value;
+    boost::array<float, nc> mix;
+
+    for(std::size_t i = 0; i < mix.size(); ++i)
+    {
+        mix[i] = params.mix[i] * channel_traits<Channel>::max_value();
+    }
+
+    for(int yj = 0; yj < dst.height(); ++yj)
+    {
+        WeightIt wcIter = view_wc.row_begin(yj);
+        WeightIt wnIter = view_norm.row_begin(yj);
+        x_iterator src_it = src.row_begin(yj);
+        x_iterator dst_it = dst.row_begin(yj);
+        for(int xj = 0; xj < dst.width(); ++xj)
+        {
+            // Final estimate
+            for(int v = 0; v < nc; ++v)
+            {
+                (*dst_it)[v] = (((*wcIter)[v] * mix[v] + 1.0f * (*src_it)[v]) / ((*wnIter)[v] * mix[v] + 1.0f));
+            }
+
+            // Fill alpha
+            assign_channel_if_exists_t<Pixel, alpha_t>()(*src_it, *dst_it);
+
+            ++src_it;
+            ++dst_it;
+            ++wcIter;
+            ++wnIter;
+        }
+    }
+}
+
+/**
+ * @brief Function called to apply nl-means denoising on a tile (sliding window rendering)
+ *
+ * @param[out] dst  Destination image view
+ * @param[in] procWindow
+ * @param[in] params
+ *
+ */
+template <class View>
+void NLMDenoiserProcess<View>::nlMeans(View& dst, const OfxRectI& procWindow, const NlmParams& params)
+{
+    using namespace boost::gil;
+    using namespace terry;
+
+    const int w = dst.width();
+    const int h = dst.height();
+
+    std::vector<View> subSrcViews;
+    const OfxRectI nProcWindow = sourceViews(procWindow, params, subSrcViews);
+
     // Allocate average buffers (assimilate this two buffers as 2D float buffers, not images !)
     rgba32f_image_t weight_cumul(w, h); /// @todo: use memory allocated by host using memorySuite
     rgba32f_image_t weight_norm(w, h);
@@ -268,49 +465,21 @@ void NLMDenoiserProcess<View>::nlMeans(View& dst, const OfxRectI& procWindow, co
     fill_black(view_wc);
     fill_black(view_norm);
 
-    // Bugs bunny is here
-    OfxRectI nProcWindow;
-    nProcWindow.x1 = (procWindow.x1 - upscaledProcWindow.x1);
-    nProcWindow.y1 = (procWindow.y1 - upscaledProcWindow.y1);
-    nProcWindow.x2 = nProcWindow.x1 + w;
-    nProcWindow.y2 = nProcWindow.y1 + h;
-
-    computeWeights(subSrcViews, nProcWindow, view_wc, view_norm, params);
+    computeWeightsSlidingWindow(subSrcViews, nProcWindow, view_wc, view_norm, params);
 
     if(!_plugin.abort())
     {
         View procView = subimage_view(subSrcViews[0], nProcWindow.x1, nProcWindow.y1, w, h);
-        for(int yj = 0; yj < h; ++yj)
-        {
-            WeightIt wcIter = view_wc.row_begin(yj);
-            WeightIt wnIter = view_norm.row_begin(yj);
-            x_iterator src_it = procView.row_begin(yj);
-            x_iterator dst_it = dst.row_begin(yj);
-            for(int xj = 0; xj < w; ++xj)
-            {
-                // Final estimate
-                for(int v = 0; v < nc; ++v)
-                {
-                    (*dst_it)[v] = (((*wcIter)[v] * mix[v] + 1.0f * (*src_it)[v]) / ((*wnIter)[v] * mix[v] + 1.0f));
-                }
-
-                // Fill alpha
-                assign_channel_if_exists_t<Pixel, alpha_t>()(*src_it, *dst_it);
-
-                ++src_it;
-                ++dst_it;
-                ++wcIter;
-                ++wnIter;
-            }
-            this->progressForward(w);
-        }
+        estimate(dst, procView, view_wc, view_norm, params);
+        this->progressForward(w * h);
     }
 }
 
 template <class View>
-void NLMDenoiserProcess<View>::computeWeights(const std::vector<View>& srcViews, const OfxRectI& procWindow,
-                                              bgil::rgba32f_view_t& view_wc, bgil::rgba32f_view_t& view_norm,
-                                              const NlmParams& params)
+void NLMDenoiserProcess<View>::computeWeightsSlidingWindow(const std::vector<View>& srcViews,
+                                                           const OfxRectI& procWindow,
+                                                           bgil::rgba32f_view_t& view_wc,
+                                                           bgil::rgba32f_view_t& view_norm, const NlmParams& params)
 {
     typedef typename View::x_iterator sIterator;
     typedef typename bgil::rgba32f_view_t::x_iterator wIterator;
@@ -324,9 +493,7 @@ void NLMDenoiserProcess<View>::computeWeights(const std::vector<View>& srcViews,
     const int wi = srcViews[0].width();
     const int hi = srcViews[0].height();
 
-    // Noise variance estimation
-    const double nv = imageUtils::noise_variance(srcViews[0]);
-    const double sigma = std::sqrt(nv < 0 ? 0 : nv);
+    const double sigma = _sigma;
     Loc loc1, loc2;
     WLoc wcLoc, wnLoc;
 
@@ -379,31 +546,20 @@ void NLMDenoiserProcess<View>::computeWeights(const std::vector<View>& srcViews,
                         // Initialize patch euclidian distance
                         eucl_dist = 0.0f;
                         int j = yj + yi;
-                        // Horizontal & vertical averaging bounds
-                        if(yi >= 0)
-                        {
-                            lbound = -patchRadius + yj < 0 ? std::max(-yj, -patchRadius) : -patchRadius;
-                            hbound = lbound + (patchRadius * 2 + 1);
-                            if(hbound + j > hi)
-                                hbound = std::min(hi - j, patchRadius);
-                        }
-                        else
-                        {
-                            hbound = patchRadius + yj > hi ? std::min(patchRadius, (hi - yj)) : patchRadius;
-                            lbound = hbound - (patchRadius * 2 + 1);
-                            if(lbound + j < 0)
-                                lbound = 0;
-                        }
+                        // Vertical averaging bounds: the rows of the patch where both pixels are in the image,
+                        // like the integral images of the optimized rendering
+                        lbound = std::max(-patchRadius, std::max(-yj, -j));
+                        hbound = std::min(patchRadius + 1, std::min(hi - yj, hi - j));
 
-                        // Warmup: initial average accumulation
+                        // Warmup: initial average accumulation, of the columns before the patch of xl
                         int xl_bound = std::max(xl - patchRadius, 0);
-                        int xr_bound = std::min(wi, xl_bound + patchRadius * 2);
+                        int xr_bound = std::min(wi, xl + patchRadius);
                         loc1 = srcViews[zi].xy_at(xi, j);
                         loc2 = srcViews[0].xy_at(0, yj);
                         for(int xj = xl_bound; xj < xr_bound; ++xj)
                         {
                             // following "if" is bad but simplify the code
-                            if((xj + xi) >= 0)
+                            if((xj + xi) >= 0 && (xj + xi) < wi)
                             {
                                 for(int k = lbound; k < hbound; ++k)
                                 {
@@ -498,6 +654,181 @@ void NLMDenoiserProcess<View>::computeWeights(const std::vector<View>& srcViews,
         }     // End for yi (displacment)
     }         // End for zi (displacment)
 }
+
+template <class View>
+void NLMDenoiserProcess<View>::computeWeights(const std::vector<View>& srcViews, const OfxRectI& procWindow,
+                                              bgil::rgba32f_view_t& view_wc, bgil::rgba32f_view_t& view_norm,
+                                              const NlmParams& params, const int firstDisplacement,
+                                              const int displacementStep)
+{
+    typedef typename View::x_iterator sIterator;
+    typedef typename bgil::gray64f_view_t::x_iterator dIterator;
+    typedef typename View::locator Loc;
+    typedef typename bgil::rgba32f_view_t::locator WLoc;
+
+    const int patchRadius = params.patchRadius;
+    const int depth = srcViews.size();
+
+    const int wi = srcViews[0].width();
+    const int hi = srcViews[0].height();
+
+    const double sigma = _sigma;
+    Loc loc1, loc2;
+    WLoc wcLoc, wnLoc;
+
+    // Size of the neighborhood (see setup)
+    const int min_xpi = _displacementRadius.x;
+    const int min_ypi = _displacementRadius.y;
+
+    static const int nc = boost::mpl::min<boost::mpl::int_<3>, typename bgil::num_channels<Pixel>::type>::type::value;
+    boost::array<float, nc> bws;
+    for(std::size_t i = 0; i < bws.size(); ++i)
+    {
+        bws[i] = params.bws[i];
+    }
+    // [Kervrann] notations
+    std::vector<double> h1(nc);
+    std::vector<double> h2(nc);
+
+    for(int i = 0; i < nc; ++i)
+    {
+        if(bws[i] < 0)
+            bws[i] = (float)computeBandwidth();
+        h1[i] = bws[i] * sigma;
+        h2[i] = 1.0 / (h1[i] * h1[i]);
+    }
+
+    // Squared distances between the pixels and the displaced pixels,
+    // the patch distances are the sums of their integral image (whatever the patch size)
+    bgil::gray64f_image_t distances(wi, hi);
+    bgil::gray64f_view_t view_dist(view(distances));
+    terry::algorithm::integral_image_t<1> patchDistances;
+
+    double abs_e, eucl_dist, weigth, e;
+    int displacement = 0;
+
+    // For zi (displacment)
+    for(int zi = 0; zi < depth; ++zi)
+    {
+        // In the current frame, the displacements d and -d give the same patch distances: only half of them
+        // is computed, the weight of each pair of pixels is accumulated on both pixels (w1Pass and w2Pass)
+        // and counted twice, like the two displacements do.
+        const double pairWeight = zi == 0 ? 2.0 : 1.0;
+
+        // For yi (displacment)
+        for(int yi = -min_ypi; yi <= min_ypi; ++yi)
+        {
+            // For xi (displacment)
+            for(int xi = -min_xpi; xi <= min_xpi; ++xi)
+            {
+                // If not 0 displacment (nor a mirrored displacement in the current frame)
+                if(!(zi == 0 ? (yi > 0 || (yi == 0 && xi > 0)) : (xi != 0 || yi != 0)))
+                    continue;
+                // Displacements of the other threads
+                if(displacement++ % displacementStep != firstDisplacement)
+                    continue;
+
+                const int xl = xi < 0 ? std::abs(xi) : 0;
+                const int xh = wi + xi > wi ? wi - xi : wi;
+                const int yl = yi < 0 ? std::abs(yi) : 0;
+                const int yh = hi + yi > hi ? hi - yi : hi;
+
+                // Squared distances, null where the displaced pixel is outside the image
+                for(int yj = 0; yj < hi; ++yj)
+                {
+                    dIterator dist_it = view_dist.row_begin(yj);
+                    if(yj < yl || yj >= yh)
+                    {
+                        std::fill(dist_it, dist_it + wi, bgil::gray64f_pixel_t(0.0));
+                        continue;
+                    }
+                    sIterator src_it = srcViews[0].row_begin(yj);
+                    sIterator displaced_it = srcViews[zi].row_begin(yj + yi);
+                    for(int xj = 0; xj < wi; ++xj)
+                    {
+                        eucl_dist = 0.0;
+                        if(xj >= xl && xj < xh)
+                        {
+                            for(int v = 0; v < nc; ++v)
+                            {
+                                e = displaced_it[xj + xi][v] - src_it[xj][v];
+                                eucl_dist += e * e;
+                            }
+                        }
+                        dist_it[xj][0] = eucl_dist;
+                    }
+                }
+                patchDistances.compute(view_dist, terry::algorithm::serial_executor());
+
+                // For yj
+                for(int yj = yl; yj < yh; ++yj)
+                {
+                    int j = yj + yi;
+                    // Vertical patch bounds (clipped by the image)
+                    const int py1 = std::max(yj - patchRadius, 0);
+                    const int py2 = std::min(yj + patchRadius + 1, hi);
+
+                    // For xj
+                    for(int xj = xl; xj < xh; ++xj)
+                    {
+                        int i = xj + xi;
+
+                        // Symetric weigthening will be computed
+                        bool w1Pass = (zi == 0 && i >= procWindow.x1 && i < procWindow.x2 && j >= procWindow.y1 &&
+                                       j < procWindow.y2);
+
+                        // Weigthening will be computed
+                        bool w2Pass =
+                            (xj >= procWindow.x1 && xj < procWindow.x2 && yj >= procWindow.y1 && yj < procWindow.y2);
+
+                        // Weight computation (Modified Bisquare weightening function)
+                        if(w1Pass || w2Pass)
+                        {
+                            loc1 = srcViews[zi].xy_at(i, j);
+                            loc2 = srcViews[0].xy_at(xj, yj);
+                            wcLoc = view_wc.xy_at(xj - procWindow.x1, yj - procWindow.y1);
+                            wnLoc = view_norm.xy_at(xj - procWindow.x1, yj - procWindow.y1);
+
+                            // 2D centered patch distance
+                            eucl_dist = patchDistances.sum(std::max(xj - patchRadius, 0), py1,
+                                                           std::min(xj + patchRadius + 1, wi), py2);
+
+                            abs_e = std::abs(eucl_dist);
+                            for(int v = 0; v < nc; ++v)
+                            {
+                                if(abs_e <= h1[v])
+                                {
+                                    weigth = 1.0 - (abs_e * abs_e * h2[v]);
+                                    // Powerize to 8
+                                    weigth *= weigth;
+                                    weigth *= weigth;
+                                    weigth *= weigth;
+                                    weigth *= pairWeight;
+
+                                    // Weight accumulation
+                                    if(w1Pass)
+                                    {
+                                        wcLoc(xi, yi)[v] += weigth * loc2(0, 0)[v];
+                                        wnLoc(xi, yi)[v] += weigth;
+                                    }
+                                    if(w2Pass)
+                                    {
+                                        // Symmetry
+                                        wcLoc(0, 0)[v] += weigth * loc1(0, 0)[v];
+                                        wnLoc(0, 0)[v] += weigth;
+                                    }
+                                }
+                            }
+                        }
+                    } // End for xj
+                }     // End for yj
+
+                if(this->progressForward(1))
+                    return;
+            } // End for xi (displacment)
+        }     // End for yi (displacment)
+    }         // End for zi (displacment)
+}
 }
 }
 }
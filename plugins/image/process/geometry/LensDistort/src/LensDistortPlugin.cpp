@@ -2,6 +2,7 @@
 #include "LensDistortProcess.hpp"
 #include "lensDistortAlgorithm.hpp" // to compute RoI
 
+#include <tuttle/plugin/ReduceExecutor.hpp>
 #include <tuttle/plugin/ofxToGil/point.hpp>
 #include <tuttle/plugin/numeric/coordinateSystem.hpp>
 
@@ -480,6 +481,22 @@ LensDistortParams LensDistortPlugin::getProcessParams() const
 
     return lensDistortParams;
 }
+
+boost::shared_ptr<const LensStMap> LensDistortPlugin::getStMap(const EParamLensType lensType,
+                                                               const LensDistortProcessParams<Scalar>& params,
+                                                               const std::ptrdiff_t width, const std::ptrdiff_t height)
+{
+    // computed under the lock: the renders of the other frames wait for the same map
+    boost::mutex::scoped_lock lock(_stMapMutex);
+    if(!_stMap || !_stMap->isMapOf(lensType, params, width, height))
+    {
+        _stMap.reset(); // the renders still using it keep it
+        boost::shared_ptr<LensStMap> stMap(new LensStMap(lensType, params, width, height));
+        stMap->compute(ReduceExecutor());
+        _stMap = stMap;
+    }
+    return _stMap;
+}
 }
 }
 }
@@ -3,11 +3,14 @@
 
 #include "lensDistortDefinitions.hpp"
 #include "lensDistortProcessParams.hpp"
+#include "lensStMap.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 #include <tuttle/plugin/context/SamplerPlugin.hpp>
 
 #include <boost/gil/utilities.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 #include <string>
 
 namespace tuttle
@@ -106,12 +109,23 @@ public:
 
     LensDistortParams getProcessParams() const;
 
+    /**
+     * @brief ST map of the output, computed by the first render which needs it
+     * and reused by the next ones while the parameters and the size don't change.
+     */
+    boost::shared_ptr<const LensStMap> getStMap(const EParamLensType lensType,
+                                                const LensDistortProcessParams<Scalar>& params,
+                                                const std::ptrdiff_t width, const std::ptrdiff_t height);
+
     const EParamLensType getLensType() const { return static_cast<EParamLensType>(_lensType->getValue()); }
     const EParamCenterType getCenterType() const { return static_cast<EParamCenterType>(_centerType->getValue()); }
     const EParamResizeRod getResizeRod() const { return static_cast<EParamResizeRod>(_resizeRod->getValue()); }
 
 private:
     void initParamsProps();
+
+    boost::mutex _stMapMutex;
+    boost::shared_ptr<const LensStMap> _stMap; ///< protected by _stMapMutex
 };
 }
 }
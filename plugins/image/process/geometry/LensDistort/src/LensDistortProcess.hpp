@@ -2,6 +2,7 @@
 #define LENSDISTORTPROCESS_HPP
 
 #include "lensDistortAlgorithm.hpp"
+#include "lensStMap.hpp"
 #include <terry/sampler/sampler.hpp>
 
 #include <tuttle/plugin/global.hpp>
@@ -13,6 +14,7 @@
 #include <ofxsMultiThread.h>
 #include <boost/gil/gil_all.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace tuttle
 {
@@ -36,6 +38,7 @@ protected:
     LensDistortProcessParams<Scalar> _p;
 
     LensDistortParams _params;
+    boost::shared_ptr<const LensStMap> _stMap; ///< source coordinates of the output pixels
 
 public:
     LensDistortProcess(LensDistortPlugin& instance);
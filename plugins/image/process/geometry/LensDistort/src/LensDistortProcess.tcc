@@ -18,6 +18,8 @@ LensDistortProcess<View>::LensDistortProcess(LensDistortPlugin& instance)
     : ImageGilFilterProcessor<View>(instance, eImageOrientationIndependant)
     , _plugin(instance)
 {
+    // pixels outside of the distorted source are cheap, use tiles to balance the threads
+    this->setTileSize(64, 64);
 }
 
 template <class View>
@@ -38,6 +40,10 @@ void LensDistortProcess<View>::setup(const OFX::RenderArguments& args)
     {
         _p = _plugin.getProcessParams(srcRod, dstRod, this->_clipDst->getPixelAspectRatio());
     }
+
+    // lens parameters rarely change during a shot, the next frames only resample with the map
+    _stMap = _plugin.getStMap(_params._lensType, _p, this->_dstPixelRod.x2 - this->_dstPixelRod.x1,
+                              this->_dstPixelRod.y2 - this->_dstPixelRod.y1);
 }
 
 /**
@@ -149,68 +155,7 @@ void LensDistortProcess<View>::lensDistort(View& srcView, View& dstView, const O
     using namespace terry::sampler;
     EParamFilterOutOfImage outOfImageProcess = _params._samplerProcessParams._outOfImageProcess;
     terry::Rect<std::ssize_t> procWin = ofxToGil(procWindow);
-    switch(_params._lensType)
-    {
-        case eParamLensTypeBrown1:
-        {
-            if(_p.distort)
-            {
-                resample_pixels_progress(srcView, dstView, LensDistortBrown1<double>(_p), procWin, outOfImageProcess,
-                                         this->getOfxProgress(), sampler);
-            }
-            else
-            {
-                resample_pixels_progress(srcView, dstView, LensUndistortBrown1<double>(_p), procWin, outOfImageProcess,
-                                         this->getOfxProgress(), sampler);
-            }
-            return;
-        }
-        case eParamLensTypeBrown3:
-        {
-            if(_p.distort)
-            {
-                resample_pixels_progress(srcView, dstView, LensDistortBrown3<double>(_p), procWin, outOfImageProcess,
-                                         this->getOfxProgress(), sampler);
-            }
-            else
-            {
-                resample_pixels_progress(srcView, dstView, LensUndistortBrown3<double>(_p), procWin, outOfImageProcess,
-                                         this->getOfxProgress(), sampler);
-            }
-            return;
-        }
-        case eParamLensTypePTLens:
-        {
-            if(_p.distort)
-                resample_pixels_progress(srcView, dstView, LensDistortPTLens<double>(_p), procWin, outOfImageProcess,
-                                         this->getOfxProgress(), sampler);
-            else
-                resample_pixels_progress(srcView, dstView, LensUndistortPTLens<double>(_p), procWin, outOfImageProcess,
-                                         this->getOfxProgress(), sampler);
-            return;
-        }
-        case eParamLensTypeFisheye:
-        {
-            if(_p.distort)
-                resample_pixels_progress(srcView, dstView, LensDistortFisheye<double>(_p), procWin, outOfImageProcess,
-                                         this->getOfxProgress(), sampler);
-            else
-                resample_pixels_progress(srcView, dstView, LensUndistortFisheye<double>(_p), procWin, outOfImageProcess,
-                                         this->getOfxProgress(), sampler);
-            return;
-        }
-        case eParamLensTypeFisheye4:
-        {
-            if(_p.distort)
-                resample_pixels_progress(srcView, dstView, LensDistortFisheye4<double>(_p), procWin, outOfImageProcess,
-                                         this->getOfxProgress(), sampler);
-            else
-                resample_pixels_progress(srcView, dstView, LensUndistortFisheye4<double>(_p), procWin, outOfImageProcess,
-                                         this->getOfxProgress(), sampler);
-            return;
-        }
-    }
-    BOOST_THROW_EXCEPTION(exception::Bug() << exception::user("Unrecognized lens type."));
+    resample_pixels_progress(srcView, dstView, *_stMap, procWin, outOfImageProcess, this->getOfxProgress(), sampler);
 }
 }
 }
@@ -103,6 +103,16 @@ struct LensDistortProcessParams
     /// @}
 };
 
+template <typename F>
+bool operator==(const LensDistortProcessParams<F>& a, const LensDistortProcessParams<F>& b)
+{
+    return a.imgSizeSrc == b.imgSizeSrc && a.imgCenterSrc == b.imgCenterSrc && a.imgCenterDst == b.imgCenterDst &&
+           a.normalizeCoef == b.normalizeCoef && a.pixelRatio == b.pixelRatio && a.distort == b.distort &&
+           a.lensCenterDst == b.lensCenterDst && a.lensCenterSrc == b.lensCenterSrc && a.postScale == b.postScale &&
+           a.preScale == b.preScale && a.coef1 == b.coef1 && a.coef2 == b.coef2 && a.coef3 == b.coef3 &&
+           a.coef4 == b.coef4 && a.squeeze == b.squeeze && a.asymmetric == b.asymmetric;
+}
+
 /**
  * @brief Contains functions to map coordinates between :
  *  * canonical coordinates system (ofx)
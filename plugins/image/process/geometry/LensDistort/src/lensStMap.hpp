@@ -0,0 +1,185 @@
+#ifndef _LENSSTMAP_HPP_
+#define _LENSSTMAP_HPP_
+
+#include "lensDistortDefinitions.hpp"
+#include "lensDistortAlgorithm.hpp"
+
+#include <boost/gil/utilities.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace lens
+{
+
+/**
+ * @brief ST map of the lens distortion: the source coordinates of each pixel of the output.
+ *
+ * The lens parameters are usually constant over a whole shot, so the map is computed by the
+ * first render and the next frames only resample the source with it (see LensDistortPlugin::getStMap).
+ * The coordinates are stored in float.
+ */
+class LensStMap
+{
+public:
+    typedef boost::gil::point2<double> Point2;
+
+    /// number of rows computed by each task
+    static const std::ptrdiff_t kBlockRows = 16;
+
+public:
+    /**
+     * @param width, height size of the output (in pixels)
+     */
+    LensStMap(const EParamLensType lensType, const LensDistortProcessParams<double>& params, const std::ptrdiff_t width,
+              const std::ptrdiff_t height)
+        : _lensType(lensType)
+        , _params(params)
+        , _width(width)
+        , _height(height)
+        , _coords(2 * width * height)
+    {
+    }
+
+    /// @brief Computed with the same parameters
+    bool isMapOf(const EParamLensType lensType, const LensDistortProcessParams<double>& params,
+                 const std::ptrdiff_t width, const std::ptrdiff_t height) const
+    {
+        return _lensType == lensType && _width == width && _height == height && _params == params;
+    }
+
+    /**
+     * @brief Compute the map by blocks of rows.
+     * @param executor calls task( i ) for each block i (see terry::algorithm::reduce_pixels)
+     */
+    template <class Executor>
+    void compute(const Executor& executor)
+    {
+        ComputeTask task(*this);
+        executor(task, (_height + kBlockRows - 1) / kBlockRows);
+    }
+
+    template <typename F2>
+    Point2 apply(const boost::gil::point2<F2>& p) const
+    {
+        const std::ptrdiff_t x = static_cast<std::ptrdiff_t>(p.x);
+        const std::ptrdiff_t y = static_cast<std::ptrdiff_t>(p.y);
+        if(x != p.x || y != p.y || x < 0 || y < 0 || x >= _width || y >= _height)
+        {
+            // not a pixel of the map
+            return transformValues(_lensType, _params, Point2(p.x, p.y));
+        }
+        const float* coord = &_coords[2 * (y * _width + x)];
+        return Point2(coord[0], coord[1]);
+    }
+
+private:
+    struct ComputeTask;
+    friend struct ComputeTask;
+
+    struct ComputeTask
+    {
+        LensStMap& _map;
+
+        explicit ComputeTask(LensStMap& map)
+            : _map(map)
+        {
+        }
+
+        void operator()(const std::size_t block)
+        {
+            _map.computeRows(block * kBlockRows, std::min<std::ptrdiff_t>((block + 1) * kBlockRows, _map._height));
+        }
+    };
+
+    template <class DistortFunc>
+    void computeRows(const DistortFunc& func, const std::ptrdiff_t yBegin, const std::ptrdiff_t yEnd)
+    {
+        for(std::ptrdiff_t y = yBegin; y < yEnd; ++y)
+        {
+            float* coord = &_coords[2 * y * _width];
+            for(std::ptrdiff_t x = 0; x < _width; ++x, coord += 2)
+            {
+                const Point2 p = func.apply(Point2(x, y));
+                coord[0] = static_cast<float>(p.x);
+                coord[1] = static_cast<float>(p.y);
+            }
+        }
+    }
+
+    void computeRows(const std::ptrdiff_t yBegin, const std::ptrdiff_t yEnd)
+    {
+        switch(_lensType)
+        {
+            case eParamLensTypeBrown1:
+            {
+                if(_params.distort)
+                    computeRows(LensDistortBrown1<double>(_params), yBegin, yEnd);
+                else
+                    computeRows(LensUndistortBrown1<double>(_params), yBegin, yEnd);
+                return;
+            }
+            case eParamLensTypeBrown3:
+            {
+                if(_params.distort)
+                    computeRows(LensDistortBrown3<double>(_params), yBegin, yEnd);
+                else
+                    computeRows(LensUndistortBrown3<double>(_params), yBegin, yEnd);
+                return;
+            }
+            case eParamLensTypePTLens:
+            {
+                if(_params.distort)
+                    computeRows(LensDistortPTLens<double>(_params), yBegin, yEnd);
+                else
+                    computeRows(LensUndistortPTLens<double>(_params), yBegin, yEnd);
+                return;
+            }
+            case eParamLensTypeFisheye:
+            {
+                if(_params.distort)
+                    computeRows(LensDistortFisheye<double>(_params), yBegin, yEnd);
+                else
+                    computeRows(LensUndistortFisheye<double>(_params), yBegin, yEnd);
+                return;
+            }
+            case eParamLensTypeFisheye4:
+            {
+                if(_params.distort)
+                    computeRows(LensDistortFisheye4<double>(_params), yBegin, yEnd);
+                else
+                    computeRows(LensUndistortFisheye4<double>(_params), yBegin, yEnd);
+                return;
+            }
+        }
+        BOOST_THROW_EXCEPTION(exception::Bug() << exception::user("Unrecognized lens type."));
+    }
+
+private:
+    const EParamLensType _lensType;
+    const LensDistortProcessParams<double> _params;
+    const std::ptrdiff_t _width;
+    const std::ptrdiff_t _height;
+    std::vector<float> _coords; ///< source coordinates (x, y) of each pixel, row by row
+};
+}
+}
+}
+
+namespace terry
+{
+
+template <typename F2>
+inline boost::gil::point2<double> transform(const ::tuttle::plugin::lens::LensStMap& map,
+                                            const boost::gil::point2<F2>& src)
+{
+    return map.apply(src);
+}
+}
+
+#endif
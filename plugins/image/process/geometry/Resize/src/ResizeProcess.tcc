@@ -1,5 +1,5 @@
 #include <tuttle/plugin/ofxToGil/rect.hpp>
-#include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/resample_separable.hpp>
 #include <terry/geometry/affine.hpp>
 
 namespace tuttle
@@ -73,75 +73,75 @@ void ResizeProcess<View>::multiThreadProcessImages(const OfxRectI& procWindow)
                 this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterBilinear:
-            resample_pixels_progress< ::terry::sampler::bilinear_sampler>(this->_srcView, this->_dstView, mat, procWin,
-                                                                          outOfImageProcess, this->getOfxProgress());
+            resample_pixels_separable_progress< ::terry::sampler::bilinear_sampler>(
+                this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterBC:
         {
             bc_sampler BCsampler(_params._samplerProcessParams._paramB, _params._samplerProcessParams._paramC);
-            resample_pixels_progress(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(),
-                                     BCsampler);
+            resample_pixels_separable_progress(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
+                                               this->getOfxProgress(), BCsampler);
             break;
         }
         case eParamFilterBicubic:
-            resample_pixels_progress<bicubic_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                      this->getOfxProgress());
+            resample_pixels_separable_progress<bicubic_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                                outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterCatrom:
-            resample_pixels_progress<catrom_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                     this->getOfxProgress());
+            resample_pixels_separable_progress<catrom_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                               outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterKeys:
-            resample_pixels_progress<keys_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                   this->getOfxProgress());
+            resample_pixels_separable_progress<keys_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                             outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterSimon:
-            resample_pixels_progress<simon_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                    this->getOfxProgress());
+            resample_pixels_separable_progress<simon_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                              outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterRifman:
-            resample_pixels_progress<rifman_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                     this->getOfxProgress());
+            resample_pixels_separable_progress<rifman_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                               outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterMitchell:
-            resample_pixels_progress<mitchell_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                       this->getOfxProgress());
+            resample_pixels_separable_progress<mitchell_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                                 outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterParzen:
-            resample_pixels_progress<parzen_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                     this->getOfxProgress());
+            resample_pixels_separable_progress<parzen_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                               outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterGaussian:
         {
             gaussian_sampler gaussianSampler(_params._samplerProcessParams._filterSize,
                                              _params._samplerProcessParams._filterSigma);
-            resample_pixels_progress(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(),
-                                     gaussianSampler);
+            resample_pixels_separable_progress(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
+                                               this->getOfxProgress(), gaussianSampler);
             break;
         }
         case eParamFilterLanczos:
         {
             lanczos_sampler lanczosSampler(_params._samplerProcessParams._filterSize,
                                            _params._samplerProcessParams._filterSharpen);
-            resample_pixels_progress(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(),
-                                     lanczosSampler);
+            resample_pixels_separable_progress(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
+                                               this->getOfxProgress(), lanczosSampler);
             break;
         }
         case eParamFilterLanczos3:
-            resample_pixels_progress<lanczos3_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                       this->getOfxProgress());
+            resample_pixels_separable_progress<lanczos3_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                                 outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterLanczos4:
-            resample_pixels_progress<lanczos4_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                       this->getOfxProgress());
+            resample_pixels_separable_progress<lanczos4_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                                 outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterLanczos6:
-            resample_pixels_progress<lanczos6_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                       this->getOfxProgress());
+            resample_pixels_separable_progress<lanczos6_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                                 outOfImageProcess, this->getOfxProgress());
             break;
         case eParamFilterLanczos12:
-            resample_pixels_progress<lanczos12_sampler>(this->_srcView, this->_dstView, mat, procWin, outOfImageProcess,
-                                                        this->getOfxProgress());
+            resample_pixels_separable_progress<lanczos12_sampler>(this->_srcView, this->_dstView, mat, procWin,
+                                                                  outOfImageProcess, this->getOfxProgress());
             break;
     }
 }
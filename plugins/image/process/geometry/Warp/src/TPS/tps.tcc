@@ -1,5 +1,3 @@
-#include "../WarpPlugin.hpp"
-#include "../WarpProcess.hpp"
 #include "../WarpDefinitions.hpp"
 #include "tps.hpp"
 
@@ -0,0 +1,113 @@
+#ifndef _TUTTLE_PLUGIN_TPSGRID_HPP_
+#define _TUTTLE_PLUGIN_TPSGRID_HPP_
+
+#include "tps.hpp"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <list>
+#include <vector>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace warp
+{
+
+/**
+ * @brief Thin plate spline evaluated from a grid of displacements.
+ *
+ * The image is cut in blocks of kTpsGridBlockSize pixels. The TPS is sampled in each block
+ * with the largest step whose bilinear interpolation stays under the error bound (in pixels)
+ * at the centers and the middles of the edges of the cells. So the cost per pixel depends on
+ * the smoothness of the warp instead of the number of control points. The blocks which need a step
+ * smaller than kTpsGridMinStep and the points outside of the image use the TPS itself.
+ */
+template <typename SCALAR>
+class TPS_GridMorpher
+{
+public:
+    typedef SCALAR Scalar;
+    typedef TPS_Morpher<Scalar> Morpher;
+    typedef typename Morpher::Point2 Point2;
+
+public:
+    TPS_GridMorpher();
+
+    /**
+     * @param useGrid evaluate the TPS from the grid, otherwise on each point
+     * @param maxError maximal interpolation error of the grid in pixels
+     * see TPS_Morpher::setup for the other parameters
+     */
+    void setup(const std::vector<Point2>& pIn, const std::vector<Point2>& pOut, const double regularization,
+               const bool applyWarp, const std::size_t width, const std::size_t height, const double transition,
+               const bool useGrid, const double maxError);
+
+    /// @brief Same parameters as the last setup
+    bool isSetup(const std::vector<Point2>& pIn, const std::vector<Point2>& pOut, const double regularization,
+                 const bool applyWarp, const std::size_t width, const std::size_t height, const double transition,
+                 const bool useGrid, const double maxError) const;
+
+    template <typename S2>
+    Point2 operator()(const point2<S2>& pt) const;
+
+private:
+    struct Block
+    {
+        std::size_t _step;   ///< distance between the samples, 0 if the TPS is evaluated on each point
+        std::size_t _offset; ///< index of the first sample in _displacements
+    };
+
+    void setupBlock(Block& block, const double x0, const double y0);
+
+private:
+    Morpher _morpher;
+
+    // setup parameters
+    std::vector<Point2> _pIn;
+    std::vector<Point2> _pOut;
+    double _regularization;
+    bool _applyWarp;
+    std::size_t _width;
+    std::size_t _height;
+    double _transition;
+    bool _useGrid;
+    double _maxError;
+
+    std::size_t _nbBlocksX;
+    std::size_t _nbBlocksY;
+    std::vector<Block> _blocks;
+    std::vector<Point2> _displacements; ///< samples of the blocks (TPS(p) - p), row by row
+};
+
+/**
+ * @brief The last TPS used by the renders, reused while their parameters don't change.
+ */
+template <typename SCALAR>
+class TPS_GridCache
+{
+public:
+    typedef SCALAR Scalar;
+    typedef TPS_GridMorpher<Scalar> GridMorpher;
+    typedef typename GridMorpher::Point2 Point2;
+
+public:
+    /// @brief Get the TPS from the cache or set it up, see TPS_GridMorpher::setup
+    boost::shared_ptr<const GridMorpher> get(const std::vector<Point2>& pIn, const std::vector<Point2>& pOut,
+                                             const double regularization, const bool applyWarp, const std::size_t width,
+                                             const std::size_t height, const double transition, const bool useGrid,
+                                             const double maxError);
+
+private:
+    boost::mutex _mutex;
+    std::list<boost::shared_ptr<const GridMorpher> > _morphers; ///< most recently used first
+};
+}
+}
+}
+
+#include "tpsGrid.tcc"
+
+#endif
@@ -0,0 +1,203 @@
+#include "tpsGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tuttle
+{
+namespace plugin
+{
+namespace warp
+{
+
+template <typename SCALAR>
+TPS_GridMorpher<SCALAR>::TPS_GridMorpher()
+    : _regularization(0.0)
+    , _applyWarp(false)
+    , _width(0)
+    , _height(0)
+    , _transition(0.0)
+    , _useGrid(false)
+    , _maxError(0.0)
+    , _nbBlocksX(0)
+    , _nbBlocksY(0)
+{
+}
+
+template <typename SCALAR>
+void TPS_GridMorpher<SCALAR>::setup(const std::vector<Point2>& pIn, const std::vector<Point2>& pOut,
+                                    const double regularization, const bool applyWarp, const std::size_t width,
+                                    const std::size_t height, const double transition, const bool useGrid,
+                                    const double maxError)
+{
+    _pIn = pIn;
+    _pOut = pOut;
+    _regularization = regularization;
+    _applyWarp = applyWarp;
+    _width = width;
+    _height = height;
+    _transition = transition;
+    _useGrid = useGrid;
+    _maxError = maxError;
+
+    _morpher.setup(pIn, pOut, regularization, applyWarp, width, height, transition);
+
+    _blocks.clear();
+    _displacements.clear();
+    // nothing to interpolate without warp
+    if(!_useGrid || !_morpher._activateWarp || _morpher._nbPoints <= 1)
+    {
+        _nbBlocksX = _nbBlocksY = 0;
+        return;
+    }
+    _nbBlocksX = (width + kTpsGridBlockSize - 1) / kTpsGridBlockSize;
+    _nbBlocksY = (height + kTpsGridBlockSize - 1) / kTpsGridBlockSize;
+    _blocks.resize(_nbBlocksX * _nbBlocksY);
+    for(std::size_t by = 0; by < _nbBlocksY; ++by)
+    {
+        for(std::size_t bx = 0; bx < _nbBlocksX; ++bx)
+        {
+            setupBlock(_blocks[by * _nbBlocksX + bx], double(bx * kTpsGridBlockSize),
+                       double(by * kTpsGridBlockSize));
+        }
+    }
+}
+
+/**
+ * @brief Sample the TPS in a block, halving the step until the interpolation error is under _maxError.
+ *
+ * The error is measured on the samples of the half step (centers and middles of the edges of the cells),
+ * which are the samples of the next step if the block is refined.
+ */
+template <typename SCALAR>
+void TPS_GridMorpher<SCALAR>::setupBlock(Block& block, const double x0, const double y0)
+{
+    std::vector<Point2> samples(4);
+    for(std::size_t j = 0; j < 2; ++j)
+    {
+        for(std::size_t i = 0; i < 2; ++i)
+        {
+            const Point2 p(x0 + i * kTpsGridBlockSize, y0 + j * kTpsGridBlockSize);
+            const Point2 m = _morpher(p);
+            samples[j * 2 + i] = Point2(m.x - p.x, m.y - p.y);
+        }
+    }
+
+    std::vector<Point2> halfSamples;
+    for(std::size_t step = kTpsGridBlockSize; step >= kTpsGridMinStep; step /= 2)
+    {
+        const std::size_t n = kTpsGridBlockSize / step + 1;
+        const std::size_t n2 = 2 * n - 1;
+        halfSamples.resize(n2 * n2);
+        double error = 0.0;
+        for(std::size_t j = 0; j < n2; ++j)
+        {
+            for(std::size_t i = 0; i < n2; ++i)
+            {
+                const Point2* s = &samples[(j / 2) * n + (i / 2)];
+                if(i % 2 == 0 && j % 2 == 0)
+                {
+                    halfSamples[j * n2 + i] = *s;
+                    continue;
+                }
+                const Point2 p(x0 + i * 0.5 * step, y0 + j * 0.5 * step);
+                const Point2 m = _morpher(p);
+                const Point2 d(m.x - p.x, m.y - p.y);
+                halfSamples[j * n2 + i] = d;
+
+                // interpolation of the samples of the step
+                const std::size_t di = i % 2;
+                const std::size_t dj = (j % 2) * n;
+                const double ix = 0.25 * (s[0].x + s[di].x + s[dj].x + s[dj + di].x);
+                const double iy = 0.25 * (s[0].y + s[di].y + s[dj].y + s[dj + di].y);
+                error = std::max(error, std::sqrt((ix - d.x) * (ix - d.x) + (iy - d.y) * (iy - d.y)));
+            }
+        }
+        if(error <= _maxError)
+        {
+            block._step = step;
+            block._offset = _displacements.size();
+            _displacements.insert(_displacements.end(), samples.begin(), samples.end());
+            return;
+        }
+        samples.swap(halfSamples);
+    }
+    block._step = 0;
+    block._offset = 0;
+}
+
+template <typename SCALAR>
+bool TPS_GridMorpher<SCALAR>::isSetup(const std::vector<Point2>& pIn, const std::vector<Point2>& pOut,
+                                      const double regularization, const bool applyWarp, const std::size_t width,
+                                      const std::size_t height, const double transition, const bool useGrid,
+                                      const double maxError) const
+{
+    return _regularization == regularization && _applyWarp == applyWarp && _width == width && _height == height &&
+           _transition == transition && _useGrid == useGrid && _maxError == maxError && _pIn == pIn && _pOut == pOut;
+}
+
+template <typename SCALAR>
+template <typename S2>
+typename TPS_GridMorpher<SCALAR>::Point2 TPS_GridMorpher<SCALAR>::operator()(const point2<S2>& pt) const
+{
+    if(_blocks.empty() || pt.x < 0 || pt.y < 0 || pt.x >= double(_nbBlocksX * kTpsGridBlockSize) ||
+       pt.y >= double(_nbBlocksY * kTpsGridBlockSize))
+    {
+        return _morpher(pt);
+    }
+    const std::size_t bx = std::size_t(pt.x) / kTpsGridBlockSize;
+    const std::size_t by = std::size_t(pt.y) / kTpsGridBlockSize;
+    const Block& block = _blocks[by * _nbBlocksX + bx];
+    if(block._step == 0)
+    {
+        return _morpher(pt);
+    }
+
+    // bilinear interpolation of the displacement in the cell
+    const double lx = (pt.x - double(bx * kTpsGridBlockSize)) / block._step;
+    const double ly = (pt.y - double(by * kTpsGridBlockSize)) / block._step;
+    const std::size_t i = std::size_t(lx);
+    const std::size_t j = std::size_t(ly);
+    const double fx = lx - i;
+    const double fy = ly - j;
+    const std::size_t n = kTpsGridBlockSize / block._step + 1;
+    const Point2* s = &_displacements[block._offset + j * n + i];
+    const double dx = (1.0 - fy) * ((1.0 - fx) * s[0].x + fx * s[1].x) + fy * ((1.0 - fx) * s[n].x + fx * s[n + 1].x);
+    const double dy = (1.0 - fy) * ((1.0 - fx) * s[0].y + fx * s[1].y) + fy * ((1.0 - fx) * s[n].y + fx * s[n + 1].y);
+    return Point2(pt.x + dx, pt.y + dy);
+}
+
+template <typename SCALAR>
+boost::shared_ptr<const typename TPS_GridCache<SCALAR>::GridMorpher>
+TPS_GridCache<SCALAR>::get(const std::vector<Point2>& pIn, const std::vector<Point2>& pOut, const double regularization,
+                           const bool applyWarp, const std::size_t width, const std::size_t height,
+                           const double transition, const bool useGrid, const double maxError)
+{
+    typedef typename std::list<boost::shared_ptr<const GridMorpher> >::iterator Iterator;
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        for(Iterator it = _morphers.begin(); it != _morphers.end(); ++it)
+        {
+            if((*it)->isSetup(pIn, pOut, regularization, applyWarp, width, height, transition, useGrid, maxError))
+            {
+                const boost::shared_ptr<const GridMorpher> morpher = *it;
+                _morphers.erase(it);
+                _morphers.push_front(morpher);
+                return morpher;
+            }
+        }
+    }
+
+    // set up outside of the lock, the renders of other frames don't wait
+    boost::shared_ptr<GridMorpher> morpher(new GridMorpher());
+    morpher->setup(pIn, pOut, regularization, applyWarp, width, height, transition, useGrid, maxError);
+
+    boost::mutex::scoped_lock lock(_mutex);
+    _morphers.push_front(morpher);
+    if(_morphers.size() > kTpsGridCacheSize)
+        _morphers.pop_back();
+    return morpher;
+}
+}
+}
+}
@@ -1,7 +1,7 @@
 #ifndef _TUTTLE_PLUGIN_WARP_ALGORITHM_HPP_
 #define _TUTTLE_PLUGIN_WARP_ALGORITHM_HPP_
 
-#include "TPS/tps.hpp"
+#include "TPS/tpsGrid.hpp"
 
 #include <terry/channel.hpp>
 #include <terry/numeric/operations.hpp>
@@ -17,6 +17,13 @@ inline boost::gil::point2<F> transform(const tuttle::plugin::warp::TPS_Morpher<F
 {
     return op(src);
 }
+
+template <typename F, typename F2>
+inline boost::gil::point2<F> transform(const tuttle::plugin::warp::TPS_GridMorpher<F>& op,
+                                       const boost::gil::point2<F2>& src)
+{
+    return op(src);
+}
 }
 }
 
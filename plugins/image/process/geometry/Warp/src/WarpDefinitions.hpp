@@ -16,6 +16,11 @@ static const float lineWidth = 0.5;
 static const float pointWidth = 3.0;
 static const int seuil = 15;
 
+// TPS evaluated from a grid (see TPS_GridMorpher)
+static const std::size_t kTpsGridBlockSize = 64; ///< size of the blocks of the grid in pixels (power of 2)
+static const std::size_t kTpsGridMinStep = 4;    ///< smallest step of the samples, exact TPS below
+static const std::size_t kTpsGridCacheSize = 4;  ///< number of TPS kept between the renders (A and B)
+
 static const float positionOrigine = -200.0;
 
 // static const int nbCoeffBezier = 50;
@@ -46,6 +51,8 @@ static const std::string kParamSetKey = "setKey";
 static const std::string kParamGroupSettings = "settings";
 static const std::string kParamNbPointsBezier = "Points Bezier";
 static const std::string kParamRigiditeTPS = "Rigidite TPS";
+static const std::string kParamGridEvaluation = "gridEvaluation";
+static const std::string kParamGridTolerance = "gridTolerance";
 
 static const std::string kParamGroupIn = "groupIn";
 static const std::string kParamPointIn = "pIn";
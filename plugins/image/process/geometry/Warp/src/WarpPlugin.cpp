@@ -47,6 +47,8 @@ WarpPlugin::WarpPlugin(OfxImageEffectHandle handle)
     _transition = fetchDoubleParam(kParamTransition);
 
     _paramRigiditeTPS = fetchDoubleParam(kParamRigiditeTPS);
+    _paramGridEvaluation = fetchBooleanParam(kParamGridEvaluation);
+    _paramGridTolerance = fetchDoubleParam(kParamGridTolerance);
     _paramNbPointsBezier = fetchIntParam(kParamNbPointsBezier);
 
     // Multi curve
@@ -113,7 +115,10 @@ WarpProcessParams<WarpPlugin::Scalar> WarpPlugin::getProcessParams(const OfxPoin
     const std::size_t nbPoints = _paramNbPoints->getValue();
     params._nbPoints = nbPoints;
 
+    params._activateWarp = true;
     params._rigiditeTPS = _paramRigiditeTPS->getValue();
+    params._gridEvaluation = _paramGridEvaluation->getValue();
+    params._gridTolerance = _paramGridTolerance->getValue();
     params._transition = _transition->getValue();
     params._method = static_cast<EParamMethod>(_paramMethod->getValue());
 
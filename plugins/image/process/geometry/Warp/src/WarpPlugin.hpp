@@ -2,6 +2,7 @@
 #define _TUTTLE_PLUGIN_WARP_PLUGIN_HPP_
 
 #include "WarpDefinitions.hpp"
+#include "TPS/tpsGrid.hpp"
 
 #include <tuttle/plugin/global.hpp>
 
@@ -37,6 +38,8 @@ struct WarpProcessParams
 
     bool _activateWarp;
     double _rigiditeTPS;
+    bool _gridEvaluation;
+    double _gridTolerance;
     std::size_t _nbPoints;
     double _transition;
 
@@ -84,6 +87,8 @@ public:
 
     OFX::GroupParam* _paramGroupSettings;
     OFX::DoubleParam* _paramRigiditeTPS;
+    OFX::BooleanParam* _paramGridEvaluation;
+    OFX::DoubleParam* _paramGridTolerance;
     OFX::IntParam* _paramNbPointsBezier;
 
     // In
@@ -117,6 +122,8 @@ public:
     OFX::GroupParam* _paramGroupCurveBegin;
     boost::array<OFX::BooleanParam*, kMaxNbPoints> _paramCurveBegin;
 
+    TPS_GridCache<Scalar> _tpsCache; ///< TPS of the last renders
+
 private:
     OFX::InstanceChangedArgs _instanceChangedArgs;
 };
@@ -126,6 +126,20 @@ void WarpPluginFactory::describeInContext(OFX::ImageEffectDescriptor& desc, OFX:
         rigidity->setDisplayRange(0.0, 10.0);
         rigidity->setParent(groupSettings);
 
+        OFX::BooleanParamDescriptor* gridEvaluation = desc.defineBooleanParam(kParamGridEvaluation);
+        gridEvaluation->setLabel("Grid evaluation");
+        gridEvaluation->setHint("Interpolate the TPS from a grid of samples instead of computing it on each pixel.");
+        gridEvaluation->setDefault(true);
+        gridEvaluation->setParent(groupSettings);
+
+        OFX::DoubleParamDescriptor* gridTolerance = desc.defineDoubleParam(kParamGridTolerance);
+        gridTolerance->setLabel("Grid tolerance");
+        gridTolerance->setHint("Maximal error of the grid interpolation (in pixels).");
+        gridTolerance->setDefault(0.05);
+        gridTolerance->setRange(0.0, std::numeric_limits<double>::max());
+        gridTolerance->setDisplayRange(0.0, 1.0);
+        gridTolerance->setParent(groupSettings);
+
         OFX::IntParamDescriptor* nbPointsBezier = desc.defineIntParam(kParamNbPointsBezier);
         nbPointsBezier->setLabel("Bezier");
         nbPointsBezier->setHint("Nombre de points dessinant la courbe de bezier");
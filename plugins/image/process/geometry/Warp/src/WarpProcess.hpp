@@ -1,10 +1,12 @@
 #ifndef _TUTTLE_PLUGIN_WARP_PROCESS_HPP_
 #define _TUTTLE_PLUGIN_WARP_PROCESS_HPP_
 
-#include "TPS/tps.hpp"
+#include "WarpPlugin.hpp"
+#include "TPS/tpsGrid.hpp"
 
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace tuttle
 {
@@ -37,8 +39,8 @@ protected:
     View _srcBView;
 
     WarpProcessParams<Scalar> _params; ///< parameters
-    TPS_Morpher<Scalar> _tpsA;
-    TPS_Morpher<Scalar> _tpsB;
+    boost::shared_ptr<const TPS_GridMorpher<Scalar> > _tpsA;
+    boost::shared_ptr<const TPS_GridMorpher<Scalar> > _tpsB;
 
 public:
     WarpProcess(WarpPlugin& effect);
@@ -20,6 +20,9 @@ WarpProcess<View>::WarpProcess(WarpPlugin& effect)
     , _plugin(effect)
 {
     _clipSrcB = effect.fetchClip(kClipSourceB);
+
+    // pixels outside of the warped area are cheap, use small strips to balance the threads
+    this->setTileSize(0, 16);
 }
 
 template <class View>
@@ -48,14 +51,17 @@ void WarpProcess<View>::setup(const OFX::RenderArguments& args)
         // _srcBPixelRod = _srcB->getRegionOfDefinition(); // bug in nuke, returns bounds
         _srcBPixelRod = _clipSrcB->getPixelRod(args.time, args.renderScale);
         this->_srcBView = this->getView(this->_srcB.get(), _srcBPixelRod);
-        _tpsB.setup(_params._bezierOut, _params._bezierIn, _params._rigiditeTPS, _params._activateWarp,
-                    this->_srcBPixelRod.x2 - this->_srcBPixelRod.x1, this->_srcBPixelRod.y2 - this->_srcBPixelRod.y1,
-                    (1.0 - _params._transition));
+        _tpsB = _plugin._tpsCache.get(_params._bezierOut, _params._bezierIn, _params._rigiditeTPS,
+                                      _params._activateWarp, this->_srcBPixelRod.x2 - this->_srcBPixelRod.x1,
+                                      this->_srcBPixelRod.y2 - this->_srcBPixelRod.y1, (1.0 - _params._transition),
+                                      _params._gridEvaluation, _params._gridTolerance);
     }
     // TPS_Morpher<Scalar> tps( _params._inPoints, _params._outPoints , _params._rigiditeTPS);
-    _tpsA.setup(_params._bezierIn, _params._bezierOut, _params._rigiditeTPS, _params._activateWarp,
-                this->_srcPixelRod.x2 - this->_srcPixelRod.x1, this->_srcPixelRod.y2 - this->_srcPixelRod.y1,
-                _params._transition);
+    // the TPS (and its grid) are reused between the frames while the curves don't change
+    _tpsA = _plugin._tpsCache.get(_params._bezierIn, _params._bezierOut, _params._rigiditeTPS, _params._activateWarp,
+                                  this->_srcPixelRod.x2 - this->_srcPixelRod.x1,
+                                  this->_srcPixelRod.y2 - this->_srcPixelRod.y1, _params._transition,
+                                  _params._gridEvaluation, _params._gridTolerance);
     // TUTTLE_TCOUT_VAR( _params._rigiditeTPS );
     // TUTTLE_TCOUT_VAR( _params._activateWarp );
 }
@@ -89,9 +95,9 @@ void WarpProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
             subimage_view(view(imgB), this->_srcBPixelRod.x1 - procWindowRoW.x1, this->_srcBPixelRod.y1 - procWindowRoW.y1,
                           this->_srcBView.width(), this->_srcBView.height());
 
-        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcView, viewA, _tpsA, procWindowSrcA,
+        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcView, viewA, *_tpsA, procWindowSrcA,
                                                                    outOfImageProcess, this->getOfxProgress());
-        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcBView, viewB, _tpsB, procWindowSrcB,
+        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcBView, viewB, *_tpsB, procWindowSrcB,
                                                                    outOfImageProcess, this->getOfxProgress());
 
         // fondu entre imgA et imgB = this->_dstView FAITEALAMAIN
@@ -105,7 +111,7 @@ void WarpProcess<View>::multiThreadProcessImages(const OfxRectI& procWindowRoW)
         View dst =
             subimage_view(this->_dstView, this->_srcPixelRod.x1 - this->_dstPixelRod.x1,
                           this->_srcPixelRod.y1 - this->_dstPixelRod.y1, this->_srcView.width(), this->_srcView.height());
-        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcView, dst, _tpsA, procWindowSrcA,
+        resample_pixels_progress<terry::sampler::bilinear_sampler>(this->_srcView, dst, *_tpsA, procWindowSrcA,
                                                                    outOfImageProcess, this->getOfxProgress());
     }
 }
@@ -14,9 +14,11 @@
 #include <terry/numeric/init.hpp>
 #include <terry/numeric/pow.hpp>
 #include <terry/numeric/sqrt.hpp>
+#include <terry/numeric/moments.hpp>
+#include <terry/algorithm/reduce_pixels.hpp>
+#include <tuttle/plugin/ReduceExecutor.hpp>
 #include <boost/gil/extension/color/hsl.hpp>
 
-#include <boost/units/pow.hpp>
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/erase.hpp>
 #include <boost/mpl/find.hpp>
@@ -99,84 +101,6 @@ namespace plugin
 namespace imageStatistics
 {
 
-template <typename T>
-T standard_deviation(const T v_sum, const T v_sum_p2, const std::size_t nb)
-{
-    using namespace boost::units;
-    return std::sqrt(v_sum_p2 / nb - pow<2>(v_sum / nb));
-}
-
-template <typename Pixel>
-Pixel pixel_standard_deviation(const Pixel& v_sum, const Pixel& v_sum_p2, const std::size_t nb)
-{
-    using namespace boost::gil;
-    Pixel res;
-    for(int i = 0; i < num_channels<Pixel>::type::value; ++i)
-    {
-        res[i] = standard_deviation(v_sum[i], v_sum_p2[i], nb);
-    }
-    return res;
-}
-
-/**
- * @brief In probability theory and statistics, kurtosis is a measure of the
- * "peakedness" of the probability distribution of a real-valued random variable.
- *
- * Higher kurtosis means more of the variance is the result of infrequent extreme deviations,
- * as opposed to frequent modestly sized deviations.
- */
-template <typename T>
-T kurtosis(const T v_mean, const T v_standard_deviation, const T v_sum, const T v_sum_p2, const T v_sum_p3, const T v_sum_p4,
-           const std::size_t nb)
-{
-    using namespace boost::units;
-    return ((v_sum_p4 - 4.0 * v_mean * v_sum_p3 + 6.0 * pow<2>(v_mean) * v_sum_p2) / nb - 3.0 * pow<4>(v_mean)) /
-               (pow<4>(v_standard_deviation)) -
-           3.0;
-}
-
-template <typename Pixel>
-Pixel pixel_kurtosis(const Pixel& v_mean, const Pixel& v_standard_deviation, const Pixel& v_sum, const Pixel& v_sum_p2,
-                     const Pixel& v_sum_p3, const Pixel& v_sum_p4, const std::size_t nb)
-{
-    using namespace boost::gil;
-    Pixel res;
-    for(int i = 0; i < num_channels<Pixel>::type::value; ++i)
-    {
-        res[i] = kurtosis(v_mean[i], v_standard_deviation[i], v_sum[i], v_sum_p2[i], v_sum_p3[i], v_sum_p4[i], nb);
-    }
-    return res;
-}
-
-/**
- * @brief In probability theory and statistics, skewness is a measure of the
- * asymmetry of the probability distribution of a real-valued random variable.
- *
- * A zero value indicates that the values are relatively evenly distributed
- * on both sides of the mean, typically but not necessarily implying
- * a symmetric distribution.
- */
-template <typename T>
-T skewness(const T v_mean, const T v_standard_deviation, const T v_sum, const T v_sum_p2, const T v_sum_p3,
-           const std::size_t nb)
-{
-    using namespace boost::units;
-    return ((v_sum_p3 - 3.0 * v_mean * v_sum_p2) / nb + 2.0 * pow<3>(v_mean)) / pow<3>(v_standard_deviation);
-}
-
-template <typename Pixel>
-Pixel pixel_skewness(const Pixel& v_mean, const Pixel& v_standard_deviation, const Pixel& v_sum, const Pixel& v_sum_p2,
-                     const Pixel& v_sum_p3, const std::size_t nb)
-{
-    using namespace boost::gil;
-    Pixel res;
-    for(int i = 0; i < num_channels<Pixel>::type::value; ++i)
-    {
-        res[i] = skewness(v_mean[i], v_standard_deviation[i], v_sum[i], v_sum_p2[i], v_sum_p3[i], nb);
-    }
-    return res;
-}
-
 template <class Pixel>
 struct OutputParams
 {
@@ -205,142 +129,146 @@ struct OutputParams
     std::size_t _nbPixels;
 };
 
-template <class View, class MaskView, typename CType = boost::gil::bits64f>
-struct ComputeOutputParams
+/**
+ * @brief Statistics of the pixels of an image (or of the pixels of a mask),
+ * reducer of terry::algorithm::reduce_pixels.
+ */
+template <class View>
+struct StatisticsReducer
 {
     typedef typename View::value_type Pixel;
-    typedef typename boost::gil::color_space_type<View>::type Colorspace;
     typedef boost::gil::pixel<typename boost::gil::channel_type<View>::type, boost::gil::layout<boost::gil::gray_t> >
         PixelGray; // grayscale pixel type (using the input channel_type)
-    typedef boost::gil::pixel<CType, boost::gil::layout<Colorspace> >
-        CPixel; // the pixel type use for computation (using input colorspace)
 
-    typedef OutputParams<CPixel> Output;
+    terry::numeric::pixel_moments_t<Pixel> _moments;
+    Pixel _channelMin;
+    Pixel _channelMax;
+    Pixel _luminosityMin;
+    PixelGray _luminosityMinGray;
+    Pixel _luminosityMax;
+    PixelGray _luminosityMaxGray;
 
-    static Output run(const View& image, const MaskView& maskView, const bool useMask, ImageStatisticsPlugin& plugin)
+    StatisticsReducer()
     {
         using namespace terry::numeric;
-        OutputParams<CPixel> output;
-
-        std::size_t nbProcPixels = 0;
-
-        Pixel channelMin;
-        Pixel channelMax;
-        Pixel luminosityMin;
-        PixelGray luminosityMinGray;
-        Pixel luminosityMax;
-        PixelGray luminosityMaxGray;
-
-        CPixel sum;
-        CPixel varianceSum;
-        CPixel sum_p2;
-        CPixel sum_p3;
-        CPixel sum_p4;
-        pixel_zeros_t<CPixel>()(sum);
-        pixel_zeros_t<CPixel>()(varianceSum);
-        pixel_zeros_t<CPixel>()(sum_p2);
-        pixel_zeros_t<CPixel>()(sum_p3);
-        pixel_zeros_t<CPixel>()(sum_p4);
-
-        for(int y = 0; y < image.height(); ++y)
-        {
-            typename View::x_iterator src_it = image.x_at(0, y);
-            typename MaskView::x_iterator mask_it = maskView.x_at(0, y);
+        pixel_zeros_t<Pixel>()(_channelMin);
+        pixel_zeros_t<Pixel>()(_channelMax);
+        pixel_zeros_t<Pixel>()(_luminosityMin);
+        pixel_zeros_t<Pixel>()(_luminosityMax);
+        pixel_zeros_t<PixelGray>()(_luminosityMinGray);
+        pixel_zeros_t<PixelGray>()(_luminosityMaxGray);
+    }
 
-            for(int x = 0; x < image.width(); ++x, ++src_it, ++mask_it)
-            {
-                if(useMask && get_color(*mask_it, gray_color_t()) == 0.0)
-                    continue;
-
-                PixelGray grayCurrentPixel; // current pixel in gray colorspace
-                color_convert(*src_it, grayCurrentPixel);
-
-                if(nbProcPixels == 0)
-                {
-                    // It's the first pixel we visit.
-                    // So initialize statistics!
-                    channelMin = *src_it;
-                    channelMax = *src_it;
-                    luminosityMin = *src_it;
-                    luminosityMinGray = grayCurrentPixel;
-                    luminosityMax = *src_it;
-                    luminosityMaxGray = grayCurrentPixel;
-                }
-                // Count the number of pixels taken into account
-                ++nbProcPixels;
-
-                CPixel pix;
-                pixel_assigns_t<Pixel, CPixel>()(*src_it, pix); // pix = src_it;
-
-                CPixel pix_p2;
-                CPixel pix_p3;
-                CPixel pix_p4;
-
-                pixel_assigns_t<CPixel, CPixel>()(pixel_pow_t<CPixel, 2>()(pix), pix_p2); // pix_p2 = pow<2>( pix );
-                pixel_assigns_t<CPixel, CPixel>()(pixel_multiplies_t<CPixel, CPixel, CPixel>()(pix, pix_p2),
-                                                  pix_p3); // pix_p3 = pix * pix_p2;
-                pixel_assigns_t<CPixel, CPixel>()(pixel_multiplies_t<CPixel, CPixel, CPixel>()(pix_p2, pix_p2),
-                                                  pix_p4); // pix_p4 = pix_p2 * pix_p2;
-
-                pixel_plus_assign_t<CPixel, CPixel>()(pix, sum);       // sum += pix;
-                pixel_plus_assign_t<CPixel, CPixel>()(pix_p2, sum_p2); // sum_p2 += pix_p2;
-                pixel_plus_assign_t<CPixel, CPixel>()(pix_p3, sum_p3); // sum_p3 += pix_p3;
-                pixel_plus_assign_t<CPixel, CPixel>()(pix_p4, sum_p4); // sum_p4 += pix_p4;
-
-                // search min for each channel
-                pixel_assign_min_t<Pixel, Pixel>()(*src_it, channelMin);
-                // search max for each channel
-                pixel_assign_max_t<Pixel, Pixel>()(*src_it, channelMax);
-
-                // search min luminosity
-                if(get_color(grayCurrentPixel, gray_color_t()) < get_color(luminosityMinGray, gray_color_t()))
-                {
-                    luminosityMin = *src_it;
-                    luminosityMinGray = grayCurrentPixel;
-                }
-                // search max luminosity
-                if(get_color(grayCurrentPixel, gray_color_t()) > get_color(luminosityMaxGray, gray_color_t()))
-                {
-                    luminosityMax = *src_it;
-                    luminosityMaxGray = grayCurrentPixel;
-                }
-            }
+    void operator()(const Pixel& src)
+    {
+        using namespace boost::gil;
+        using namespace terry::numeric;
+
+        PixelGray grayCurrentPixel; // current pixel in gray colorspace
+        color_convert(src, grayCurrentPixel);
+
+        if(_moments.count == 0)
+        {
+            // It's the first pixel we visit.
+            // So initialize statistics!
+            _channelMin = src;
+            _channelMax = src;
+            _luminosityMin = src;
+            _luminosityMinGray = grayCurrentPixel;
+            _luminosityMax = src;
+            _luminosityMaxGray = grayCurrentPixel;
         }
+        _moments(src);
 
-        output._nbPixels = nbProcPixels;
+        // search min and max for each channel
+        pixel_assign_min_t<Pixel, Pixel>()(src, _channelMin);
+        pixel_assign_max_t<Pixel, Pixel>()(src, _channelMax);
+
+        // search min and max luminosity
+        if(get_color(grayCurrentPixel, gray_color_t()) < get_color(_luminosityMinGray, gray_color_t()))
+        {
+            _luminosityMin = src;
+            _luminosityMinGray = grayCurrentPixel;
+        }
+        if(get_color(grayCurrentPixel, gray_color_t()) > get_color(_luminosityMaxGray, gray_color_t()))
+        {
+            _luminosityMax = src;
+            _luminosityMaxGray = grayCurrentPixel;
+        }
+    }
 
-        output._channelMin = channelMin;
-        output._channelMax = channelMax;
-        output._luminosityMin = luminosityMin;
-        output._luminosityMax = luminosityMax;
+    template <class MaskPixel>
+    void operator()(const Pixel& src, const MaskPixel& mask)
+    {
+        using namespace boost::gil;
+        if(get_color(mask, gray_color_t()) != 0.0)
+            (*this)(src);
+    }
 
-        CPixel stdDeriv = pixel_standard_deviation(sum, sum_p2, nbProcPixels);
-        output._average = pixel_divides_scalar_t<CPixel, double>()(sum, nbProcPixels);
+    /// @brief merge the statistics of the next pixels, the first pixel wins on equal luminosities
+    void merge(const StatisticsReducer& other)
+    {
+        using namespace boost::gil;
+        using namespace terry::numeric;
 
-        for(int y = 0; y < image.height(); ++y)
+        if(other._moments.count == 0)
+            return;
+        if(_moments.count == 0)
+        {
+            *this = other;
+            return;
+        }
+        _moments.merge(other._moments);
+        pixel_assign_min_t<Pixel, Pixel>()(other._channelMin, _channelMin);
+        pixel_assign_max_t<Pixel, Pixel>()(other._channelMax, _channelMax);
+        if(get_color(other._luminosityMinGray, gray_color_t()) < get_color(_luminosityMinGray, gray_color_t()))
+        {
+            _luminosityMin = other._luminosityMin;
+            _luminosityMinGray = other._luminosityMinGray;
+        }
+        if(get_color(other._luminosityMaxGray, gray_color_t()) > get_color(_luminosityMaxGray, gray_color_t()))
         {
-            typename View::x_iterator src_it = image.x_at(0, y);
+            _luminosityMax = other._luminosityMax;
+            _luminosityMaxGray = other._luminosityMaxGray;
+        }
+    }
+};
 
-            for(int x = 0; x < image.width(); ++x, ++src_it)
-            {
-                CPixel pix;
-                pixel_assigns_t<Pixel, CPixel>()(*src_it, pix); // pix = src_it;
+template <class View, class MaskView, typename CType = boost::gil::bits64f>
+struct ComputeOutputParams
+{
+    typedef typename View::value_type Pixel;
+    typedef typename boost::gil::color_space_type<View>::type Colorspace;
+    typedef boost::gil::pixel<CType, boost::gil::layout<Colorspace> >
+        CPixel; // the pixel type use for computation (using input colorspace)
 
-                CPixel pix_diff = pix;
-                CPixel pix_diff2;
+    typedef OutputParams<CPixel> Output;
 
-                pix_diff = pixel_minus_t<CPixel, CPixel, CPixel>()(pix, output._average); // pix_diff = (pix - mean)
-                pix_diff2 =
-                    pixel_multiplies_t<CPixel, CPixel, CPixel>()(pix_diff, pix_diff); // pix_diff2 = (x - mean)*(x - mean)
+    static Output run(const View& image, const MaskView& maskView, const bool useMask, ImageStatisticsPlugin& plugin)
+    {
+        using namespace terry::algorithm;
+        typedef StatisticsReducer<View> Reducer;
+        Output output;
 
-                pixel_plus_assign_t<CPixel, CPixel>()(pix_diff2, varianceSum); // varianceSum += pix_diff2;
-            }
-        }
+        // single pass on the threads of the host
+        const Reducer stats = useMask ? reduce_pixels(image, maskView, Reducer(), ReduceExecutor())
+                                      : reduce_pixels(image, Reducer(), ReduceExecutor());
+        const std::size_t nbProcPixels = stats._moments.count;
+
+        output._nbPixels = nbProcPixels;
 
-        CPixel varianceSquare = pixel_divides_scalar_t<CPixel, double>()(varianceSum, nbProcPixels);
-        output._variance = pixel_sqrt_t<CPixel, Pixel>()(varianceSquare);
-        output._kurtosis = pixel_kurtosis(output._average, stdDeriv, sum, sum_p2, sum_p3, sum_p4, nbProcPixels);
-        output._skewness = pixel_skewness(output._average, stdDeriv, sum, sum_p2, sum_p3, nbProcPixels);
+        output._channelMin = stats._channelMin;
+        output._channelMax = stats._channelMax;
+        output._luminosityMin = stats._luminosityMin;
+        output._luminosityMax = stats._luminosityMax;
+
+        for(int c = 0; c < boost::gil::num_channels<CPixel>::type::value; ++c)
+        {
+            output._average[c] = stats._moments.mean[c];
+            output._variance[c] = stats._moments.standard_deviation(c);
+            output._kurtosis[c] = stats._moments.kurtosis(c);
+            output._skewness[c] = stats._moments.skewness(c);
+        }
 
         return output;
     }